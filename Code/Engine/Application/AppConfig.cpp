@@ -19,6 +19,10 @@ LcAppConfig::LcAppConfig()
 	bVSync = true;
 	bAllowFullscreen = false;
 	bNoDelay = false;
+	FixedTickRate = LcDefaultTickRate;
+	MaxFrameTime = LcDefaultMaxFrameTime;
+	MaxTicksPerFrame = LcDefaultMaxTicksPerFrame;
+	TargetFPS = 0;
 }
 
 bool LoadConfig(LcAppConfig& outConfig, const char* fileName, char delim)
@@ -33,6 +37,10 @@ bool LoadConfig(LcAppConfig& outConfig, const char* fileName, char delim)
 	outConfig.bVSync			= cfg["Engine"]["bVSync"].get<bool>();
 	outConfig.bAllowFullscreen	= cfg["Engine"]["bAllowFullscreen"].get<bool>();
 	outConfig.bNoDelay			= cfg["Engine"]["bNoDelay"].get<bool>();
+	outConfig.FixedTickRate		= cfg["Engine"].value("FixedTickRate", LcDefaultTickRate);
+	outConfig.MaxFrameTime		= cfg["Engine"].value("MaxFrameTime", LcDefaultMaxFrameTime);
+	outConfig.MaxTicksPerFrame	= cfg["Engine"].value("MaxTicksPerFrame", LcDefaultMaxTicksPerFrame);
+	outConfig.TargetFPS			= cfg["Engine"].value("TargetFPS", 0u);
 
 	for (auto action : cfg["Input"])
 	{
@@ -58,7 +66,11 @@ void SaveConfig(const LcAppConfig& config, const char* fileName)
 		{"Engine", {
 			{"bVSync",				config.bVSync},
 			{"bAllowFullscreen",	config.bAllowFullscreen},
-			{"bNoDelay",			config.bNoDelay}
+			{"bNoDelay",			config.bNoDelay},
+			{"FixedTickRate",		config.FixedTickRate},
+			{"MaxFrameTime",		config.MaxFrameTime},
+			{"MaxTicksPerFrame",	config.MaxTicksPerFrame},
+			{"TargetFPS",			config.TargetFPS}
 		}},
 		{"Input", {}}
 	};
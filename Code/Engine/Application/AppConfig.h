@@ -10,6 +10,8 @@
 
 #include "Module.h"
 #include "Core/LCTypes.h"
+#include "Core/LCTime.h"
+#include "Core/LCFramePacer.h"
 
 #pragma warning(disable : 4251)
 
@@ -38,6 +40,10 @@ struct APPLICATION_API LcAppConfig
     bool bVSync;
     bool bAllowFullscreen;
     bool bNoDelay;
+    unsigned int FixedTickRate;
+    float MaxFrameTime;
+    unsigned int MaxTicksPerFrame;
+    unsigned int TargetFPS;
     // [Input]
     std::deque<LcActionBinding> Actions;
 };
@@ -27,6 +27,9 @@ typedef std::function<void(struct LcAppContext&)> LcInitHandler;
 /** Update handler */
 typedef std::function<void(float, struct LcAppContext&)> LcUpdateHandler;
 
+/** Fixed update handler, called for every simulation tick with fixed delta */
+typedef std::function<void(float, struct LcAppContext&)> LcFixedUpdateHandler;
+
 
 /** Application stats */
 struct LcAppStats
@@ -38,6 +41,7 @@ struct LcAppStats
 	int numFonts;
 	int numSounds;
 	int numBodies;
+	LcFrameStats frameStats;
 };
 
 
@@ -101,22 +105,38 @@ public:
 	virtual void SetAllowFullscreen(bool inAllowFullscreen) noexcept = 0;
 	/**
 	* @brief Set No Delay mode.
-	* If true: high FPS and update rate.
-	* If true and VSync false: processor core utilization 100%, highest FPS and update rate.  */
+	* If true: frame limit is disabled, high FPS and update rate.
+	* If true and VSync false: processor core utilization 100%, highest FPS and update rate.
+	* If false and there is no frame limit: loop sleeps for 1 ms per frame. Could be changed at runtime */
 	virtual void SetNoDelay(bool inNoDelay) noexcept = 0;
 	/**
+	* Set frame limit, 0 - no limit. Overrides LcAppConfig::TargetFPS.
+	* Ignored in No Delay mode */
+	virtual void SetTargetFPS(unsigned int targetFPS) noexcept = 0;
+	/**
 	* Set init handler */
 	virtual void SetInitHandler(LcInitHandler handler) noexcept = 0;
 	/**
 	* Set update handler */
 	virtual void SetUpdateHandler(LcUpdateHandler handler) noexcept = 0;
 	/**
+	* Set fixed update handler. Called before physics step with fixed tick delta,
+	* tick rate is set by LcAppConfig::FixedTickRate */
+	virtual void SetFixedUpdateHandler(LcFixedUpdateHandler handler) noexcept = 0;
+	/**
 	* Run application main loop */
 	virtual void Run() = 0;
 	/**
 	* Remove all sprites, widgets, textures etc. */
 	virtual void ClearWorld(bool removeRooted = false) = 0;
 	/**
+	* Save world and physics snapshot to binary file. Rooted objects are saved if saveRooted is set */
+	virtual void SaveWorld(const char* filePath, bool saveRooted = false) = 0;
+	/**
+	* Clear world with ClearWorld(removeRooted) and restore snapshot saved by SaveWorld().
+	* File is loaded with one read and used in place */
+	virtual void LoadWorld(const char* filePath, bool removeRooted = false) = 0;
+	/**
 	* Request application quit */
 	virtual void RequestQuit() noexcept = 0;
 	/**
@@ -7,7 +7,9 @@
 #pragma once
 
 
-#ifndef APPLICATION_EXPORTS
+#if !defined(_WIN32)
+#define APPLICATION_API
+#elif !defined(APPLICATION_EXPORTS)
 #define APPLICATION_API __declspec (dllimport)
 #else
 #define APPLICATION_API __declspec (dllexport)
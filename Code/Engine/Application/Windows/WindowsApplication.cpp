@@ -9,10 +9,12 @@
 #include "RenderSystem/RenderSystem.h"
 #include "World/WorldInterface.h"
 #include "Core/LCException.h"
+#include "Core/LCSerializer.h"
+#include "Core/LCUtils.h"
 #include "Core/ScriptSystem.h"
 #include "Core/Physics.h"
 #include "Core/Audio.h"
-#include "GUI/GuiManager.h"
+#include "GUI/GUIManager.h"
 
 #include <timeapi.h>
 
@@ -50,12 +52,16 @@ LcWindowsApplication::LcWindowsApplication()
     vSync = true;
     allowFullscreen = false;
     noDelay = false;
-    prevTime.QuadPart = 0;
-    frequency.QuadPart = 0;
+    targetFPS = -1;
+    timerPeriodSet = false;
 }
 
 LcWindowsApplication::~LcWindowsApplication()
 {
+    if (jobSystem) jobSystem.reset();
+
+    if (renderSystem) renderSystem->Unsubscribe(context);
+
     if (world) world.reset();
 
     if (inputSystem)
@@ -115,6 +121,9 @@ void LcWindowsApplication::Run()
 	if (!hInstance) throw std::exception("LcWindowsApplication::Run(): Invalid platform handle");
     if (!world) throw std::exception("LcWindowsApplication::Run(): Invalid world");
 
+    // start workers
+    if (!jobSystem) jobSystem = std::make_unique<LcJobSystem>();
+
     // set context
     context.app = this;
     context.world = world.get();
@@ -125,6 +134,8 @@ void LcWindowsApplication::Run()
     context.gui = guiManager.get();
     context.physics = physWorld.get();
     context.text = localization.get();
+    context.jobs = jobSystem.get();
+    context.time = &time;
 
     // get window size
     int screenHeight = GetSystemMetrics(SM_CYSCREEN);
@@ -206,41 +217,64 @@ void LcWindowsApplication::Run()
     }
 
     // run game loop
-    QueryPerformanceFrequency(&frequency);
-    QueryPerformanceCounter(&prevTime);
+    time.SetTickRate(cfg.FixedTickRate);
+    time.SetMaxFrameTime(cfg.MaxFrameTime);
+    time.SetMaxTicksPerFrame(cfg.MaxTicksPerFrame);
+    time.Reset();
+
+    if (targetFPS < 0) targetFPS = (int)cfg.TargetFPS;
+    if (cfg.bNoDelay) noDelay = true;
+    UpdateFramePacer();
+    framePacer.Reset();
+
+    // precise sleep for frame pacer
+    timerPeriodSet = (timeBeginPeriod(1) == TIMERR_NOERROR);
 
     MSG msg;
 	while (!quit)
 	{
-        if (PeekMessage(&msg, 0, 0, 0, PM_REMOVE))
-        {
-            if (msg.message == WM_QUIT) break;
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
-        }
-        else
+        while (PeekMessage(&msg, 0, 0, 0, PM_REMOVE))
         {
-            if (!noDelay)
+            if (msg.message == WM_QUIT)
             {
-                timeBeginPeriod(1);
-                Sleep(1);
-                timeEndPeriod(1);
+                quit = true;
+                break;
             }
 
-            // update and render
-            OnUpdate();
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
         }
+
+        if (quit) break;
+
+        framePacer.Wait();
+
+        // update and render
+        OnUpdate();
 	}
 
+    if (timerPeriodSet) timeEndPeriod(1);
+    timerPeriodSet = false;
+
     // set NULL to skip crash in WndProc
     SetWindowLongPtr(hWnd, GWLP_USERDATA, NULL);
 
     LC_CATCH {
+        if (timerPeriodSet) timeEndPeriod(1);
+        timerPeriodSet = false;
         SetWindowLongPtr(hWnd, GWLP_USERDATA, NULL);
         LC_THROW("LcWindowsApplication::Run()")
     }
 }
 
+void LcWindowsApplication::UpdateFramePacer() noexcept
+{
+    // no limit yields 1 ms per frame unless No Delay mode is set
+    unsigned int frameLimit = (targetFPS > 0) ? (unsigned int)targetFPS : 0;
+    framePacer.SetTargetFPS(noDelay ? 0 : frameLimit);
+    framePacer.SetIdleSleep(!noDelay);
+}
+
 void LcWindowsApplication::ClearWorld(bool removeRooted)
 {
     world->Clear(removeRooted);
@@ -249,51 +283,84 @@ void LcWindowsApplication::ClearWorld(bool removeRooted)
     if (physWorld) physWorld->Clear(removeRooted);
 }
 
+void LcWindowsApplication::SaveWorld(const char* filePath, bool saveRooted)
+{
+    if (!world) throw std::exception("LcWindowsApplication::SaveWorld(): Invalid world");
+    if (!filePath) throw std::exception("LcWindowsApplication::SaveWorld(): Invalid file path");
+
+    LcArchiveWriter writer;
+    world->Save(writer, saveRooted);
+    if (physWorld) physWorld->Save(writer, saveRooted);
+
+    LcBytes data;
+    writer.Finish(data);
+    WriteBinaryFile(filePath, data);
+}
+
+void LcWindowsApplication::LoadWorld(const char* filePath, bool removeRooted)
+{
+    if (!world) throw std::exception("LcWindowsApplication::LoadWorld(): Invalid world");
+    if (!filePath) throw std::exception("LcWindowsApplication::LoadWorld(): Invalid file path");
+
+    auto data = ReadBinaryFile(filePath);
+    LcArchiveReader reader(data.data(), data.size());
+
+    ClearWorld(removeRooted);
+
+    world->Load(reader);
+    if (physWorld) physWorld->Load(reader);
+}
+
 void LcWindowsApplication::OnUpdate()
 {
     LC_TRY
 
     if (!world) throw std::exception("LcWindowsApplication::Run(): Invalid world");
 
-    LARGE_INTEGER curTime, deltaTime;
-    QueryPerformanceCounter(&curTime);
-    deltaTime.QuadPart = (curTime.QuadPart - prevTime.QuadPart);
-
-    if (curTime.QuadPart != prevTime.QuadPart)
-    {
-        prevTime.QuadPart = curTime.QuadPart;
+    float deltaFloat = time.BeginFrame();
+    if (deltaFloat <= 0.0f) return;
 
-        double deltaSeconds = static_cast<double>(deltaTime.QuadPart) / 10000000.0;
-        float deltaFloat = static_cast<float>(deltaSeconds);
+    context.gameTime = static_cast<float>(time.GetTotalTime());
 
-        double timeSeconds = static_cast<double>(curTime.QuadPart) / 10000000.0;
-        context.gameTime = static_cast<float>(timeSeconds);
-
-        if (inputSystem)
-        {
-            inputSystem->Update(deltaFloat, context);
-        }
+    if (inputSystem)
+    {
+        inputSystem->Update(deltaFloat, context);
+    }
 
-        if (renderSystem && world)
+    // simulation with fixed time step
+    float fixedDelta = time.GetFixedDelta();
+    while (time.StepFixed())
+    {
+        if (fixedUpdateHandler)
         {
-            renderSystem->Update(deltaFloat, context);
-            renderSystem->Render(context);
+            fixedUpdateHandler(fixedDelta, context);
         }
 
         if (physWorld)
         {
-            physWorld->Update(deltaFloat, context);
+            physWorld->Update(fixedDelta, context);
         }
+    }
 
-        if (audioSystem)
-        {
-            audioSystem->Update(deltaFloat, context);
-        }
+    if (physWorld)
+    {
+        physWorld->Interpolate(time.GetAlpha());
+    }
 
-        if (updateHandler)
-        {
-            updateHandler(deltaFloat, context);
-        }
+    if (renderSystem && world)
+    {
+        renderSystem->Update(deltaFloat, context);
+        renderSystem->Render(context);
+    }
+
+    if (audioSystem)
+    {
+        audioSystem->Update(deltaFloat, context);
+    }
+
+    if (updateHandler)
+    {
+        updateHandler(deltaFloat, context);
     }
 
     LC_CATCH{ LC_THROW("LcWindowsApplication::OnUpdate()") }
@@ -313,7 +380,8 @@ LcAppStats LcWindowsApplication::GetAppStats() const noexcept
         renderStats.numTilemaps,
         renderStats.numFonts,
         audioSystem ? (int)audioSystem->GetSounds().size() : 0,
-        physWorld ? (int)physWorld->GetDynamicBodies().size() : 0
+        physWorld ? (int)physWorld->GetDynamicBodies().size() : 0,
+        framePacer.GetStats()
     };
 }
 
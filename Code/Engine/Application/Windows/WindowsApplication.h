@@ -12,6 +12,8 @@
 #include "Application/ApplicationInterface.h"
 #include "Application/AppConfig.h"
 #include "Core/LCLocalization.h"
+#include "Core/LCJobSystem.h"
+#include "Core/LCTime.h"
 #include "Core/LCTypesEx.h"
 
 #pragma warning(disable : 4275)
@@ -57,16 +59,24 @@ public: // IApplication interface implementation
 	//
 	virtual void SetAllowFullscreen(bool inAllowFullscreen) noexcept override { allowFullscreen = inAllowFullscreen; }
 	//
-	virtual void SetNoDelay(bool inNoDelay) noexcept override { noDelay = inNoDelay; }
+	virtual void SetNoDelay(bool inNoDelay) noexcept override { noDelay = inNoDelay; UpdateFramePacer(); }
+	//
+	virtual void SetTargetFPS(unsigned int inTargetFPS) noexcept override { targetFPS = inTargetFPS; UpdateFramePacer(); }
 	//
 	virtual void SetInitHandler(LcInitHandler handler) noexcept override { initHandler = handler; }
 	//
 	virtual void SetUpdateHandler(LcUpdateHandler handler) noexcept override { updateHandler = handler; }
 	//
+	virtual void SetFixedUpdateHandler(LcFixedUpdateHandler handler) noexcept override { fixedUpdateHandler = handler; }
+	//
 	virtual void Run() override;
 	//
 	virtual void ClearWorld(bool removeRooted = false) override;
 	//
+	virtual void SaveWorld(const char* filePath, bool saveRooted = false) override;
+	//
+	virtual void LoadWorld(const char* filePath, bool removeRooted = false) override;
+	//
 	virtual void RequestQuit() noexcept override { quit = true; }
 	//
 	virtual int GetWindowWidth() const override { return windowSize.x; }
@@ -90,6 +100,8 @@ public: // IApplication interface implementation
 
 protected:
 	void OnUpdate();
+	// apply No Delay mode and frame limit to frame pacer
+	void UpdateFramePacer() noexcept;
 
 
 protected:
@@ -108,14 +120,18 @@ protected:
 	bool allowFullscreen;
 	//
 	bool noDelay;
+	// frame limit, -1 - use config value
+	int targetFPS;
+	// timeBeginPeriod() is called, so timeEndPeriod() is needed
+	bool timerPeriodSet;
 	//
 	LcSize windowSize;
 	//
 	LcWinMode winMode;
 	//
-	LARGE_INTEGER prevTime;
+	LcTimeSystem time;
 	//
-	LARGE_INTEGER frequency;
+	LcFramePacer framePacer;
 	//
 	std::string shadersPath;
 	//
@@ -139,6 +155,8 @@ protected:
 	//
 	TLocalizationPtr localization;
 	//
+	std::unique_ptr<LcJobSystem> jobSystem;
+	//
 	LcAppContext context;
 
 
@@ -146,5 +164,7 @@ protected:
 	LcInitHandler initHandler;
 	//
 	LcUpdateHandler updateHandler;
+	//
+	LcFixedUpdateHandler fixedUpdateHandler;
 
 };
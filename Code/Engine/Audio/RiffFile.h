@@ -7,7 +7,7 @@
 #pragma once
 
 #include "Module.h"
-#include "Core/LcTypes.h"
+#include "Core/LCTypes.h"
 
 #include <mmreg.h>
 
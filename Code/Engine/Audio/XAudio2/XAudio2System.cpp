@@ -78,14 +78,16 @@ void LcXAudio2System::Clear(bool removeRooted)
 	}
 	else
 	{
-		IAudioSystem::TSoundsList removedSounds;
-		auto& soundsList = sounds.GetItems();
-
-		std::copy_if(soundsList.begin(), soundsList.end(), std::inserter(removedSounds, removedSounds.begin()), [](auto& sound) {
-			return !sound->IsRooted();
-		});
-
-		sounds.Clear(removedSounds.begin(), removedSounds.end());
+		std::vector<ISound*> removedSounds;
+		for (auto& sound : sounds.GetItems())
+		{
+			if (!sound->IsRooted()) removedSounds.push_back(sound.get());
+		}
+
+		for (auto sound : removedSounds)
+		{
+			sounds.Remove(sound);
+		}
 	}
 }
 
@@ -118,14 +120,6 @@ ISound* LcXAudio2System::AddSound(const char* filePath)
 	return newSound;
 }
 
-ISound* LcXAudio2System::GetSoundByTag(ObjectTag tag) const
-{
-	auto it = std::find_if(sounds.GetItems().begin(), sounds.GetItems().end(), [tag](auto& sound) {
-		return sound->GetTag() == tag;
-	});
-	return (it != sounds.GetItems().end()) ? it->get() : nullptr;
-}
-
 
 TAudioSystemPtr GetAudioSystem()
 {
@@ -44,8 +44,6 @@ public: // IAudioSystem interface implementation
 	virtual void Update(float deltaSeconds, const LcAppContext& context) override;
 	//
 	virtual ISound* AddSound(const char* filePath) override;
-	//
-	virtual ISound* GetSoundByTag(ObjectTag tag) const override;
 
 
 protected:
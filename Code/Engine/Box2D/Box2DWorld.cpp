@@ -9,6 +9,7 @@
 #include "World/WorldInterface.h"
 #include "Core/LCException.h"
 #include "Core/LCUtils.h"
+#include "Core/LCSerializer.h"
 
 // put Box2D library into Code/Engine/Box2D folder
 #include "box2d/box2d.h"
@@ -17,6 +18,41 @@
 
 static const float BOX2D_SCALE = 100.0f;
 
+/** Snapshot section versions */
+static const unsigned int LcStaticBoxesVersion = 1;
+static const unsigned int LcBodiesVersion = 1;
+
+/** Body record flags */
+static const uint32_t LcBodyRooted = 1;
+static const uint32_t LcBodyFixedRotation = 2;
+static const uint32_t LcBodyCircle = 4;
+
+struct LcStaticBoxRecord
+{
+    LcVector2 pos;
+    //
+    LcSizef size;
+};
+
+struct LcBodyRecord
+{
+    int32_t tag;
+    //
+    uint32_t flags;
+    // pixels
+    LcVector2 pos;
+    //
+    LcSizef size;
+    //
+    float density;
+    //
+    float angle;
+    //
+    LcVector2 velocity;
+    //
+    float angularVelocity;
+};
+
 
 inline LcVector2 ToLC(const b2Vec2& v, bool scale = true)
 {
@@ -55,7 +91,8 @@ struct LcBodyQueryHandler : public b2QueryCallback
 class LcBox2DBody : public IPhysicsBody
 {
 public:
-    LcBox2DBody() : world(nullptr), body(nullptr), size(LcDefaults::ZeroSize) {}
+    LcBox2DBody() : world(nullptr), body(nullptr), size(LcDefaults::ZeroSize),
+        prevPos(0.0f, 0.0f), prevAngle(0.0f), renderPos(LcDefaults::ZeroVec2), renderAngle(0.0f) {}
 	//
     ~LcBox2DBody() {}
     //
@@ -66,6 +103,30 @@ public:
         fixture = inFixture;
         size.x = inSize.x / BOX2D_SCALE;
         size.y = inSize.y / BOX2D_SCALE;
+        SnapTransform();
+    }
+    /**
+    * Save transform before simulation step */
+    void SavePrevTransform()
+    {
+        prevPos = body->GetPosition();
+        prevAngle = body->GetAngle();
+    }
+    /**
+    * Set previous and render transform to current, so body is not interpolated */
+    void SnapTransform()
+    {
+        SavePrevTransform();
+        renderPos = ToLC(prevPos);
+        renderAngle = prevAngle;
+    }
+    //
+    void Interpolate(float alpha)
+    {
+        auto pos = body->GetPosition();
+        float angle = body->GetAngle();
+        renderPos = ToLC(b2Vec2(prevPos.x + (pos.x - prevPos.x) * alpha, prevPos.y + (pos.y - prevPos.y) * alpha));
+        renderAngle = prevAngle + (angle - prevAngle) * alpha;
     }
     //
     static int GetStaticId() { return LcCreatables::PhysicsBody; }
@@ -77,6 +138,14 @@ public:
     b2Body* body;
     //
     LcSizef size;
+    // transform before last simulation step
+    b2Vec2 prevPos;
+    //
+    float prevAngle;
+    // interpolated transform
+    LcVector2 renderPos;
+    //
+    float renderAngle;
 
 
 public: // IPhysicsBody interface implementation
@@ -89,12 +158,18 @@ public: // IPhysicsBody interface implementation
     //
     virtual LcVector2 GetVelocity() const override { return ToLC(body->GetLinearVelocity(), false); }
     //
-    virtual void SetPos(LcVector2 pos) override { return body->SetTransform(b2Vec2(pos.x, pos.y), 0.0f); }
+    virtual void SetPos(LcVector2 pos) override { body->SetTransform(b2Vec2(pos.x, pos.y), 0.0f); SnapTransform(); }
+    //
+    void SetTransform(LcVector2 pos, float angle) { body->SetTransform(FromLC(pos), angle); SnapTransform(); }
 	//
 	virtual LcVector2 GetPos() const override { return ToLC(body->GetPosition()); }
 	//
 	virtual float GetRotation() const override { return body->GetAngle(); }
     //
+    virtual LcVector2 GetInterpolatedPos() const override { return renderPos; }
+    //
+    virtual float GetInterpolatedRotation() const override { return renderAngle; }
+    //
     virtual void SetUserData(void* data) override { body->GetUserData().pointer = reinterpret_cast<uintptr_t>(data); }
     //
     virtual void* GetUserData() const override { return reinterpret_cast<void*>(body->GetUserData().pointer); }
@@ -151,24 +226,105 @@ void LcBox2DWorld::Clear(bool removeRooted)
     if (removeRooted)
     {
         dynamicBodies.Clear();
+        staticBoxes.clear();
         box2DWorld = std::make_unique<b2World>(FromLC(config.gravity, false));
     }
     else
     {
-        IPhysicsWorld::TBodiesList removedBodies;
-        auto& bodies = dynamicBodies.GetItems();
-
-        std::copy_if(bodies.begin(), bodies.end(), std::inserter(removedBodies, removedBodies.begin()), [](auto& body) {
-            return !body->IsRooted();
-        });
+        std::vector<IPhysicsBody*> removedBodies;
+        for (auto& body : dynamicBodies.GetItems())
+        {
+            if (!body->IsRooted()) removedBodies.push_back(body.get());
+        }
 
-        dynamicBodies.Clear(removedBodies.begin(), removedBodies.end());
+        for (auto body : removedBodies)
+        {
+            dynamicBodies.Remove(body);
+        }
     }
 }
 
 void LcBox2DWorld::Update(float deltaSeconds, const LcAppContext& context)
 {
-	if (box2DWorld) box2DWorld->Step(deltaSeconds, config.velocityIterations, config.positionIterations);
+    if (!box2DWorld) return;
+
+    for (auto& body : dynamicBodies.GetItems())
+    {
+        static_cast<LcBox2DBody*>(body.get())->SavePrevTransform();
+    }
+
+    box2DWorld->Step(deltaSeconds, config.velocityIterations, config.positionIterations);
+}
+
+void LcBox2DWorld::Interpolate(float alpha)
+{
+    for (auto& body : dynamicBodies.GetItems())
+    {
+        static_cast<LcBox2DBody*>(body.get())->Interpolate(alpha);
+    }
+}
+
+void LcBox2DWorld::Save(LcArchiveWriter& writer, bool saveRooted) const
+{
+    std::vector<LcStaticBoxRecord> boxRecords;
+    if (saveRooted)
+    {
+        boxRecords.reserve(staticBoxes.size());
+        for (auto& box : staticBoxes)
+        {
+            boxRecords.push_back(LcStaticBoxRecord{ box.first, box.second });
+        }
+    }
+
+    std::vector<LcBodyRecord> bodyRecords;
+    bodyRecords.reserve(dynamicBodies.GetItems().size());
+    for (auto& item : dynamicBodies.GetItems())
+    {
+        if (!saveRooted && item->IsRooted()) continue;
+
+        auto body = static_cast<const LcBox2DBody*>(item.get());
+        uint32_t flags = 0;
+        if (body->IsRooted()) flags |= LcBodyRooted;
+        if (body->body->IsFixedRotation()) flags |= LcBodyFixedRotation;
+        if (body->fixture->GetType() == b2Shape::e_circle) flags |= LcBodyCircle;
+
+        bodyRecords.push_back(LcBodyRecord{ body->GetTag(), flags, body->GetPos(),
+            LcSizef{ body->size.x * BOX2D_SCALE, body->size.y * BOX2D_SCALE }, body->fixture->GetDensity(),
+            body->GetRotation(), body->GetVelocity(), body->body->GetAngularVelocity() });
+    }
+
+    writer.AddSection(LcPhysicsSections::StaticBoxes, LcStaticBoxesVersion, boxRecords);
+    writer.AddSection(LcPhysicsSections::Bodies, LcBodiesVersion, bodyRecords);
+}
+
+void LcBox2DWorld::Load(const LcArchiveReader& reader)
+{
+    size_t numBoxes = 0, numBodies = 0;
+    auto boxRecords = reader.GetItems<LcStaticBoxRecord>(LcPhysicsSections::StaticBoxes, LcStaticBoxesVersion, numBoxes);
+    auto bodyRecords = reader.GetItems<LcBodyRecord>(LcPhysicsSections::Bodies, LcBodiesVersion, numBodies);
+
+    for (size_t i = 0; i < numBoxes; i++)
+    {
+        AddStaticBox(boxRecords[i].pos, boxRecords[i].size);
+    }
+
+    for (size_t i = 0; i < numBodies; i++)
+    {
+        const auto& record = bodyRecords[i];
+        bool fixedRotation = (record.flags & LcBodyFixedRotation) != 0;
+
+        auto newBody = (record.flags & LcBodyCircle) ?
+            AddDynamic(record.pos, record.size.x / 2.0f, record.density, fixedRotation) :
+            AddDynamicBox(record.pos, record.size, record.density, fixedRotation);
+
+        auto body = static_cast<LcBox2DBody*>(newBody);
+        body->SetTransform(record.pos, record.angle);
+        body->SetVelocity(record.velocity);
+        body->body->SetAngularVelocity(record.angularVelocity);
+
+        if (record.tag != LcNoTag) body->SetTag(record.tag);
+        if (record.flags & LcBodyRooted) body->AddToRoot();
+    }
 }
 
 void LcBox2DWorld::AddStaticBox(LcVector2 pos, LcSizef size)
@@ -183,6 +339,8 @@ void LcBox2DWorld::AddStaticBox(LcVector2 pos, LcSizef size)
     b2PolygonShape box;
     box.SetAsBox(size.x / BOX2D_SCALE / 2.0f, size.y / BOX2D_SCALE / 2.0f);
     body->CreateFixture(&box, 0.0f);
+
+    staticBoxes.push_back(std::make_pair(pos, size));
 }
 
 IPhysicsBody* LcBox2DWorld::AddDynamicBox(LcVector2 pos, LcSizef size, float density, bool fixedRotation)
@@ -244,14 +402,6 @@ IPhysicsBody* LcBox2DWorld::AddDynamic(LcVector2 pos, float radius, float densit
     return newBody;
 }
 
-IPhysicsBody* LcBox2DWorld::GetBodyByTag(ObjectTag tag) const
-{
-    auto it = std::find_if(dynamicBodies.GetItems().begin(), dynamicBodies.GetItems().end(), [tag](auto& body) {
-        return body->GetTag() == tag;
-    });
-    return (it != dynamicBodies.GetItems().end()) ? it->get() : nullptr;
-}
-
 
 TPhysicsWorldPtr GetPhysicsWorld()
 {
@@ -10,6 +10,7 @@
 #include "Core/Physics.h"
 
 #include <memory>
+#include <vector>
 
 #pragma warning(disable : 4251)
 #pragma warning(disable : 4275)
@@ -55,6 +56,12 @@ public:// IPhysicsWorld interface implementation
 	//
 	virtual void Update(float deltaSeconds, const LcAppContext& context) override;
 	//
+	virtual void Interpolate(float alpha) override;
+	//
+	virtual void Save(class LcArchiveWriter& writer, bool saveRooted = false) const override;
+	//
+	virtual void Load(const class LcArchiveReader& reader) override;
+	//
 	virtual void AddStaticBox(LcVector2 pos, LcSizef size) override;
 	//
 	virtual IPhysicsBody* AddDynamic(LcVector2 pos, float radius, float density, bool fixedRotation = true) override;
@@ -65,14 +72,20 @@ public:// IPhysicsWorld interface implementation
 	//
 	virtual TBodiesList& GetDynamicBodies() override { return dynamicBodies.GetItems(); }
 	//
-	virtual IPhysicsBody* GetBodyByTag(ObjectTag tag) const override;
+	virtual IPhysicsBody* GetBodyByTag(ObjectTag tag) const override { return dynamicBodies.GetTagIndex().Find(tag); }
+	//
+	virtual IPhysicsBody* GetBodyByHandle(LcObjectHandle handle) const override { return dynamicBodies.GetByHandle(handle); }
+	//
+	virtual size_t GetBodiesByTag(ObjectTag tag, std::vector<IPhysicsBody*>& outBodies) const override { return dynamicBodies.GetTagIndex().FindAll(tag, outBodies); }
 
 
 protected:
 	std::unique_ptr<class b2World> box2DWorld;
 	//
-	LcCreator<IPhysicsBody> dynamicBodies;
+	LcCreator<IPhysicsBody, LcLifetimeStrategy<IPhysicsBody, TBodiesList>, TBodiesList> dynamicBodies;
 	//
 	LcBox2DConfig config;
+	// static boxes in pixels: center, size
+	std::vector<std::pair<LcVector2, LcSizef>> staticBoxes;
 
 };
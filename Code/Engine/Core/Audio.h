@@ -70,7 +70,7 @@ class IAudioSystem
 public:
 	typedef std::shared_ptr<ISound> TSoundPtr;
 	//
-	typedef std::deque<TSoundPtr> TSoundsList;
+	typedef LcSlotMap<ISound> TSoundsList;
 
 
 public:
@@ -96,9 +96,15 @@ public:
 	* Remove sound */
 	virtual void RemoveSound(ISound* sound) = 0;
 	/**
-	* Get sound */
+	* Get sound by tag */
 	virtual ISound* GetSoundByTag(ObjectTag tag) const = 0;
 	/**
+	* Get sound by handle. Returns nullptr for removed sounds */
+	virtual ISound* GetSoundByHandle(LcObjectHandle handle) const = 0;
+	/**
+	* Append all sounds with tag to the list. Returns number of found sounds */
+	virtual size_t GetSoundsByTag(ObjectTag tag, std::vector<ISound*>& outSounds) const = 0;
+	/**
 	* Get sounds list */
 	virtual const TSoundsList& GetSounds() const = 0;
 
@@ -132,10 +138,16 @@ public:// IAudioSystem interface implementation
 		sounds.Remove(sound);
 	}
 	//
+	virtual ISound* GetSoundByTag(ObjectTag tag) const override { return sounds.GetTagIndex().Find(tag); }
+	//
+	virtual ISound* GetSoundByHandle(LcObjectHandle handle) const override { return sounds.GetByHandle(handle); }
+	//
+	virtual size_t GetSoundsByTag(ObjectTag tag, std::vector<ISound*>& outSounds) const override { return sounds.GetTagIndex().FindAll(tag, outSounds); }
+	//
 	virtual const TSoundsList& GetSounds() const override { return sounds.GetItems(); }
 
 
 protected:
-	LcCreator<ISound> sounds;
+	LcCreator<ISound, LcLifetimeStrategy<ISound, TSoundsList>, TSoundsList> sounds;
 
 };
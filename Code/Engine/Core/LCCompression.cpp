@@ -0,0 +1,581 @@
+/**
+* LCCompression.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "Core/LCCompression.h"
+
+#include <array>
+#include <string>
+#include <cstring>
+#include <exception>
+
+#ifdef LC_ZSTD
+// put zstd headers and libzstd static library into Code/Engine/zstd folder
+#include "zstd/zstd.h"
+#endif
+
+
+/** Base64 symbol values, 0x80 - invalid symbol */
+static const std::array<uint8_t, 256> LcBase64Table = [] {
+	std::array<uint8_t, 256> table{};
+	table.fill(0x80);
+
+	const char* symbols = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	for (uint8_t i = 0; i < 64; i++) table[static_cast<uint8_t>(symbols[i])] = i;
+
+	return table;
+}();
+
+/** CRC-32 table for gzip */
+static const std::array<uint32_t, 256> LcCrc32Table = [] {
+	std::array<uint32_t, 256> table{};
+	for (uint32_t i = 0; i < 256; i++)
+	{
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; bit++) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+		table[i] = crc;
+	}
+
+	return table;
+}();
+
+/** Deflate length and distance codes */
+static const uint16_t LcLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t LcLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t LcDistBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+	4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t LcDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const uint8_t LcCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+/** Huffman codes up to this length are decoded with one table lookup */
+constexpr int LcFastBits = 10;
+
+
+/** Whitespace allowed between base64 symbols, as Tiled and other editors wrap lines */
+inline bool IsBase64Space(uint8_t symbol)
+{
+	return symbol == ' ' || symbol == '\n' || symbol == '\r' || symbol == '\t';
+}
+
+size_t DecodeBase64(const char* text, size_t length, void* outData, size_t outCapacity)
+{
+	auto in = reinterpret_cast<const uint8_t*>(text);
+	auto out = static_cast<uint8_t*>(outData);
+	auto table = LcBase64Table.data();
+
+	size_t numPadding = 0;
+	while (length > 0)
+	{
+		uint8_t symbol = in[length - 1];
+		if (IsBase64Space(symbol)) length--;
+		else if (symbol == '=' && numPadding < 2) { length--; numPadding++; }
+		else break;
+	}
+
+	// symbols are read before writing and output is shorter, so output could overlap text
+	size_t pos = 0;
+	size_t outPos = 0;
+	uint32_t bits = 0;
+	int numSymbols = 0;
+	while (pos < length)
+	{
+		// whole quads with no whitespace are decoded at once
+		if (numSymbols == 0)
+		{
+			for (; pos + 4 <= length; pos += 4, outPos += 3)
+			{
+				uint32_t a0 = table[in[pos]], a1 = table[in[pos + 1]], a2 = table[in[pos + 2]], a3 = table[in[pos + 3]];
+				if ((a0 | a1 | a2 | a3) & 0x80) break;
+				if (outPos + 3 > outCapacity) throw std::exception("DecodeBase64(): Output buffer is too small");
+
+				uint32_t a = (a0 << 18) | (a1 << 12) | (a2 << 6) | a3;
+				out[outPos] = static_cast<uint8_t>(a >> 16);
+				out[outPos + 1] = static_cast<uint8_t>(a >> 8);
+				out[outPos + 2] = static_cast<uint8_t>(a);
+			}
+
+			if (pos >= length) break;
+		}
+
+		uint8_t symbol = in[pos++];
+		uint32_t value = table[symbol];
+		if (value & 0x80)
+		{
+			if (IsBase64Space(symbol)) continue;
+			throw std::exception("DecodeBase64(): Invalid symbol");
+		}
+
+		bits = (bits << 6) | value;
+		if (++numSymbols < 4) continue;
+
+		if (outPos + 3 > outCapacity) throw std::exception("DecodeBase64(): Output buffer is too small");
+		out[outPos] = static_cast<uint8_t>(bits >> 16);
+		out[outPos + 1] = static_cast<uint8_t>(bits >> 8);
+		out[outPos + 2] = static_cast<uint8_t>(bits);
+		outPos += 3;
+		bits = 0;
+		numSymbols = 0;
+	}
+
+	if (numSymbols == 1 || (numPadding > 0 && numSymbols + numPadding != 4)) throw std::exception("DecodeBase64(): Invalid length");
+
+	if (numSymbols > 0)
+	{
+		size_t numTail = static_cast<size_t>(numSymbols) - 1;
+		if (outPos + numTail > outCapacity) throw std::exception("DecodeBase64(): Output buffer is too small");
+
+		bits <<= 6 * (4 - numSymbols);
+		out[outPos] = static_cast<uint8_t>(bits >> 16);
+		if (numTail == 2) out[outPos + 1] = static_cast<uint8_t>(bits >> 8);
+		outPos += numTail;
+	}
+
+	return outPos;
+}
+
+
+/** Canonical Huffman code */
+struct LcHuffman
+{
+	// symbol << 4 | code length, 0 - code is longer than LcFastBits
+	uint16_t fast[1 << LcFastBits];
+	// number of codes of each length
+	uint16_t counts[16];
+	// symbols ordered by code
+	uint16_t symbols[288];
+};
+
+
+/**
+* Deflate (RFC 1951) decoder. Writes to output buffer directly, bits are read 64 at a time
+*/
+class LcInflater
+{
+public:
+	LcInflater(const uint8_t* data, size_t size, uint8_t* outData, size_t capacity) : in(data), inSize(size), inPos(0),
+		out(outData), outCapacity(capacity), outPos(0), bits(0), numBits(0) {}
+	/**
+	* Decompress all blocks, returns decompressed size */
+	size_t Inflate()
+	{
+		bool lastBlock = false;
+		while (!lastBlock)
+		{
+			lastBlock = GetBits(1) != 0;
+
+			switch (GetBits(2))
+			{
+			case 0: StoredBlock(); break;
+			case 1: FixedBlock(); break;
+			case 2: DynamicBlock(); break;
+			default: throw std::exception("LcInflater::Inflate(): Invalid block type");
+			}
+		}
+
+		if (inPos > inSize + numBits / 8) throw std::exception("LcInflater::Inflate(): Unexpected end of data");
+
+		return outPos;
+	}
+	/**
+	* Number of input bytes used by decompressed blocks */
+	inline size_t GetNumConsumed() const { return inPos - numBits / 8; }
+
+
+protected:
+	inline void Refill()
+	{
+		if (inPos + 8 <= inSize)
+		{
+			// little endian load, whole bytes are added
+			uint64_t value;
+			memcpy(&value, in + inPos, sizeof(value));
+			bits |= value << numBits;
+			inPos += (63 - numBits) >> 3;
+			numBits |= 56;
+			bits &= (1ull << numBits) - 1;
+			return;
+		}
+
+		// zeros after end of data, checked when done
+		while (numBits <= 56)
+		{
+			uint64_t value = (inPos < inSize) ? in[inPos] : 0;
+			bits |= value << numBits;
+			inPos++;
+			numBits += 8;
+		}
+	}
+	//
+	inline uint32_t GetBits(int count)
+	{
+		if (numBits < count) Refill();
+
+		uint32_t value = static_cast<uint32_t>(bits & ((1ull << count) - 1));
+		bits >>= count;
+		numBits -= count;
+		return value;
+	}
+	//
+	inline int Decode(const LcHuffman& huffman)
+	{
+		if (numBits < 15) Refill();
+
+		uint16_t entry = huffman.fast[bits & ((1 << LcFastBits) - 1)];
+		if (entry != 0)
+		{
+			int length = entry & 15;
+			bits >>= length;
+			numBits -= length;
+			return entry >> 4;
+		}
+
+		// long code, decode bit by bit
+		int code = 0;
+		int first = 0;
+		int index = 0;
+		for (int length = 1; length < 16; length++)
+		{
+			code |= static_cast<int>(bits & 1);
+			bits >>= 1;
+			numBits--;
+
+			int count = huffman.counts[length];
+			if (code - count < first) return huffman.symbols[index + (code - first)];
+
+			index += count;
+			first = (first + count) << 1;
+			code <<= 1;
+		}
+
+		throw std::exception("LcInflater::Decode(): Invalid code");
+	}
+	//
+	void Build(LcHuffman& huffman, const uint8_t* lengths, int numSymbols)
+	{
+		memset(huffman.counts, 0, sizeof(huffman.counts));
+		for (int symbol = 0; symbol < numSymbols; symbol++) huffman.counts[lengths[symbol]]++;
+		huffman.counts[0] = 0;
+
+		int left = 1;
+		for (int length = 1; length < 16; length++)
+		{
+			left = (left << 1) - huffman.counts[length];
+			if (left < 0) throw std::exception("LcInflater::Build(): Over-subscribed code");
+		}
+
+		uint16_t offsets[16] = {};
+		for (int length = 1; length < 15; length++) offsets[length + 1] = offsets[length] + huffman.counts[length];
+		for (int symbol = 0; symbol < numSymbols; symbol++)
+		{
+			if (lengths[symbol] != 0) huffman.symbols[offsets[lengths[symbol]]++] = static_cast<uint16_t>(symbol);
+		}
+
+		// short codes are stored reversed, as bits are read from lowest
+		memset(huffman.fast, 0, sizeof(huffman.fast));
+		int code = 0;
+		int index = 0;
+		for (int length = 1; length <= LcFastBits; length++)
+		{
+			for (int i = 0; i < huffman.counts[length]; i++, code++)
+			{
+				int reversed = 0;
+				for (int bit = 0; bit < length; bit++) reversed |= ((code >> bit) & 1) << (length - 1 - bit);
+
+				auto entry = static_cast<uint16_t>((huffman.symbols[index + i] << 4) | length);
+				for (int j = reversed; j < (1 << LcFastBits); j += (1 << length)) huffman.fast[j] = entry;
+			}
+
+			index += huffman.counts[length];
+			code <<= 1;
+		}
+	}
+	//
+	void StoredBlock()
+	{
+		// skip to byte boundary
+		int skip = numBits & 7;
+		bits >>= skip;
+		numBits -= skip;
+
+		uint32_t length = GetBits(16);
+		uint32_t lengthCheck = GetBits(16);
+		if (length != (~lengthCheck & 0xFFFF)) throw std::exception("LcInflater::StoredBlock(): Invalid block length");
+		if (length > outCapacity - outPos) throw std::exception("LcInflater::StoredBlock(): Output buffer is too small");
+
+		for (; length > 0 && numBits >= 8; length--)
+		{
+			out[outPos++] = static_cast<uint8_t>(bits);
+			bits >>= 8;
+			numBits -= 8;
+		}
+
+		if (length > 0)
+		{
+			if (inPos > inSize || length > inSize - inPos) throw std::exception("LcInflater::StoredBlock(): Unexpected end of data");
+
+			memcpy(out + outPos, in + inPos, length);
+			inPos += length;
+			outPos += length;
+		}
+	}
+	//
+	void FixedBlock()
+	{
+		uint8_t lengths[288 + 30];
+		memset(lengths, 8, 144);
+		memset(lengths + 144, 9, 112);
+		memset(lengths + 256, 7, 24);
+		memset(lengths + 280, 8, 8);
+		memset(lengths + 288, 5, 30);
+
+		Build(literals, lengths, 288);
+		Build(distances, lengths + 288, 30);
+		Codes();
+	}
+	//
+	void DynamicBlock()
+	{
+		int numLiterals = GetBits(5) + 257;
+		int numDistances = GetBits(5) + 1;
+		int numCodeLengths = GetBits(4) + 4;
+		if (numLiterals > 286 || numDistances > 30) throw std::exception("LcInflater::DynamicBlock(): Invalid code counts");
+
+		uint8_t lengths[286 + 30] = {};
+		for (int i = 0; i < numCodeLengths; i++) lengths[LcCodeLengthOrder[i]] = static_cast<uint8_t>(GetBits(3));
+
+		// code length codes, literals table is reused
+		Build(literals, lengths, 19);
+
+		int numLengths = numLiterals + numDistances;
+		for (int index = 0; index < numLengths;)
+		{
+			int symbol = Decode(literals);
+			if (symbol < 16)
+			{
+				lengths[index++] = static_cast<uint8_t>(symbol);
+				continue;
+			}
+
+			uint8_t length = 0;
+			int repeat = 0;
+			if (symbol == 16)
+			{
+				if (index == 0) throw std::exception("LcInflater::DynamicBlock(): No length to repeat");
+				length = lengths[index - 1];
+				repeat = 3 + GetBits(2);
+			}
+			else if (symbol == 17)
+			{
+				repeat = 3 + GetBits(3);
+			}
+			else
+			{
+				repeat = 11 + GetBits(7);
+			}
+
+			if (index + repeat > numLengths) throw std::exception("LcInflater::DynamicBlock(): Too many lengths");
+			for (; repeat > 0; repeat--) lengths[index++] = length;
+		}
+
+		if (lengths[256] == 0) throw std::exception("LcInflater::DynamicBlock(): No end of block code");
+
+		Build(literals, lengths, numLiterals);
+		Build(distances, lengths + numLiterals, numDistances);
+		Codes();
+	}
+	//
+	void Codes()
+	{
+		for (;;)
+		{
+			int symbol = Decode(literals);
+			if (symbol < 256)
+			{
+				if (outPos >= outCapacity) throw std::exception("LcInflater::Codes(): Output buffer is too small");
+				out[outPos++] = static_cast<uint8_t>(symbol);
+				continue;
+			}
+
+			if (symbol == 256) return;
+
+			symbol -= 257;
+			if (symbol >= 29) throw std::exception("LcInflater::Codes(): Invalid length code");
+
+			size_t length = LcLengthBase[symbol] + GetBits(LcLengthExtra[symbol]);
+			int distSymbol = Decode(distances);
+			if (distSymbol >= 30) throw std::exception("LcInflater::Codes(): Invalid distance code");
+
+			size_t distance = LcDistBase[distSymbol] + GetBits(LcDistExtra[distSymbol]);
+			if (distance > outPos) throw std::exception("LcInflater::Codes(): Invalid distance");
+			if (length > outCapacity - outPos) throw std::exception("LcInflater::Codes(): Output buffer is too small");
+
+			uint8_t* dst = out + outPos;
+			const uint8_t* src = dst - distance;
+			if (distance >= length)
+			{
+				memcpy(dst, src, length);
+			}
+			else
+			{
+				// overlapped copy repeats last bytes
+				for (size_t i = 0; i < length; i++) dst[i] = src[i];
+			}
+
+			outPos += length;
+		}
+	}
+
+
+protected:
+	const uint8_t* in;
+	//
+	size_t inSize;
+	// next byte to load, could be after end of data
+	size_t inPos;
+	//
+	uint8_t* out;
+	//
+	size_t outCapacity;
+	//
+	size_t outPos;
+	//
+	uint64_t bits;
+	//
+	int numBits;
+	//
+	LcHuffman literals;
+	//
+	LcHuffman distances;
+
+};
+
+
+static uint32_t Adler32(const uint8_t* data, size_t size)
+{
+	uint32_t a = 1;
+	uint32_t b = 0;
+	while (size > 0)
+	{
+		// largest block without overflow
+		size_t blockSize = (size < 5552) ? size : 5552;
+		for (size_t i = 0; i < blockSize; i++)
+		{
+			a += data[i];
+			b += a;
+		}
+
+		a %= 65521;
+		b %= 65521;
+		data += blockSize;
+		size -= blockSize;
+	}
+
+	return (b << 16) | a;
+}
+
+static uint32_t Crc32(const uint8_t* data, size_t size)
+{
+	uint32_t crc = 0xFFFFFFFFu;
+	for (size_t i = 0; i < size; i++) crc = LcCrc32Table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+	return crc ^ 0xFFFFFFFFu;
+}
+
+size_t InflateZlib(const void* data, size_t size, void* outData, size_t outCapacity)
+{
+	auto in = static_cast<const uint8_t*>(data);
+	auto out = static_cast<uint8_t*>(outData);
+	if (size < 6) throw std::exception("InflateZlib(): Invalid data");
+
+	// deflate, no preset dictionary
+	if ((in[0] & 0x0F) != 8 || (in[0] >> 4) > 7 || ((in[0] << 8) | in[1]) % 31 != 0 || (in[1] & 0x20) != 0)
+	{
+		throw std::exception("InflateZlib(): Invalid header");
+	}
+
+	LcInflater inflater(in + 2, size - 2, out, outCapacity);
+	size_t outSize = inflater.Inflate();
+
+	size_t pos = 2 + inflater.GetNumConsumed();
+	if (pos + 4 > size) throw std::exception("InflateZlib(): No checksum");
+
+	uint32_t checksum = (uint32_t(in[pos]) << 24) | (uint32_t(in[pos + 1]) << 16) | (uint32_t(in[pos + 2]) << 8) | uint32_t(in[pos + 3]);
+	if (Adler32(out, outSize) != checksum) throw std::exception("InflateZlib(): Checksum mismatch");
+
+	return outSize;
+}
+
+size_t InflateGzip(const void* data, size_t size, void* outData, size_t outCapacity)
+{
+	auto in = static_cast<const uint8_t*>(data);
+	auto out = static_cast<uint8_t*>(outData);
+	if (size < 18 || in[0] != 0x1F || in[1] != 0x8B || in[2] != 8) throw std::exception("InflateGzip(): Invalid header");
+
+	uint8_t flags = in[3];
+	size_t pos = 10;
+	if (flags & 0x04)
+	{
+		// extra field
+		if (pos + 2 > size) throw std::exception("InflateGzip(): Invalid header");
+		pos += 2 + (size_t(in[pos]) | (size_t(in[pos + 1]) << 8));
+	}
+	if (flags & 0x08)
+	{
+		// file name
+		while (pos < size && in[pos] != 0) pos++;
+		pos++;
+	}
+	if (flags & 0x10)
+	{
+		// comment
+		while (pos < size && in[pos] != 0) pos++;
+		pos++;
+	}
+	if (flags & 0x02)
+	{
+		// header crc
+		pos += 2;
+	}
+	if (pos >= size) throw std::exception("InflateGzip(): Invalid header");
+
+	LcInflater inflater(in + pos, size - pos, out, outCapacity);
+	size_t outSize = inflater.Inflate();
+
+	pos += inflater.GetNumConsumed();
+	if (pos + 8 > size) throw std::exception("InflateGzip(): No trailer");
+
+	uint32_t checksum = uint32_t(in[pos]) | (uint32_t(in[pos + 1]) << 8) | (uint32_t(in[pos + 2]) << 16) | (uint32_t(in[pos + 3]) << 24);
+	uint32_t inputSize = uint32_t(in[pos + 4]) | (uint32_t(in[pos + 5]) << 8) | (uint32_t(in[pos + 6]) << 16) | (uint32_t(in[pos + 7]) << 24);
+	if (inputSize != static_cast<uint32_t>(outSize) || Crc32(out, outSize) != checksum) throw std::exception("InflateGzip(): Checksum mismatch");
+
+	return outSize;
+}
+
+bool IsZstdSupported()
+{
+#ifdef LC_ZSTD
+	return true;
+#else
+	return false;
+#endif
+}
+
+size_t DecompressZstd(const void* data, size_t size, void* outData, size_t outCapacity)
+{
+#ifdef LC_ZSTD
+	size_t outSize = ZSTD_decompress(outData, outCapacity, data, size);
+	if (ZSTD_isError(outSize)) throw std::exception((std::string("DecompressZstd(): ") + ZSTD_getErrorName(outSize)).c_str());
+
+	return outSize;
+#else
+	(void)data;
+	(void)size;
+	(void)outData;
+	(void)outCapacity;
+
+	throw std::exception("DecompressZstd(): Built without zstd, define LC_ZSTD and link zstd library");
+#endif
+}
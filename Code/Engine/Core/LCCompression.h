@@ -0,0 +1,31 @@
+/**
+* LCCompression.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Module.h"
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+* Decode base64 text, returns decoded size. Whitespace between symbols is skipped.
+* Output could be the text buffer itself, as decoded data is shorter. Throws on invalid text or small output buffer */
+CORE_API size_t DecodeBase64(const char* text, size_t length, void* outData, size_t outCapacity);
+/**
+* Decompress zlib stream (RFC 1950), returns decompressed size. Throws on invalid data or small output buffer */
+CORE_API size_t InflateZlib(const void* data, size_t size, void* outData, size_t outCapacity);
+/**
+* Decompress gzip stream (RFC 1952), returns decompressed size. Throws on invalid data or small output buffer */
+CORE_API size_t InflateGzip(const void* data, size_t size, void* outData, size_t outCapacity);
+/**
+* Returns true if built with LC_ZSTD defined, so DecompressZstd could be used */
+CORE_API bool IsZstdSupported();
+/**
+* Decompress zstd frame, returns decompressed size. Throws on invalid data or small output buffer.
+* Requires build with LC_ZSTD defined and zstd library linked, throws otherwise */
+CORE_API size_t DecompressZstd(const void* data, size_t size, void* outData, size_t outCapacity);
@@ -8,9 +8,22 @@
 
 #include "Module.h"
 #include "Core/LCTypes.h"
+#include "Core/LCTagIndex.h"
+#include "Core/LCSlotMap.h"
 
 #include <memory>
 #include <deque>
+#include <algorithm>
+
+
+/** Find item in container. Overloaded by containers with faster lookup */
+template<class Container, class I>
+typename Container::iterator LcFindItem(Container& items, const I* item)
+{
+	return std::find_if(items.begin(), items.end(), [item](const std::shared_ptr<I>& curItem) {
+		return curItem.get() == item;
+	});
+}
 
 
 /** Default lifetime strategy */
@@ -25,6 +38,8 @@ public:
 	virtual std::shared_ptr<T> Create(const void* userData) { return std::shared_ptr<T>(); }
 	//
 	virtual void Destroy(T& item, Container& items) {}
+	// item is removed from container, strategy could keep it for reuse
+	virtual void Recycle(std::shared_ptr<T> item) {}
 	// need static int GetStaticId() from each type
 	int curTypeId;
 };
@@ -62,34 +77,53 @@ public:
 	//
 	template<class T>
 	T* Add(void* userData = nullptr)
+	{
+		TItemPtr newItem = Create<T>(userData);
+		Insert(newItem);
+		return static_cast<T*>(newItem.get());
+	}
+	// Create item without adding it, see Insert()
+	template<class T>
+	TItemPtr Create(void* userData = nullptr)
 	{
 		strategy->curTypeId = T::GetStaticId();
-		TItemPtr newItem = strategy->Create(userData);
+		return strategy->Create(userData);
+	}
+	// Add item made by Create()
+	void Insert(const TItemPtr& newItem)
+	{
 		items.insert(items.end(), newItem);
-		return static_cast<T*>(newItem.get());
+		tags.Add(newItem.get());
 	}
 	//
 	void Remove(I* item)
 	{
 		if (item)
 		{
-			auto it = std::find_if(items.begin(), items.end(), [item](const std::shared_ptr<I>& curItem) {
-				return curItem.get() == item;
-			});
+			auto it = LcFindItem(items, static_cast<const I*>(item));
+			if (it == items.end()) return;
 
 			strategy->Destroy(*item, items);
+			tags.Remove(item);
+
+			TItemPtr removed = *it;
 			items.erase(it);
+			strategy->Recycle(std::move(removed));
 		}
 	}
+	// Container should support handles, see LcSlotMap
+	void RemoveByHandle(LcObjectHandle handle)
+	{
+		Remove(items.Get(handle));
+	}
 	//
-	void Clear(const TItemIterator& begin, const TItemIterator& end)
+	template<class Iterator>
+	void Clear(const Iterator& begin, const Iterator& end)
 	{
 		for (auto it = begin; it != end; ++it)
 		{
-			strategy->Destroy(*it->get(), items);
+			Remove(it->get());
 		}
-
-		items.clear();
 	}
 	//
 	void Clear()
@@ -97,19 +131,29 @@ public:
 		for (const TItemPtr& item : items)
 		{
 			strategy->Destroy(*item.get(), items);
+			tags.Remove(item.get());
 		}
 
+		tags.Clear();
 		items.clear();
 	}
 	//
 	const TItemsList& GetItems() const { return items; }
 	//
 	TItemsList& GetItems() { return items; }
+	//
+	const LcTagIndex<I>& GetTagIndex() const { return tags; }
+	//
+	Strategy* GetLifetimeStrategy() const { return strategy.get(); }
+	// Container should support handles, see LcSlotMap. Returns nullptr for stale handles
+	I* GetByHandle(LcObjectHandle handle) const { return items.Get(handle); }
 
 
 protected:
 	TItemsList items;
 	//
 	TStrategyPtr strategy;
+	//
+	LcTagIndex<I> tags;
 
 };
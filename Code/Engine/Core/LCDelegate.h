@@ -7,40 +7,344 @@
 #pragma once
 
 #include "Module.h"
+#include "Core/LCSlotMap.h"
 
-#include <functional>
 #include <deque>
+#include <tuple>
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <functional>
+#include <type_traits>
+
+
+/** Delegate subscription handle, returned by LcDelegate::AddListener() */
+typedef LcObjectHandle LcDelegateHandle;
+
+/** Inplace function storage size: fits lambda capturing up to 4 pointers */
+constexpr size_t LcInplaceFunctionSize = 4 * sizeof(void*);
+
+
+template<class Signature, size_t Size = LcInplaceFunctionSize>
+class LcInplaceFunction;
+
+/**
+* Function wrapper with small buffer storage. Callables up to Size bytes are stored in place
+* without heap allocation, bigger ones are allocated once on assignment.
+*/
+template<class R, class ...A, size_t Size>
+class LcInplaceFunction<R(A...), Size>
+{
+	enum class LcOp { Copy, Move, Destroy };
+	//
+	typedef R(*TInvoker)(void* storage, A&&... a);
+	//
+	typedef void(*TManager)(LcOp op, void* dst, void* src);
+	//
+	template<class F>
+	struct LcFitsInplace : std::integral_constant<bool, sizeof(F) <= Size &&
+		alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<F>::value> {};
+
+
+public:
+	LcInplaceFunction() noexcept : invoker(nullptr), manager(nullptr) {}
+	//
+	LcInplaceFunction(std::nullptr_t) noexcept : invoker(nullptr), manager(nullptr) {}
+	//
+	template<class F, class = std::enable_if_t<!std::is_same<std::decay_t<F>, LcInplaceFunction>::value>>
+	LcInplaceFunction(F&& func) : invoker(nullptr), manager(nullptr) { Assign<std::decay_t<F>>(std::forward<F>(func)); }
+	//
+	LcInplaceFunction(const LcInplaceFunction& other) : invoker(other.invoker), manager(other.manager)
+	{
+		if (manager) manager(LcOp::Copy, storage, other.storage);
+	}
+	//
+	LcInplaceFunction(LcInplaceFunction&& other) noexcept : invoker(other.invoker), manager(other.manager)
+	{
+		if (manager) manager(LcOp::Move, storage, other.storage);
+		other.invoker = nullptr;
+		other.manager = nullptr;
+	}
+	//
+	~LcInplaceFunction() { Reset(); }
+	//
+	LcInplaceFunction& operator=(const LcInplaceFunction& other)
+	{
+		if (this != &other)
+		{
+			LcInplaceFunction copy(other);
+			*this = std::move(copy);
+		}
+
+		return *this;
+	}
+	//
+	LcInplaceFunction& operator=(LcInplaceFunction&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset();
+			invoker = other.invoker;
+			manager = other.manager;
+			if (manager) manager(LcOp::Move, storage, other.storage);
+			other.invoker = nullptr;
+			other.manager = nullptr;
+		}
+
+		return *this;
+	}
+	//
+	R operator()(A... a) const
+	{
+		if (!invoker) throw std::bad_function_call();
+
+		return invoker(storage, std::forward<A>(a)...);
+	}
+	//
+	explicit operator bool() const noexcept { return invoker != nullptr; }
+	//
+	void Reset() noexcept
+	{
+		if (manager) manager(LcOp::Destroy, storage, nullptr);
+		invoker = nullptr;
+		manager = nullptr;
+	}
+
+
+protected:
+	template<class F, class T>
+	void Assign(T&& func)
+	{
+		static_assert(std::is_copy_constructible<F>::value, "LcInplaceFunction: callable must be copy constructible");
+
+		if constexpr (LcFitsInplace<F>::value)
+		{
+			new (storage) F(std::forward<T>(func));
+
+			invoker = [](void* s, A&&... a) -> R { return (*std::launder(reinterpret_cast<F*>(s)))(std::forward<A>(a)...); };
+			manager = [](LcOp op, void* dst, void* src) {
+				switch (op)
+				{
+				case LcOp::Copy: new (dst) F(*std::launder(reinterpret_cast<F*>(src))); break;
+				case LcOp::Move:
+					new (dst) F(std::move(*std::launder(reinterpret_cast<F*>(src))));
+					std::launder(reinterpret_cast<F*>(src))->~F();
+					break;
+				case LcOp::Destroy: std::launder(reinterpret_cast<F*>(dst))->~F(); break;
+				}
+			};
+		}
+		else
+		{
+			*reinterpret_cast<F**>(storage) = new F(std::forward<T>(func));
+
+			invoker = [](void* s, A&&... a) -> R { return (**reinterpret_cast<F**>(s))(std::forward<A>(a)...); };
+			manager = [](LcOp op, void* dst, void* src) {
+				switch (op)
+				{
+				case LcOp::Copy: *reinterpret_cast<F**>(dst) = new F(**reinterpret_cast<F**>(src)); break;
+				case LcOp::Move: *reinterpret_cast<F**>(dst) = *reinterpret_cast<F**>(src); break;
+				case LcOp::Destroy: delete *reinterpret_cast<F**>(dst); break;
+				}
+			};
+		}
+	}
+
+
+protected:
+	alignas(std::max_align_t) mutable unsigned char storage[Size < sizeof(void*) ? sizeof(void*) : Size];
+	//
+	TInvoker invoker;
+	//
+	TManager manager;
+
+};
 
 
 /**
-* Multicast delegate class
+* Multicast delegate class.
+* AddListener() returns handle for O(1) RemoveListener(), listeners order is not preserved.
+* Listeners could be added and removed during Broadcast(): added ones are called from the next broadcast,
+* removed ones are not called anymore and destroyed after broadcast.
+* BroadcastDeferred() coalesces repeated events until Flush(), only the last arguments are broadcast.
 */
 template<typename ...A>
 class LcDelegate
 {
-	typedef std::function<void(A...)> DType;
+public:
+	typedef LcInplaceFunction<void(A...)> DType;
+	//
+	template<class T>
+	using TStoredArg = std::conditional_t<std::is_reference<T>::value, std::reference_wrapper<std::remove_reference_t<T>>, std::decay_t<T>>;
+
 
 public:
-	LcDelegate() = default;
+	LcDelegate() : broadcastDepth(0), numRemoved(0) {}
 	//
-	LcDelegate(const LcDelegate&) = default;
+	LcDelegate(const LcDelegate& other) : listeners(other.listeners), handles(other.handles),
+		pendingArgs(other.pendingArgs), broadcastDepth(0), numRemoved(other.numRemoved) {}
 	//
-	LcDelegate& operator=(const LcDelegate&) = default;
+	LcDelegate& operator=(const LcDelegate& other)
+	{
+		if (this != &other)
+		{
+			if (broadcastDepth > 0) throw std::exception("LcDelegate::operator=(): Cannot assign during broadcast");
+
+			listeners = other.listeners;
+			handles = other.handles;
+			pendingArgs = other.pendingArgs;
+			numRemoved = other.numRemoved;
+		}
+
+		return *this;
+	}
+	/**
+	* Add listener, returns subscription handle */
+	LcDelegateHandle AddListener(DType listener)
+	{
+		if (!listener) return LcInvalidHandle;
+
+		// deque keeps listeners in place, so adding is safe during broadcast
+		auto handle = handles.Add(static_cast<unsigned int>(listeners.size()));
+		listeners.push_back(LcListener{ std::move(listener), handle });
+
+		return handle;
+	}
+	/**
+	* Remove listener in O(1). Stale and invalid handles are ignored */
+	void RemoveListener(LcDelegateHandle handle)
+	{
+		auto index = handles.Get(handle);
+		if (!index) return;
+
+		unsigned int listenerIndex = *index;
+		handles.Remove(handle);
+
+		if (broadcastDepth > 0)
+		{
+			// listener could be running, erase it after broadcast
+			listeners[listenerIndex].handle = LcInvalidHandle;
+			numRemoved++;
+			return;
+		}
+
+		EraseAt(listenerIndex);
+	}
+	/**
+	* Remove all listeners */
+	void RemoveAllListeners()
+	{
+		if (broadcastDepth > 0)
+		{
+			for (auto& listener : listeners)
+			{
+				if (listener.handle == LcInvalidHandle) continue;
+
+				handles.Remove(listener.handle);
+				listener.handle = LcInvalidHandle;
+				numRemoved++;
+			}
+
+			return;
+		}
+
+		listeners.clear();
+		handles.Clear();
+		numRemoved = 0;
+	}
+	/**
+	* Check listener is subscribed */
+	inline bool HasListener(LcDelegateHandle handle) const { return handles.IsValid(handle); }
 	//
-	void AddListener(const DType& listener) { listeners.push_back(listener); }
+	inline size_t GetNumListeners() const { return handles.Size(); }
+	/**
+	* Call listeners */
+	void Broadcast(A... a)
+	{
+		LcBroadcastScope scope(*this);
+
+		// listeners added during broadcast are skipped
+		size_t numListeners = listeners.size();
+		for (size_t i = 0; i < numListeners; i++)
+		{
+			if (listeners[i].handle != LcInvalidHandle) listeners[i].func(a...);
+		}
+	}
+	/**
+	* Store arguments for Flush(), replacing not flushed ones. Reference arguments must stay valid until Flush() */
+	void BroadcastDeferred(A... a) { pendingArgs.emplace(a...); }
+	/**
+	* Broadcast deferred arguments once. Returns true if there were deferred arguments */
+	bool Flush()
+	{
+		if (!pendingArgs) return false;
+
+		auto args = std::move(*pendingArgs);
+		pendingArgs.reset();
+
+		std::apply([this](auto&... values) { Broadcast(values...); }, args);
+
+		return true;
+	}
+	/**
+	* Check there are deferred arguments */
+	inline bool HasDeferred() const { return pendingArgs.has_value(); }
+
+
+protected:
+	struct LcListener
+	{
+		DType func;
+		// LcInvalidHandle for listeners removed during broadcast
+		LcDelegateHandle handle;
+	};
 	//
-	void RemoveListener(const DType& listener) { listeners.erase(listener); }
+	struct LcBroadcastScope
+	{
+		LcBroadcastScope(LcDelegate& inOwner) : owner(inOwner) { owner.broadcastDepth++; }
+		//
+		~LcBroadcastScope() { if (--owner.broadcastDepth == 0 && owner.numRemoved > 0) owner.EraseRemoved(); }
+		//
+		LcDelegate& owner;
+	};
+	/**
+	* Move last listener to index */
+	void EraseAt(size_t index)
+	{
+		if (index + 1 != listeners.size())
+		{
+			listeners[index] = std::move(listeners.back());
+			if (auto movedIndex = handles.Get(listeners[index].handle)) *movedIndex = static_cast<unsigned int>(index);
+		}
+
+		listeners.pop_back();
+	}
 	//
-	void Broadcast(A... a)
+	void EraseRemoved()
 	{
-		for (DType& listener : listeners)
+		for (size_t i = 0; i < listeners.size();)
 		{
-			listener(a...);
+			if (listeners[i].handle == LcInvalidHandle)
+				EraseAt(i);
+			else
+				i++;
 		}
+
+		numRemoved = 0;
 	}
 
 
 protected:
-	std::deque<DType> listeners;
+	std::deque<LcListener> listeners;
+	// handle to listener index
+	LcHandleTable<unsigned int> handles;
+	//
+	std::optional<std::tuple<TStoredArg<A>...>> pendingArgs;
+	//
+	int broadcastDepth;
+	//
+	size_t numRemoved;
 
 };
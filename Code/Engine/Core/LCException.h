@@ -44,7 +44,7 @@ public:
 
 
 public:// std::exception interface implementation
-	virtual char const* what() const override { return message.c_str(); }
+	virtual char const* what() const noexcept override { return message.c_str(); }
 
 
 protected:
@@ -0,0 +1,131 @@
+/**
+* LCFramePacer.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "Core/LCFramePacer.h"
+
+#include <thread>
+#include <cmath>
+
+
+LcFramePacer::LcFramePacer(unsigned int inTargetFPS, double inSpinTime)
+	: period(TClock::duration::zero())
+	, spinTime(0.0)
+	, targetFPS(0)
+	, nextFrameTime(0)
+	, numFrameTimes(0)
+	, idleSleep(true)
+{
+	SetTargetFPS(inTargetFPS);
+	SetSpinTime(inSpinTime);
+	SetStatsWindow(LcDefaultFrameStatsWindow);
+	Reset();
+}
+
+void LcFramePacer::SetTargetFPS(unsigned int inTargetFPS)
+{
+	targetFPS = inTargetFPS;
+	period = (targetFPS > 0) ?
+		std::chrono::duration_cast<TClock::duration>(std::chrono::duration<double>(1.0 / static_cast<double>(targetFPS))) :
+		TClock::duration::zero();
+
+	deadline = TClock::now() + period;
+}
+
+void LcFramePacer::SetStatsWindow(size_t numFrames)
+{
+	if (numFrames == 0) throw std::exception("LcFramePacer::SetStatsWindow(): Invalid number of frames");
+
+	frameTimes.assign(numFrames, 0.0);
+	nextFrameTime = 0;
+	numFrameTimes = 0;
+}
+
+void LcFramePacer::Reset()
+{
+	prevFrameTime = TClock::now();
+	deadline = prevFrameTime + period;
+	nextFrameTime = 0;
+	numFrameTimes = 0;
+}
+
+void LcFramePacer::Wait()
+{
+	auto now = TClock::now();
+
+	if (targetFPS > 0)
+	{
+		auto spinDuration = std::chrono::duration_cast<TClock::duration>(std::chrono::duration<double>(spinTime));
+
+		// coarse sleep, wakes up before deadline to absorb OS scheduler error
+		if (deadline - now > spinDuration)
+		{
+			std::this_thread::sleep_for(deadline - now - spinDuration);
+		}
+
+		// precise wait
+		now = TClock::now();
+		while (now < deadline)
+		{
+			std::this_thread::yield();
+			now = TClock::now();
+		}
+
+		// late frame starts new pacing from now, so next frames are not rushed
+		deadline += period;
+		if (deadline < now) deadline = now + period;
+	}
+	else if (idleSleep)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		now = TClock::now();
+	}
+
+	AddFrameTime(std::chrono::duration<double>(now - prevFrameTime).count());
+	prevFrameTime = now;
+}
+
+LcFrameStats LcFramePacer::GetStats() const
+{
+	LcFrameStats stats{};
+	if (numFrameTimes == 0) return stats;
+
+	double sum = 0.0;
+	double minTime = frameTimes[0];
+	double maxTime = frameTimes[0];
+	for (size_t i = 0; i < numFrameTimes; i++)
+	{
+		double frameTime = frameTimes[i];
+		sum += frameTime;
+		if (frameTime < minTime) minTime = frameTime;
+		if (frameTime > maxTime) maxTime = frameTime;
+	}
+
+	double avg = sum / static_cast<double>(numFrameTimes);
+	double variance = 0.0;
+	for (size_t i = 0; i < numFrameTimes; i++)
+	{
+		double diff = frameTimes[i] - avg;
+		variance += diff * diff;
+	}
+	variance /= static_cast<double>(numFrameTimes);
+
+	stats.avgFrameTime = static_cast<float>(avg * 1000.0);
+	stats.minFrameTime = static_cast<float>(minTime * 1000.0);
+	stats.maxFrameTime = static_cast<float>(maxTime * 1000.0);
+	stats.variance = static_cast<float>(variance * 1000000.0);
+	stats.stdDeviation = static_cast<float>(std::sqrt(variance) * 1000.0);
+	stats.numFrames = static_cast<unsigned int>(numFrameTimes);
+
+	return stats;
+}
+
+void LcFramePacer::AddFrameTime(double frameSeconds)
+{
+	frameTimes[nextFrameTime] = frameSeconds;
+	nextFrameTime = (nextFrameTime + 1) % frameTimes.size();
+	if (numFrameTimes < frameTimes.size()) numFrameTimes++;
+}
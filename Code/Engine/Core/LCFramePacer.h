@@ -0,0 +1,109 @@
+/**
+* LCFramePacer.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Module.h"
+
+#include <chrono>
+#include <vector>
+
+#pragma warning(disable : 4251)
+
+
+/** Default time before deadline spent in spin-wait instead of sleep, in seconds */
+constexpr double LcDefaultSpinTime = 0.002;
+
+/** Default number of frames used for frame time stats */
+constexpr size_t LcDefaultFrameStatsWindow = 120;
+
+
+/** Frame time stats in milliseconds over last frames */
+struct LcFrameStats
+{
+	float avgFrameTime;
+	//
+	float minFrameTime;
+	//
+	float maxFrameTime;
+	// variance in squared milliseconds
+	float variance;
+	//
+	float stdDeviation;
+	//
+	unsigned int numFrames;
+};
+
+
+/**
+* Frame pacer. Waits for the next frame deadline with coarse sleep followed
+* by spin-wait, so frames start on time without wasting whole sleep quantum.
+* Deadlines advance by fixed period, late frames restart pacing from now
+* instead of rushing to catch up. Without frame limit it sleeps for 1 ms per frame
+* unless idle sleep is disabled, so the loop does not take the whole core. Also collects frame time stats.
+* Sleep precision depends on OS timer resolution, on Windows set it with timeBeginPeriod().
+*/
+class CORE_API LcFramePacer
+{
+public:
+	typedef std::chrono::steady_clock TClock;
+
+
+public:
+	/**
+	* Constructor. targetFPS = 0 - no frame limit */
+	LcFramePacer(unsigned int targetFPS = 0, double spinTime = LcDefaultSpinTime);
+	/**
+	* Set target frames per second, 0 - no frame limit */
+	void SetTargetFPS(unsigned int targetFPS);
+	/**
+	* Set time before deadline spent in spin-wait, in seconds */
+	void SetSpinTime(double inSpinTime) { spinTime = (inSpinTime > 0.0) ? inSpinTime : 0.0; }
+	/**
+	* Sleep for 1 ms per frame when there is no frame limit. Enabled by default */
+	void SetIdleSleep(bool inIdleSleep) { idleSleep = inIdleSleep; }
+	/**
+	* Set number of frames used for stats */
+	void SetStatsWindow(size_t numFrames);
+	/**
+	* Restart pacing and clear stats */
+	void Reset();
+	/**
+	* Wait for the next frame deadline and record frame time. Call once per frame */
+	void Wait();
+	//
+	inline unsigned int GetTargetFPS() const { return targetFPS; }
+	//
+	inline bool GetIdleSleep() const { return idleSleep; }
+	/**
+	* Get frame time stats over last frames */
+	LcFrameStats GetStats() const;
+
+
+protected:
+	void AddFrameTime(double frameSeconds);
+
+
+protected:
+	TClock::time_point deadline;
+	//
+	TClock::time_point prevFrameTime;
+	//
+	TClock::duration period;
+	//
+	double spinTime;
+	//
+	unsigned int targetFPS;
+	// ring buffer of frame times in seconds
+	std::vector<double> frameTimes;
+	//
+	size_t nextFrameTime;
+	//
+	size_t numFrameTimes;
+	//
+	bool idleSleep;
+
+};
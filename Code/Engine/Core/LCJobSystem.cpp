@@ -0,0 +1,229 @@
+/**
+* LCJobSystem.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "Core/LCJobSystem.h"
+
+
+// job system and worker index of the current thread
+static thread_local const LcJobSystem* currentSystem = nullptr;
+static thread_local unsigned int currentWorker = 0;
+
+
+LcJobSystem::LcJobSystem(unsigned int numWorkers)
+	: numQueued(0)
+	, stopping(false)
+	, startTime(std::chrono::steady_clock::now())
+{
+	if (numWorkers == 0)
+	{
+		unsigned int numThreads = std::thread::hardware_concurrency();
+		numWorkers = (numThreads > 1) ? numThreads - 1 : 1;
+	}
+
+	for (unsigned int i = 0; i <= numWorkers; i++)
+	{
+		queues.push_back(std::make_unique<LcJobQueue>());
+	}
+
+	for (unsigned int i = 1; i <= numWorkers; i++)
+	{
+		workers.emplace_back(&LcJobSystem::WorkerLoop, this, i);
+	}
+}
+
+LcJobSystem::~LcJobSystem()
+{
+	// queued jobs are not run
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+
+	wakeCondition.notify_all();
+
+	for (auto& worker : workers)
+	{
+		if (worker.joinable()) worker.join();
+	}
+}
+
+void LcJobSystem::Run(TJobFunc job, LcJobCounter* counter, const char* name)
+{
+	if (!job) throw std::exception("LcJobSystem::Run(): Invalid job");
+
+	if (counter) counter->value.fetch_add(1, std::memory_order_relaxed);
+
+	unsigned int queueIndex = (currentSystem == this) ? currentWorker : 0;
+	{
+		auto& queue = *queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(LcJob{ std::move(job), counter, name });
+	}
+
+	numQueued.fetch_add(1, std::memory_order_release);
+
+	// sync with sleeping workers, so wake up is not lost
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+
+	wakeCondition.notify_one();
+}
+
+void LcJobSystem::Wait(LcJobCounter& counter)
+{
+	unsigned int workerIndex = (currentSystem == this) ? currentWorker : 0;
+
+	while (!counter.IsDone())
+	{
+		if (!TryRunJob(workerIndex)) std::this_thread::yield();
+	}
+
+	std::exception_ptr error;
+	{
+		std::lock_guard<std::mutex> lock(counter.errorMutex);
+		std::swap(error, counter.error);
+	}
+
+	if (error) std::rethrow_exception(error);
+}
+
+void LcJobSystem::ParallelFor(size_t begin, size_t end, size_t grainSize, const TJobRangeFunc& func, const char* name)
+{
+	if (end <= begin) return;
+
+	size_t count = end - begin;
+	if (grainSize == 0)
+	{
+		// few parts per thread to balance uneven work
+		size_t numParts = (workers.size() + 1) * 4;
+		grainSize = (count + numParts - 1) / numParts;
+	}
+
+	if (count <= grainSize)
+	{
+		func(begin, end);
+		return;
+	}
+
+	LcJobCounter counter;
+	for (size_t partBegin = begin + grainSize; partBegin < end; partBegin += grainSize)
+	{
+		size_t partEnd = (end - partBegin > grainSize) ? partBegin + grainSize : end;
+		Run([&func, partBegin, partEnd]() { func(partBegin, partEnd); }, &counter, name);
+	}
+
+	// first part on this thread, other parts use counter and func, so wait for them anyway
+	std::exception_ptr error;
+	try
+	{
+		func(begin, begin + grainSize);
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+
+	Wait(counter);
+
+	if (error) std::rethrow_exception(error);
+}
+
+unsigned int LcJobSystem::GetWorkerIndex()
+{
+	return currentWorker;
+}
+
+void LcJobSystem::WorkerLoop(unsigned int workerIndex)
+{
+	currentSystem = this;
+	currentWorker = workerIndex;
+
+	while (!stopping)
+	{
+		if (TryRunJob(workerIndex)) continue;
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeCondition.wait(lock, [this]() {
+			return numQueued.load(std::memory_order_acquire) > 0 || stopping;
+		});
+	}
+}
+
+bool LcJobSystem::TryRunJob(unsigned int workerIndex)
+{
+	LcJob job;
+	bool found = PopJob(workerIndex, false, job);
+
+	// steal from other queues
+	size_t numQueues = queues.size();
+	for (size_t i = 1; !found && i < numQueues; i++)
+	{
+		found = PopJob((unsigned int)((workerIndex + i) % numQueues), true, job);
+	}
+
+	if (found) Execute(job, workerIndex);
+
+	return found;
+}
+
+bool LcJobSystem::PopJob(unsigned int queueIndex, bool steal, LcJob& outJob)
+{
+	if (numQueued.load(std::memory_order_acquire) <= 0) return false;
+
+	auto& queue = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.jobs.empty()) return false;
+
+	if (steal)
+	{
+		outJob = std::move(queue.jobs.front());
+		queue.jobs.pop_front();
+	}
+	else
+	{
+		outJob = std::move(queue.jobs.back());
+		queue.jobs.pop_back();
+	}
+
+	numQueued.fetch_sub(1, std::memory_order_relaxed);
+	return true;
+}
+
+void LcJobSystem::Execute(LcJob& job, unsigned int workerIndex)
+{
+	bool timed = (bool)timingHandler;
+	auto jobStart = timed ? std::chrono::steady_clock::now() : startTime;
+
+	try
+	{
+		job.func();
+	}
+	catch (...)
+	{
+		// exceptions of jobs without counter are ignored
+		if (job.counter)
+		{
+			std::lock_guard<std::mutex> lock(job.counter->errorMutex);
+			if (!job.counter->error) job.counter->error = std::current_exception();
+		}
+	}
+
+	if (timed)
+	{
+		auto jobEnd = std::chrono::steady_clock::now();
+		timingHandler(LcJobTiming{
+			job.name,
+			workerIndex,
+			std::chrono::duration<double, std::milli>(jobStart - startTime).count(),
+			std::chrono::duration<float, std::milli>(jobEnd - jobStart).count()
+		});
+	}
+
+	// counter could be destroyed by waiting thread right after it is done
+	if (job.counter) job.counter->value.fetch_sub(1, std::memory_order_acq_rel);
+}
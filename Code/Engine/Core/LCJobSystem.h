@@ -0,0 +1,159 @@
+/**
+* LCJobSystem.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Module.h"
+
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#pragma warning(disable : 4251)
+
+
+/** Job function */
+typedef std::function<void()> TJobFunc;
+
+/** Range job function, called for [begin, end) part of the range */
+typedef std::function<void(size_t begin, size_t end)> TJobRangeFunc;
+
+
+/**
+* Job counter. Increased for each job started with it, decreased when job is done.
+* Jobs depending on other jobs wait for their counter, see LcJobSystem::Wait().
+*/
+class CORE_API LcJobCounter
+{
+public:
+	LcJobCounter() : value(0) {}
+	//
+	LcJobCounter(const LcJobCounter&) = delete;
+	//
+	LcJobCounter& operator=(const LcJobCounter&) = delete;
+	//
+	inline bool IsDone() const { return value.load(std::memory_order_acquire) == 0; }
+
+
+protected:
+	friend class LcJobSystem;
+	//
+	std::atomic<int> value;
+	// first exception thrown by the jobs, rethrown by Wait()
+	std::exception_ptr error;
+	//
+	std::mutex errorMutex;
+
+};
+
+
+/** Job timing, reported to timing handler */
+struct LcJobTiming
+{
+	// job name, could be nullptr
+	const char* name;
+	// worker index, 0 - external thread
+	unsigned int worker;
+	// start time from job system creation in milliseconds
+	double startTime;
+	// duration in milliseconds
+	float duration;
+};
+
+/** Job timing handler. Called from worker threads */
+typedef std::function<void(const LcJobTiming&)> TJobTimingHandler;
+
+
+/**
+* Job system. Worker threads take newest jobs from their own queues and steal
+* oldest jobs from other queues when idle. Jobs added from external threads go to
+* the shared queue 0. Waiting thread runs queued jobs instead of blocking,
+* so jobs could wait for other jobs and ParallelFor() could be nested.
+*/
+class CORE_API LcJobSystem
+{
+public:
+	/**
+	* Constructor. numWorkers = 0 uses number of hardware threads - 1 */
+	LcJobSystem(unsigned int numWorkers = 0);
+	//
+	~LcJobSystem();
+	//
+	LcJobSystem(const LcJobSystem&) = delete;
+	//
+	LcJobSystem& operator=(const LcJobSystem&) = delete;
+	/**
+	* Add job. Counter is increased now and decreased after the job is done */
+	void Run(TJobFunc job, LcJobCounter* counter = nullptr, const char* name = nullptr);
+	/**
+	* Wait for counter jobs, running other jobs meanwhile. Rethrows job exception */
+	void Wait(LcJobCounter& counter);
+	/**
+	* Split [begin, end) to parts of grainSize and run them in parallel, then wait.
+	* grainSize = 0 selects part size from number of workers */
+	void ParallelFor(size_t begin, size_t end, size_t grainSize, const TJobRangeFunc& func, const char* name = nullptr);
+	/**
+	* Set timing handler, nullptr to disable. Set it when there are no running jobs */
+	void SetTimingHandler(TJobTimingHandler handler) { timingHandler = handler; }
+	//
+	inline unsigned int GetNumWorkers() const { return (unsigned int)workers.size(); }
+	/**
+	* Get worker index of the current thread, 0 for external threads */
+	static unsigned int GetWorkerIndex();
+
+
+protected:
+	struct LcJob
+	{
+		TJobFunc func;
+		//
+		LcJobCounter* counter;
+		//
+		const char* name;
+	};
+	//
+	struct LcJobQueue
+	{
+		std::deque<LcJob> jobs;
+		//
+		std::mutex mutex;
+	};
+	//
+	void WorkerLoop(unsigned int workerIndex);
+	//
+	bool TryRunJob(unsigned int workerIndex);
+	//
+	bool PopJob(unsigned int queueIndex, bool steal, LcJob& outJob);
+	//
+	void Execute(LcJob& job, unsigned int workerIndex);
+
+
+protected:
+	// queue 0 is shared by external threads, queue N belongs to worker N
+	std::vector<std::unique_ptr<LcJobQueue>> queues;
+	//
+	std::vector<std::thread> workers;
+	//
+	std::atomic<int> numQueued;
+	//
+	std::mutex sleepMutex;
+	//
+	std::condition_variable wakeCondition;
+	//
+	std::atomic<bool> stopping;
+	//
+	TJobTimingHandler timingHandler;
+	//
+	std::chrono::steady_clock::time_point startTime;
+
+};
@@ -0,0 +1,142 @@
+/**
+* LCPoolAllocator.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+
+/**
+* Fixed size blocks pool. Blocks are allocated in chunks and reused through free list.
+* Memory is returned to the system only at exit. Thread safe, free list is locked,
+* so visuals and components could be released on job workers and render thread.
+*/
+template<size_t BlockSize, size_t BlockAlign>
+class LcFixedPool
+{
+public:
+	static constexpr size_t BlocksPerChunk = 64;
+	//
+	static constexpr size_t Align = (BlockAlign > alignof(void*)) ? BlockAlign : alignof(void*);
+	//
+	static constexpr size_t Stride = ((((BlockSize > sizeof(void*)) ? BlockSize : sizeof(void*)) + Align - 1) / Align) * Align;
+
+
+public:
+	/** Pool instance. Never destroyed, objects could be released after static destructors */
+	static LcFixedPool& Get()
+	{
+		static LcFixedPool* pool = new LcFixedPool();
+		return *pool;
+	}
+	//
+	void* Allocate()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!freeList) AddChunk();
+
+		FreeBlock* block = freeList;
+		freeList = block->next;
+		return block;
+	}
+	//
+	void Deallocate(void* ptr)
+	{
+		if (!ptr) return;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		Push(ptr);
+	}
+
+
+protected:
+	struct FreeBlock { FreeBlock* next; };
+	//
+	LcFixedPool() : freeList(nullptr) {}
+	// add block to free list, called under lock
+	inline void Push(void* ptr)
+	{
+		FreeBlock* block = static_cast<FreeBlock*>(ptr);
+		block->next = freeList;
+		freeList = block;
+	}
+	// called under lock
+	void AddChunk()
+	{
+		char* chunk = static_cast<char*>(::operator new(Stride * BlocksPerChunk, std::align_val_t(Align)));
+		chunks.push_back(chunk);
+
+		for (size_t i = BlocksPerChunk; i > 0; i--)
+		{
+			Push(chunk + (i - 1) * Stride);
+		}
+	}
+
+
+protected:
+	FreeBlock* freeList;
+	//
+	std::vector<char*> chunks;
+	//
+	std::mutex mutex;
+
+};
+
+
+/**
+* Standard allocator over fixed size pool. Used with std::allocate_shared,
+* so object and its control block take one pool block.
+*/
+template<class T>
+class LcPoolAllocator
+{
+public:
+	typedef T value_type;
+
+
+public:
+	LcPoolAllocator() noexcept {}
+	//
+	template<class U>
+	LcPoolAllocator(const LcPoolAllocator<U>&) noexcept {}
+	//
+	T* allocate(size_t n)
+	{
+		if (n != 1) return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+
+		return static_cast<T*>(LcFixedPool<sizeof(T), alignof(T)>::Get().Allocate());
+	}
+	//
+	void deallocate(T* ptr, size_t n) noexcept
+	{
+		if (n != 1)
+		{
+			::operator delete(ptr, std::align_val_t(alignof(T)));
+			return;
+		}
+
+		LcFixedPool<sizeof(T), alignof(T)>::Get().Deallocate(ptr);
+	}
+	//
+	template<class U>
+	bool operator==(const LcPoolAllocator<U>&) const noexcept { return true; }
+	//
+	template<class U>
+	bool operator!=(const LcPoolAllocator<U>&) const noexcept { return false; }
+
+};
+
+
+/** Make shared object in pool */
+template<class T, class... Args>
+std::shared_ptr<T> LcMakePooled(Args&&... args)
+{
+	return std::allocate_shared<T>(LcPoolAllocator<T>(), std::forward<Args>(args)...);
+}
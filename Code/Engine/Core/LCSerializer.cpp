@@ -0,0 +1,164 @@
+/**
+* LCSerializer.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "Core/LCSerializer.h"
+
+
+inline uint64_t AlignOffset(uint64_t offset) { return (offset + LcArchiveAlignment - 1) & ~(uint64_t)(LcArchiveAlignment - 1); }
+
+
+void LcBlobWriter::WriteString(const std::string& value)
+{
+	Write<uint32_t>((uint32_t)value.size());
+	WriteBytes(value.data(), value.size());
+}
+
+void LcBlobWriter::WriteString(const std::wstring& value)
+{
+	// UTF-16 on Windows, stored as 16-bit units
+	Write<uint32_t>((uint32_t)value.size());
+	for (auto symbol : value) Write<uint16_t>((uint16_t)symbol);
+}
+
+void LcBlobWriter::WriteBytes(const void* bytes, size_t numBytes)
+{
+	if (numBytes == 0) return;
+
+	size_t offset = data.size();
+	data.resize(offset + numBytes);
+	memcpy(&data[offset], bytes, numBytes);
+}
+
+
+std::string LcBlobReader::ReadString()
+{
+	uint32_t length = Read<uint32_t>();
+	if (length > GetNumLeft()) throw std::exception("LcBlobReader::ReadString(): Invalid string size");
+
+	std::string value(reinterpret_cast<const char*>(data + pos), length);
+	pos += length;
+	return value;
+}
+
+std::wstring LcBlobReader::ReadWString()
+{
+	uint32_t length = Read<uint32_t>();
+	if (length > GetNumLeft() / sizeof(uint16_t)) throw std::exception("LcBlobReader::ReadWString(): Invalid string size");
+
+	std::wstring value(length, L'\0');
+	for (auto& symbol : value) symbol = (wchar_t)Read<uint16_t>();
+	return value;
+}
+
+void LcBlobReader::ReadBytes(void* outBytes, size_t numBytes)
+{
+	if (numBytes > GetNumLeft()) throw std::exception("LcBlobReader::ReadBytes(): Out of data");
+	if (numBytes == 0) return;
+
+	memcpy(outBytes, data + pos, numBytes);
+	pos += numBytes;
+}
+
+LcBlobReader LcBlobReader::GetRange(uint64_t offset, uint64_t numBytes) const
+{
+	if (offset > size || numBytes > size - offset) throw std::exception("LcBlobReader::GetRange(): Invalid range");
+
+	return LcBlobReader(data + offset, (size_t)numBytes);
+}
+
+
+void LcArchiveWriter::AddSection(uint32_t id, uint32_t version, const void* data, size_t size, size_t count)
+{
+	for (auto& section : sections)
+	{
+		if (section.id == id) throw std::exception("LcArchiveWriter::AddSection(): Section already exists");
+	}
+
+	LcSectionData section{ id, version, count, LcBytes() };
+	if (size > 0)
+	{
+		auto bytes = static_cast<const unsigned char*>(data);
+		section.data.assign(bytes, bytes + size);
+	}
+
+	sections.push_back(std::move(section));
+}
+
+void LcArchiveWriter::Finish(LcBytes& outData) const
+{
+	uint64_t offset = AlignOffset(sizeof(LcArchiveHeader) + sizeof(LcArchiveSection) * sections.size());
+
+	std::vector<LcArchiveSection> table;
+	table.reserve(sections.size());
+	for (auto& section : sections)
+	{
+		table.push_back(LcArchiveSection{ section.id, section.version, section.count, offset, section.data.size() });
+		offset = AlignOffset(offset + section.data.size());
+	}
+
+	LcArchiveHeader header{ LcArchiveMagic, LcArchiveVersion, (uint32_t)sections.size(), 0, offset };
+
+	outData.assign((size_t)offset, 0);
+	memcpy(outData.data(), &header, sizeof(header));
+	if (!table.empty()) memcpy(outData.data() + sizeof(header), table.data(), sizeof(LcArchiveSection) * table.size());
+
+	for (size_t i = 0; i < sections.size(); i++)
+	{
+		if (!sections[i].data.empty()) memcpy(outData.data() + table[i].offset, sections[i].data.data(), sections[i].data.size());
+	}
+}
+
+
+LcArchiveReader::LcArchiveReader(const void* data, size_t size)
+	: base(static_cast<const unsigned char*>(data))
+	, header(nullptr)
+	, sections(nullptr)
+{
+	if (!data || size < sizeof(LcArchiveHeader)) throw std::exception("LcArchiveReader::LcArchiveReader(): Invalid archive");
+	if (reinterpret_cast<uintptr_t>(data) % alignof(LcArchiveSection) != 0) throw std::exception("LcArchiveReader::LcArchiveReader(): Unaligned archive");
+
+	header = reinterpret_cast<const LcArchiveHeader*>(base);
+	if (header->magic != LcArchiveMagic) throw std::exception("LcArchiveReader::LcArchiveReader(): Invalid archive signature");
+	if (header->version > LcArchiveVersion) throw std::exception("LcArchiveReader::LcArchiveReader(): Unsupported archive version");
+	if (header->size > size) throw std::exception("LcArchiveReader::LcArchiveReader(): Archive is truncated");
+
+	uint64_t tableEnd = sizeof(LcArchiveHeader) + sizeof(LcArchiveSection) * (uint64_t)header->numSections;
+	if (tableEnd > header->size) throw std::exception("LcArchiveReader::LcArchiveReader(): Invalid section table");
+
+	sections = reinterpret_cast<const LcArchiveSection*>(base + sizeof(LcArchiveHeader));
+	for (uint32_t i = 0; i < header->numSections; i++)
+	{
+		auto& section = sections[i];
+		if (section.offset < tableEnd || section.offset > header->size || section.size > header->size - section.offset)
+		{
+			throw std::exception("LcArchiveReader::LcArchiveReader(): Invalid section");
+		}
+	}
+}
+
+const LcArchiveSection* LcArchiveReader::FindSection(uint32_t id, uint32_t maxVersion) const
+{
+	for (uint32_t i = 0; i < header->numSections; i++)
+	{
+		if (sections[i].id == id)
+		{
+			if (sections[i].version > maxVersion) throw std::exception("LcArchiveReader::FindSection(): Unsupported section version");
+
+			return &sections[i];
+		}
+	}
+
+	return nullptr;
+}
+
+LcBlobReader LcArchiveReader::GetBlob(uint32_t id, uint32_t maxVersion) const
+{
+	auto section = FindSection(id, maxVersion);
+	if (!section) return LcBlobReader(nullptr, 0);
+
+	return LcBlobReader(base + section->offset, (size_t)section->size);
+}
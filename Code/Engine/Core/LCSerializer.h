@@ -0,0 +1,216 @@
+/**
+* LCSerializer.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Module.h"
+#include "Core/LCTypes.h"
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+#pragma warning(disable : 4251)
+
+
+/** Archive file signature: "LCAR" */
+constexpr uint32_t LcArchiveMagic = 0x5241434C;
+
+/** Archive container version */
+constexpr uint32_t LcArchiveVersion = 1;
+
+/** Archive sections are aligned, so arrays could be used in place */
+constexpr uint32_t LcArchiveAlignment = 16;
+
+
+/** Archive header */
+struct LcArchiveHeader
+{
+	uint32_t magic;
+	//
+	uint32_t version;
+	//
+	uint32_t numSections;
+	//
+	uint32_t reserved;
+	// total archive size in bytes
+	uint64_t size;
+};
+
+/** Archive section table entry, follows header */
+struct LcArchiveSection
+{
+	uint32_t id;
+	// section data version, checked by section reader
+	uint32_t version;
+	// number of items in section
+	uint64_t count;
+	// offset from archive start
+	uint64_t offset;
+	//
+	uint64_t size;
+};
+
+
+/**
+* Blob writer. Writes POD values, strings and arrays to byte buffer */
+class CORE_API LcBlobWriter
+{
+public:
+	//
+	template<class T> void Write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "LcBlobWriter::Write(): T must be trivially copyable");
+		WriteBytes(&value, sizeof(T));
+	}
+	//
+	template<class T> void WriteArray(const T* items, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "LcBlobWriter::WriteArray(): T must be trivially copyable");
+		Write<uint32_t>((uint32_t)count);
+		WriteBytes(items, sizeof(T) * count);
+	}
+	//
+	void WriteString(const std::string& value);
+	//
+	void WriteString(const std::wstring& value);
+	//
+	void WriteBytes(const void* bytes, size_t size);
+	//
+	inline const LcBytes& GetData() const { return data; }
+	//
+	inline LcBytes& GetData() { return data; }
+
+
+protected:
+	LcBytes data;
+
+};
+
+
+/**
+* Blob reader. Reads data written by LcBlobWriter, throws on out of range read */
+class CORE_API LcBlobReader
+{
+public:
+	LcBlobReader(const void* inData, size_t inSize) : data(static_cast<const unsigned char*>(inData)), size(inSize), pos(0) {}
+	//
+	template<class T> T Read()
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "LcBlobReader::Read(): T must be trivially copyable");
+		T value;
+		ReadBytes(&value, sizeof(T));
+		return value;
+	}
+	//
+	template<class T> void ReadArray(std::vector<T>& outItems)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "LcBlobReader::ReadArray(): T must be trivially copyable");
+		uint32_t count = Read<uint32_t>();
+		if (count > (size - pos) / sizeof(T)) throw std::exception("LcBlobReader::ReadArray(): Invalid array size");
+		outItems.resize(count);
+		ReadBytes(outItems.data(), sizeof(T) * count);
+	}
+	//
+	std::string ReadString();
+	//
+	std::wstring ReadWString();
+	//
+	void ReadBytes(void* outBytes, size_t numBytes);
+	/**
+	* Get reader of data range from blob start, throws on invalid range */
+	LcBlobReader GetRange(uint64_t offset, uint64_t numBytes) const;
+	//
+	inline size_t GetNumLeft() const { return size - pos; }
+
+
+protected:
+	const unsigned char* data;
+	//
+	size_t size;
+	//
+	size_t pos;
+
+};
+
+
+/**
+* Archive writer. Collects sections and lays them out after header and section table */
+class CORE_API LcArchiveWriter
+{
+public:
+	/**
+	* Add section of items */
+	template<class T> void AddSection(uint32_t id, uint32_t version, const std::vector<T>& items)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "LcArchiveWriter::AddSection(): T must be trivially copyable");
+		AddSection(id, version, items.data(), items.size() * sizeof(T), items.size());
+	}
+	/**
+	* Add section of raw data */
+	void AddSection(uint32_t id, uint32_t version, const void* data, size_t size, size_t count);
+	/**
+	* Build archive */
+	void Finish(LcBytes& outData) const;
+
+
+protected:
+	struct LcSectionData
+	{
+		uint32_t id;
+		//
+		uint32_t version;
+		//
+		uint64_t count;
+		//
+		LcBytes data;
+	};
+	//
+	std::vector<LcSectionData> sections;
+
+};
+
+
+/**
+* Archive reader. Validates archive loaded with one read or mapped to memory and resolves
+* section offsets to pointers. Data must stay valid while reader is used.
+*/
+class CORE_API LcArchiveReader
+{
+public:
+	/**
+	* Validate header and section table, throws on invalid archive */
+	LcArchiveReader(const void* data, size_t size);
+	/**
+	* Get section, nullptr if there is no section. Throws on unsupported version */
+	const LcArchiveSection* FindSection(uint32_t id, uint32_t maxVersion) const;
+	/**
+	* Get section items, nullptr if there is no section */
+	template<class T> const T* GetItems(uint32_t id, uint32_t maxVersion, size_t& outCount) const
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "LcArchiveReader::GetItems(): T must be trivially copyable");
+		outCount = 0;
+		auto section = FindSection(id, maxVersion);
+		if (!section) return nullptr;
+		if (section->size != section->count * sizeof(T)) throw std::exception("LcArchiveReader::GetItems(): Invalid section size");
+		outCount = (size_t)section->count;
+		return reinterpret_cast<const T*>(base + section->offset);
+	}
+	/**
+	* Get section blob reader */
+	LcBlobReader GetBlob(uint32_t id, uint32_t maxVersion) const;
+
+
+protected:
+	const unsigned char* base;
+	//
+	const LcArchiveHeader* header;
+	//
+	const LcArchiveSection* sections;
+
+};
@@ -0,0 +1,245 @@
+/**
+* LCSlotMap.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Core/LCTypes.h"
+
+#include <memory>
+#include <vector>
+#include <exception>
+
+
+/**
+* Generational handle table. Handle: 20 bits slot index, 12 bits generation.
+* Removed slots are reused through free list, generation is increased on every removal,
+* so stale handles are detected instead of resolving to a new object.
+*/
+template<class T>
+class LcHandleTable
+{
+public:
+	static constexpr unsigned int IndexBits = 20;
+	//
+	static constexpr unsigned int IndexMask = (1u << IndexBits) - 1;
+	//
+	static constexpr unsigned int MaxGeneration = (1u << (32 - IndexBits)) - 1;
+	// end of free list
+	static constexpr unsigned int NoFreeSlot = ~0u;
+	// nextFree of live slots, differs from NoFreeSlot so the last free slot is not taken as live
+	static constexpr unsigned int UsedSlot = ~0u - 1;
+
+
+public:
+	LcHandleTable() : freeHead(NoFreeSlot), numValues(0) {}
+	/**
+	* Add value, returns new handle */
+	LcObjectHandle Add(const T& value)
+	{
+		unsigned int index = 0;
+
+		if (freeHead != NoFreeSlot)
+		{
+			index = freeHead;
+			freeHead = slots[index].nextFree;
+		}
+		else
+		{
+			if (slots.size() > IndexMask) throw std::exception("LcHandleTable::Add(): Too many objects");
+
+			index = static_cast<unsigned int>(slots.size());
+			slots.push_back(Slot{ value, 1, UsedSlot });
+		}
+
+		auto& slot = slots[index];
+		slot.value = value;
+		slot.nextFree = UsedSlot;
+		numValues++;
+
+		return (slot.generation << IndexBits) | index;
+	}
+	/**
+	* Remove value. Stale handles are ignored */
+	void Remove(LcObjectHandle handle)
+	{
+		if (!IsValid(handle)) return;
+
+		unsigned int index = ToIndex(handle);
+		auto& slot = slots[index];
+		slot.value = T();
+		slot.generation = (slot.generation >= MaxGeneration) ? 1 : slot.generation + 1;
+		slot.nextFree = freeHead;
+		freeHead = index;
+		numValues--;
+	}
+	/**
+	* Check handle is alive */
+	inline bool IsValid(LcObjectHandle handle) const
+	{
+		unsigned int index = ToIndex(handle);
+		return handle != LcInvalidHandle && index < slots.size() &&
+			slots[index].nextFree == UsedSlot && slots[index].generation == ToGeneration(handle);
+	}
+	/**
+	* Get value. Returns nullptr for stale handles */
+	inline T* Get(LcObjectHandle handle) { return IsValid(handle) ? &slots[ToIndex(handle)].value : nullptr; }
+	/**
+	* Get value. Returns nullptr for stale handles */
+	inline const T* Get(LcObjectHandle handle) const { return IsValid(handle) ? &slots[ToIndex(handle)].value : nullptr; }
+	/**
+	* Remove all values. All handles become stale */
+	void Clear()
+	{
+		for (unsigned int index = 0; index < static_cast<unsigned int>(slots.size()); index++)
+		{
+			if (slots[index].nextFree != UsedSlot) continue;
+
+			Remove((slots[index].generation << IndexBits) | index);
+		}
+	}
+	/**
+	* Reserve slots for numReserved values in total */
+	inline void Reserve(size_t numReserved) { slots.reserve(numReserved); }
+	//
+	inline size_t Size() const { return numValues; }
+	//
+	static inline unsigned int ToIndex(LcObjectHandle handle) { return handle & IndexMask; }
+	//
+	static inline unsigned int ToGeneration(LcObjectHandle handle) { return handle >> IndexBits; }
+
+
+protected:
+	struct Slot
+	{
+		T value;
+		//
+		unsigned int generation;
+		// UsedSlot for live slots
+		unsigned int nextFree;
+	};
+	//
+	std::vector<Slot> slots;
+	//
+	unsigned int freeHead;
+	//
+	size_t numValues;
+
+};
+
+
+/**
+* Slot map container for LcCreator. Items are stored contiguously,
+* each item gets a generational handle. Find and erase are O(1).
+*/
+template<class I>
+class LcSlotMap
+{
+public:
+	typedef std::shared_ptr<I> value_type;
+	//
+	typedef std::vector<value_type> TDenseList;
+	//
+	typedef typename TDenseList::iterator iterator;
+	//
+	typedef typename TDenseList::const_iterator const_iterator;
+
+
+public:
+	LcSlotMap() {}
+	//
+	LcSlotMap(const LcSlotMap&) = delete;
+	//
+	LcSlotMap& operator=(const LcSlotMap&) = delete;
+	//
+	~LcSlotMap() { clear(); }
+	//
+	inline iterator begin() { return items.begin(); }
+	//
+	inline iterator end() { return items.end(); }
+	//
+	inline const_iterator begin() const { return items.begin(); }
+	//
+	inline const_iterator end() const { return items.end(); }
+	//
+	inline size_t size() const { return items.size(); }
+	//
+	inline bool empty() const { return items.empty(); }
+	//
+	inline const value_type& operator[](size_t index) const { return items[index]; }
+	//
+	inline value_type& operator[](size_t index) { return items[index]; }
+	/**
+	* Add item to the end. Hint is ignored */
+	iterator insert(const_iterator hint, const value_type& item)
+	{
+		if (!item) return end();
+
+		item->SetHandle(handles.Add(static_cast<unsigned int>(items.size())));
+		items.push_back(item);
+		return items.end() - 1;
+	}
+	/**
+	* Remove item in O(1). Last item is moved to its position */
+	iterator erase(const_iterator it)
+	{
+		size_t index = it - items.begin();
+		if (index >= items.size()) return end();
+
+		handles.Remove(items[index]->GetHandle());
+		items[index]->SetHandle(LcInvalidHandle);
+
+		if (index + 1 != items.size())
+		{
+			items[index] = std::move(items.back());
+			*handles.Get(items[index]->GetHandle()) = static_cast<unsigned int>(index);
+		}
+
+		items.pop_back();
+		return items.begin() + index;
+	}
+	/**
+	* Find item in O(1) */
+	iterator find(const I* item)
+	{
+		auto index = item ? handles.Get(item->GetHandle()) : nullptr;
+		if (!index || items[*index].get() != item) return end();
+
+		return items.begin() + *index;
+	}
+	/**
+	* Get item by handle. Returns nullptr for stale handles */
+	I* Get(LcObjectHandle handle) const
+	{
+		auto index = handles.Get(handle);
+		return index ? items[*index].get() : nullptr;
+	}
+	//
+	void clear()
+	{
+		for (auto& item : items)
+		{
+			item->SetHandle(LcInvalidHandle);
+		}
+
+		handles.Clear();
+		items.clear();
+	}
+
+
+protected:
+	TDenseList items;
+	// dense index of each handle
+	LcHandleTable<unsigned int> handles;
+
+};
+
+
+/** Find item in slot map. Used by LcCreator::Remove() */
+template<class I>
+typename LcSlotMap<I>::iterator LcFindItem(LcSlotMap<I>& items, const I* item)
+{
+	return items.find(item);
+}
@@ -0,0 +1,120 @@
+/**
+* LCTagIndex.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Core/LCTypes.h"
+
+#include <unordered_map>
+#include <vector>
+
+
+/**
+* Object tag index. Objects added to index report tag changes from IObjectBase::SetTag().
+* Untagged objects (tag -1) are not stored.
+*/
+template<class T>
+class LcTagIndex : public IObjectTagIndex
+{
+public:
+	typedef std::unordered_multimap<ObjectTag, T*> TTagMap;
+
+
+public:
+	LcTagIndex() {}
+	//
+	LcTagIndex(const LcTagIndex&) = delete;
+	//
+	LcTagIndex& operator=(const LcTagIndex&) = delete;
+	//
+	~LcTagIndex() { Clear(); }
+	/**
+	* Start tracking object tag */
+	void Add(T* object)
+	{
+		if (!object) return;
+
+		object->SetTagIndex(this);
+		if (object->GetTag() != LcNoTag) tags.emplace(object->GetTag(), object);
+	}
+	/**
+	* Stop tracking object tag */
+	void Remove(T* object)
+	{
+		if (!object || object->GetTagIndex() != this) return;
+
+		Erase(object->GetTag(), object);
+		object->SetTagIndex(nullptr);
+	}
+	/**
+	* Remove all objects */
+	void Clear()
+	{
+		for (auto& entry : tags)
+		{
+			entry.second->SetTagIndex(nullptr);
+		}
+
+		tags.clear();
+	}
+	/**
+	* Get any object with tag in O(1) */
+	T* Find(ObjectTag tag) const
+	{
+		auto it = tags.find(tag);
+		return (it != tags.end()) ? it->second : nullptr;
+	}
+	/**
+	* Append all objects with tag to the list. Returns number of found objects */
+	size_t FindAll(ObjectTag tag, std::vector<T*>& outObjects) const
+	{
+		auto range = tags.equal_range(tag);
+		size_t prevSize = outObjects.size();
+
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			outObjects.push_back(it->second);
+		}
+
+		return outObjects.size() - prevSize;
+	}
+	/**
+	* Get number of objects with tag */
+	inline size_t Count(ObjectTag tag) const { return tags.count(tag); }
+
+
+public: // IObjectTagIndex interface implementation
+	//
+	virtual void OnTagChanged(IObjectBase* object, ObjectTag prevTag) override
+	{
+		auto item = static_cast<T*>(object);
+
+		Erase(prevTag, item);
+		if (item->GetTag() != LcNoTag) tags.emplace(item->GetTag(), item);
+	}
+
+
+protected:
+	void Erase(ObjectTag tag, const T* object)
+	{
+		if (tag == LcNoTag) return;
+
+		auto range = tags.equal_range(tag);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second == object)
+			{
+				tags.erase(it);
+				return;
+			}
+		}
+	}
+
+
+protected:
+	TTagMap tags;
+
+};
@@ -0,0 +1,81 @@
+/**
+* LCTime.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "Core/LCTime.h"
+
+
+LcTimeSystem::LcTimeSystem(unsigned int inTickRate, float inMaxFrameTime, unsigned int inMaxTicksPerFrame)
+	: fixedDelta(0.0)
+	, maxFrameTime(0.0)
+	, tickRate(0)
+	, maxTicksPerFrame(inMaxTicksPerFrame)
+{
+	SetTickRate(inTickRate);
+	SetMaxFrameTime(inMaxFrameTime);
+	Reset();
+}
+
+void LcTimeSystem::Reset()
+{
+	prevTime = TClock::now();
+	frameDelta = 0.0;
+	accumulator = 0.0;
+	totalTime = 0.0;
+	numTicks = 0;
+	frameTicks = 0;
+}
+
+float LcTimeSystem::BeginFrame()
+{
+	auto curTime = TClock::now();
+	double delta = std::chrono::duration<double>(curTime - prevTime).count();
+	prevTime = curTime;
+
+	// clamp long frames (debugger, window drag), so simulation does not try to catch up
+	if (delta > maxFrameTime) delta = maxFrameTime;
+	if (delta < 0.0) delta = 0.0;
+
+	frameDelta = delta;
+	totalTime += delta;
+	accumulator += delta;
+	frameTicks = 0;
+
+	return static_cast<float>(frameDelta);
+}
+
+bool LcTimeSystem::StepFixed()
+{
+	if (accumulator < fixedDelta) return false;
+
+	if (maxTicksPerFrame > 0 && frameTicks >= maxTicksPerFrame)
+	{
+		// drop whole ticks, keep fraction for interpolation
+		while (accumulator >= fixedDelta) accumulator -= fixedDelta;
+		return false;
+	}
+
+	accumulator -= fixedDelta;
+	numTicks++;
+	frameTicks++;
+
+	return true;
+}
+
+void LcTimeSystem::SetTickRate(unsigned int inTickRate)
+{
+	if (inTickRate == 0) throw std::exception("LcTimeSystem::SetTickRate(): Invalid tick rate");
+
+	tickRate = inTickRate;
+	fixedDelta = 1.0 / static_cast<double>(tickRate);
+}
+
+void LcTimeSystem::SetMaxFrameTime(float inMaxFrameTime)
+{
+	if (inMaxFrameTime <= 0.0f) throw std::exception("LcTimeSystem::SetMaxFrameTime(): Invalid frame time");
+
+	maxFrameTime = static_cast<double>(inMaxFrameTime);
+}
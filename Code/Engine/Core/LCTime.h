@@ -0,0 +1,114 @@
+/**
+* LCTime.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Module.h"
+
+#include <chrono>
+#include <cstdint>
+
+#pragma warning(disable : 4251)
+
+
+/** Default fixed simulation tick rate */
+constexpr unsigned int LcDefaultTickRate = 60;
+
+/** Default longest frame time in seconds, longer frames are clamped */
+constexpr float LcDefaultMaxFrameTime = 0.25f;
+
+/** Default max number of fixed ticks per frame */
+constexpr unsigned int LcDefaultMaxTicksPerFrame = 8;
+
+
+/**
+* Time system. Measures frame time with high resolution clock and splits it to fixed
+* simulation ticks with accumulator. Frame time is clamped and number of ticks per frame
+* is limited, so slow frames do not lead to spiral of death. Remaining time fraction
+* is used to interpolate simulated state between two last ticks.
+* Usage:
+*   float delta = time.BeginFrame();
+*   while (time.StepFixed()) Simulate(time.GetFixedDelta());
+*   Render(time.GetAlpha());
+*/
+class CORE_API LcTimeSystem
+{
+public:
+	typedef std::chrono::steady_clock TClock;
+
+
+public:
+	/**
+	* Constructor */
+	LcTimeSystem(unsigned int tickRate = LcDefaultTickRate, float maxFrameTime = LcDefaultMaxFrameTime,
+		unsigned int maxTicksPerFrame = LcDefaultMaxTicksPerFrame);
+	/**
+	* Restart clock, reset accumulator and counters */
+	void Reset();
+	/**
+	* Measure frame time and add it to accumulator. Returns clamped frame time in seconds */
+	float BeginFrame();
+	/**
+	* Take one fixed tick from accumulator. Returns false when there is no full tick left */
+	bool StepFixed();
+	/**
+	* Set fixed simulation ticks per second */
+	void SetTickRate(unsigned int tickRate);
+	/**
+	* Set longest frame time in seconds */
+	void SetMaxFrameTime(float maxFrameTime);
+	/**
+	* Set max number of ticks per frame, 0 - no limit. Exceeding time is dropped */
+	void SetMaxTicksPerFrame(unsigned int maxTicks) { maxTicksPerFrame = maxTicks; }
+	//
+	inline unsigned int GetTickRate() const { return tickRate; }
+	//
+	inline unsigned int GetMaxTicksPerFrame() const { return maxTicksPerFrame; }
+	/**
+	* Get fixed tick time in seconds */
+	inline float GetFixedDelta() const { return static_cast<float>(fixedDelta); }
+	/**
+	* Get last frame time in seconds */
+	inline float GetFrameDelta() const { return static_cast<float>(frameDelta); }
+	/**
+	* Get interpolation factor between previous and current tick state [0, 1) */
+	inline float GetAlpha() const { return static_cast<float>(accumulator / fixedDelta); }
+	/**
+	* Get time from reset in seconds */
+	inline double GetTotalTime() const { return totalTime; }
+	/**
+	* Get simulated time in seconds */
+	inline double GetFixedTime() const { return static_cast<double>(numTicks) * fixedDelta; }
+	/**
+	* Get number of fixed ticks from reset */
+	inline uint64_t GetNumTicks() const { return numTicks; }
+	/**
+	* Get number of fixed ticks taken in the current frame */
+	inline unsigned int GetFrameTicks() const { return frameTicks; }
+
+
+protected:
+	TClock::time_point prevTime;
+	//
+	double fixedDelta;
+	//
+	double maxFrameTime;
+	//
+	double frameDelta;
+	//
+	double accumulator;
+	//
+	double totalTime;
+	//
+	uint64_t numTicks;
+	//
+	unsigned int tickRate;
+	//
+	unsigned int maxTicksPerFrame;
+	//
+	unsigned int frameTicks;
+
+};
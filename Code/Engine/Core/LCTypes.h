@@ -34,6 +34,15 @@ constexpr float LcPI = 3.14159265f;
 /** Object tag */
 typedef int ObjectTag;
 
+/** Default object tag */
+constexpr ObjectTag LcNoTag = -1;
+
+/** Generational object handle */
+typedef unsigned int LcObjectHandle;
+
+/** Invalid object handle */
+constexpr LcObjectHandle LcInvalidHandle = 0;
+
 
 /** Object tag interface */
 class IObjectTag
@@ -62,13 +71,33 @@ public:
 	virtual bool IsRooted() const = 0;
 };
 
+/** Object tag index interface. Notified when tag of indexed object changed */
+class IObjectTagIndex
+{
+public:
+	/**
+	* Virtual destructor */
+	virtual ~IObjectTagIndex() {}
+	/**
+	* Object tag changed */
+	virtual void OnTagChanged(class IObjectBase* object, ObjectTag prevTag) = 0;
+};
+
 /** Base object interface */
 class IObjectBase
 	: public IRootObject
 	, public IObjectTag
 {
 public:
-	IObjectBase() : tag(-1), rooted(false) {}
+	IObjectBase() : tag(LcNoTag), rooted(false), tagIndex(nullptr), handle(LcInvalidHandle) {}
+	//
+	inline void SetTagIndex(IObjectTagIndex* inTagIndex) { tagIndex = inTagIndex; }
+	//
+	inline IObjectTagIndex* GetTagIndex() const { return tagIndex; }
+	// set by owner container
+	inline void SetHandle(LcObjectHandle inHandle) { handle = inHandle; }
+	//
+	inline LcObjectHandle GetHandle() const { return handle; }
 
 
 public: // IRootObject interface implementation
@@ -82,7 +111,12 @@ public: // IRootObject interface implementation
 
 public: // IObjectTag interface implementation
 	//
-	virtual void SetTag(ObjectTag inTag) override { tag = inTag; }
+	virtual void SetTag(ObjectTag inTag) override
+	{
+		ObjectTag prevTag = tag;
+		tag = inTag;
+		if (tagIndex && prevTag != inTag) tagIndex->OnTagChanged(this, prevTag);
+	}
 	//
 	virtual ObjectTag GetTag() const override { return tag; }
 
@@ -91,6 +125,10 @@ protected:
 	ObjectTag tag;
 	//
 	bool rooted;
+	//
+	IObjectTagIndex* tagIndex;
+	//
+	LcObjectHandle handle;
 };
 
 /** Any value container */
@@ -140,7 +178,7 @@ struct LcAppContext
 	LcAppContext() : app(nullptr), world(nullptr),
 		render(nullptr), audio(nullptr), scripts(nullptr),
 		input(nullptr), gui(nullptr), physics(nullptr),
-		text(nullptr), windowHandle(nullptr), gameTime(0.0f) {}
+		text(nullptr), jobs(nullptr), time(nullptr), windowHandle(nullptr), gameTime(0.0f) {}
 	//
 	class IApplication* app;
 	//
@@ -160,6 +198,10 @@ struct LcAppContext
 	//
 	class ILocalizationManager* text;
 	//
+	class LcJobSystem* jobs;
+	//
+	class LcTimeSystem* time;
+	//
 	void* windowHandle;
 	//
 	float gameTime;
@@ -27,6 +27,11 @@ namespace LcDefaults
 	extern CORE_API DirectX::XMVECTOR ZeroXVec4;
 }
 
+#else
+
+/** Matrix placeholder, matrices are used by Windows render systems only */
+struct LcMatrix4 { float m[4][4]; };
+
 #endif
 
 typedef struct { int x; int y; } LcPoint, LcSize;
@@ -71,6 +71,37 @@ void WriteTextFile(const char* filePath, const std::string& text)
 	LC_CATCH{ LC_THROW_EX("WriteTextFile('", filePath, "')"); }
 }
 
+void WriteBinaryFile(const char* filePath, const LcBytes& data)
+{
+	using namespace std::filesystem;
+
+	LC_TRY
+
+	path path;
+	path.assign(filePath);
+	std::ofstream stream(path, std::ios::out | std::ios::binary);
+
+	stream.write((const char*)data.data(), data.size());
+	if (!stream) throw std::exception("Cannot write file");
+
+	LC_CATCH{ LC_THROW_EX("WriteBinaryFile('", filePath, "')"); }
+}
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed)
+{
+	auto bytes = static_cast<const unsigned char*>(data);
+	uint64_t hash = seed;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+
+	return hash;
+}
+
+#ifdef _WINDOWS
+
 std::string ToUtf8(const std::wstring& str)
 {
 	int requiredSize = WideCharToMultiByte(CP_UTF8, 0, str.c_str(), (int)str.length(), NULL, 0, NULL, NULL);
@@ -95,6 +126,74 @@ std::wstring FromUtf8(const std::string& str)
 	return wideChars;
 }
 
+#else
+
+std::string ToUtf8(const std::wstring& str)
+{
+	std::string mbChars;
+	mbChars.reserve(str.length());
+
+	for (auto wc : str)
+	{
+		auto code = static_cast<uint32_t>(wc);
+		if (code > 0x10FFFF) throw std::exception("ToUtf8(): Cannot convert");
+
+		if (code < 0x80)
+		{
+			mbChars += (char)code;
+		}
+		else if (code < 0x800)
+		{
+			mbChars += (char)(0xC0 | (code >> 6));
+			mbChars += (char)(0x80 | (code & 0x3F));
+		}
+		else if (code < 0x10000)
+		{
+			mbChars += (char)(0xE0 | (code >> 12));
+			mbChars += (char)(0x80 | ((code >> 6) & 0x3F));
+			mbChars += (char)(0x80 | (code & 0x3F));
+		}
+		else
+		{
+			mbChars += (char)(0xF0 | (code >> 18));
+			mbChars += (char)(0x80 | ((code >> 12) & 0x3F));
+			mbChars += (char)(0x80 | ((code >> 6) & 0x3F));
+			mbChars += (char)(0x80 | (code & 0x3F));
+		}
+	}
+
+	return mbChars;
+}
+
+std::wstring FromUtf8(const std::string& str)
+{
+	std::wstring wideChars;
+	wideChars.reserve(str.length());
+
+	for (size_t i = 0; i < str.length();)
+	{
+		auto lead = static_cast<unsigned char>(str[i]);
+		int numBytes = (lead < 0x80) ? 1 : ((lead >> 5) == 0x6) ? 2 : ((lead >> 4) == 0xE) ? 3 : ((lead >> 3) == 0x1E) ? 4 : 0;
+		if (numBytes == 0 || i + numBytes > str.length()) throw std::exception("FromUtf8(): Cannot convert");
+
+		uint32_t code = (numBytes == 1) ? lead : (lead & (0x7F >> numBytes));
+		for (int j = 1; j < numBytes; j++)
+		{
+			auto next = static_cast<unsigned char>(str[i + j]);
+			if ((next & 0xC0) != 0x80) throw std::exception("FromUtf8(): Cannot convert");
+
+			code = (code << 6) | (next & 0x3F);
+		}
+
+		wideChars += (wchar_t)code;
+		i += numBytes;
+	}
+
+	return wideChars;
+}
+
+#endif
+
 std::string ToLower(const char* str)
 {
 	std::string src(str);
@@ -186,9 +285,65 @@ void ShowMessageModal(const char* message, const char* title)
 	MessageBoxA(NULL, message, title, MB_OK | MB_SERVICE_NOTIFICATION);
 }
 
+void LcMappedFile::Open(const char* filePath)
+{
+	LC_TRY
+
+	Close();
+
+	std::filesystem::path path(filePath);
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) throw std::exception("Cannot open file");
+
+	fileHandle = file;
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) throw std::exception("Empty file");
+
+	mappingHandle = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mappingHandle) throw std::exception("Cannot create file mapping");
+
+	data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (!data) throw std::exception("Cannot map file");
+
+	size = (size_t)fileSize.QuadPart;
+
+	LC_CATCH{ Close(); LC_THROW_EX("LcMappedFile::Open('", filePath, "')"); }
+}
+
+void LcMappedFile::Close()
+{
+	if (data) UnmapViewOfFile(data);
+	if (mappingHandle) CloseHandle(mappingHandle);
+	if (fileHandle) CloseHandle(fileHandle);
+
+	data = nullptr;
+	size = 0;
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+}
+
 #else
 
 void DebugMsg(const char* fmt, ...) {}
 void DebugMsgW(const wchar_t* fmt, ...) {}
 
+void LcMappedFile::Open(const char* filePath)
+{
+	Close();
+
+	buffer = ReadBinaryFile(filePath);
+	if (buffer.empty()) throw std::exception("LcMappedFile::Open(): Empty file");
+
+	data = buffer.data();
+	size = buffer.size();
+}
+
+void LcMappedFile::Close()
+{
+	buffer.clear();
+	data = nullptr;
+	size = 0;
+}
+
 #endif
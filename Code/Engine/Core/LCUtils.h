@@ -8,6 +8,8 @@
 
 #include "LCTypes.h"
 
+#include <cstdint>
+
 
 /**
 * Read text file */
@@ -18,6 +20,53 @@ CORE_API LcBytes ReadBinaryFile(const char* filePath);
 /**
 * Write text file */
 CORE_API void WriteTextFile(const char* filePath, const std::string& text);
+/**
+* Write binary file */
+CORE_API void WriteBinaryFile(const char* filePath, const LcBytes& data);
+
+
+/**
+* Read only memory mapped file. Data stays valid until file is closed */
+class CORE_API LcMappedFile
+{
+public:
+	LcMappedFile() : data(nullptr), size(0), fileHandle(nullptr), mappingHandle(nullptr) {}
+	//
+	LcMappedFile(const LcMappedFile&) = delete;
+	//
+	LcMappedFile& operator=(const LcMappedFile&) = delete;
+	//
+	~LcMappedFile() { Close(); }
+	/**
+	* Map file, throws on error */
+	void Open(const char* filePath);
+	//
+	void Close();
+	//
+	inline const void* GetData() const { return data; }
+	//
+	inline size_t GetSize() const { return size; }
+	//
+	inline bool IsOpen() const { return data != nullptr; }
+
+
+protected:
+	const void* data;
+	//
+	size_t size;
+	//
+	void* fileHandle;
+	//
+	void* mappingHandle;
+	// file data, if mapping is not supported
+	LcBytes buffer;
+
+};
+
+
+/**
+* 64-bit FNV-1a hash of data, pass previous hash as seed to continue */
+CORE_API uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ull);
 
 
 /**
@@ -9,7 +9,9 @@
 #include <memory>
 
 
-#ifndef CORE_EXPORTS
+#if !defined(_WIN32)
+#define CORE_API
+#elif !defined(CORE_EXPORTS)
 #define CORE_API __declspec (dllimport)
 #else
 #define CORE_API __declspec (dllexport)
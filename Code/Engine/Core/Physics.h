@@ -14,6 +14,14 @@
 #include <deque>
 
 
+/** Physics snapshot sections, see IPhysicsWorld::Save() */
+namespace LcPhysicsSections
+{
+	constexpr unsigned int StaticBoxes = 16;
+	constexpr unsigned int Bodies = 17;
+}
+
+
 /**
 * Physics body */
 class IPhysicsBody : public IObjectBase
@@ -44,6 +52,12 @@ public:
 	* Get rotation in radians */
 	virtual float GetRotation() const = 0;
 	/**
+	* Get position interpolated between two last simulation ticks, see IPhysicsWorld::Interpolate() */
+	virtual LcVector2 GetInterpolatedPos() const = 0;
+	/**
+	* Get rotation in radians interpolated between two last simulation ticks */
+	virtual float GetInterpolatedRotation() const = 0;
+	/**
 	* Set user data */
 	virtual void SetUserData(void* data) = 0;
 	/**
@@ -66,7 +80,7 @@ class IPhysicsWorld
 public:
 	typedef std::shared_ptr<IPhysicsBody> TBodyPtr;
 	//
-	typedef std::deque<TBodyPtr> TBodiesList;
+	typedef LcSlotMap<IPhysicsBody> TBodiesList;
 
 
 public:
@@ -77,9 +91,19 @@ public:
 	* Remove all physics objects */
 	virtual void Clear(bool removeRooted = false) = 0;
 	/**
-	* Update world */
+	* Update world, called with fixed time step */
 	virtual void Update(float deltaSeconds, const LcAppContext& context) = 0;
 	/**
+	* Interpolate body transforms between previous and current tick. Alpha [0, 1] */
+	virtual void Interpolate(float alpha) = 0;
+	/**
+	* Save dynamic bodies state to archive sections. Static boxes and rooted bodies are
+	* saved only if saveRooted is set, they are kept by Clear(false). User data is not saved */
+	virtual void Save(class LcArchiveWriter& writer, bool saveRooted = false) const = 0;
+	/**
+	* Add bodies saved by Save() */
+	virtual void Load(const class LcArchiveReader& reader) = 0;
+	/**
 	* Add static box */
 	virtual void AddStaticBox(LcVector2 pos, LcSizef size) = 0;
 	/**
@@ -95,7 +119,13 @@ public:
 	* Get dynamic body list */
 	virtual TBodiesList& GetDynamicBodies() = 0;
 	/**
-	* Get sound */
+	* Get body by tag */
 	virtual IPhysicsBody* GetBodyByTag(ObjectTag tag) const = 0;
+	/**
+	* Get body by handle. Returns nullptr for removed bodies */
+	virtual IPhysicsBody* GetBodyByHandle(LcObjectHandle handle) const = 0;
+	/**
+	* Append all bodies with tag to the list. Returns number of found bodies */
+	virtual size_t GetBodiesByTag(ObjectTag tag, std::vector<IPhysicsBody*>& outBodies) const = 0;
 
 };
@@ -67,3 +67,4 @@ constexpr const char* LuaWorldGlobalName = "world";
 constexpr const char* LuaPhysicsGlobalName = "physics";
 constexpr const char* LuaAudioGlobalName = "audio";
 constexpr const char* LuaInputGlobalName = "input";
+constexpr const char* LuaVisualMetaName = "LcVisual";
@@ -10,6 +10,7 @@
 #include "Visual.h"
 #include "World/WorldInterface.h"
 #include "Core/LCUtils.h"
+#include "Core/LCSerializer.h"
 
 
 LcFontWeight ToWeight(const std::string& weight)
@@ -41,6 +42,11 @@ LcTextAlignment ToAlignment(const std::string& alignment)
 class LcVisualTintComponent : public IVisualTintComponent
 {
 public:
+	LcVisualTintComponent() : tint(LcDefaults::White4)
+	{
+		SetColor(tint);
+	}
+	//
 	LcVisualTintComponent(const LcVisualTintComponent& colors) : tint(colors.tint)
 	{
 		SetColor(tint);
@@ -67,6 +73,12 @@ public: // IVisualTintComponent interface implementation
 public: // IVisualComponent interface implementation
 	//
 	virtual EVCType GetType() const override { return LcComponents::Tint; }
+	//
+	virtual bool IsThreadSafe() const override { return true; }
+	//
+	virtual bool Save(LcBlobWriter& writer) const override { writer.Write(tint); return true; }
+	//
+	virtual void Load(LcBlobReader& reader) override { tint = reader.Read<LcColor4>(); SetColor(tint); }
 
 
 protected:
@@ -104,6 +116,25 @@ public: // IVisualColorsComponent interface implementation
 public: // IVisualComponent interface implementation
 	//
 	virtual EVCType GetType() const override { return LcComponents::VertexColor; }
+	//
+	virtual bool IsThreadSafe() const override { return true; }
+	//
+	virtual bool Save(LcBlobWriter& writer) const override
+	{
+		writer.Write(leftTop);
+		writer.Write(rightTop);
+		writer.Write(rightBottom);
+		writer.Write(leftBottom);
+		return true;
+	}
+	//
+	virtual void Load(LcBlobReader& reader) override
+	{
+		leftTop = reader.Read<LcColor4>();
+		rightTop = reader.Read<LcColor4>();
+		rightBottom = reader.Read<LcColor4>();
+		leftBottom = reader.Read<LcColor4>();
+	}
 
 
 protected:
@@ -143,6 +174,21 @@ public: // IVisualComponent interface implementation
 public: // IVisualComponent interface implementation
 	//
 	virtual EVCType GetType() const override { return LcComponents::Texture; }
+	//
+	virtual bool IsThreadSafe() const override { return true; }
+	//
+	virtual bool Save(LcBlobWriter& writer) const override
+	{
+		writer.WriteString(texture);
+		writer.WriteArray(data.data(), data.size());
+		return true;
+	}
+	//
+	virtual void Load(LcBlobReader& reader) override
+	{
+		texture = reader.ReadString();
+		reader.ReadArray(data);
+	}
 
 
 protected:
@@ -152,34 +198,46 @@ protected:
 };
 
 
+TVComponentPtr CreateVisualComponent(EVCType type)
+{
+	switch (type)
+	{
+	case LcComponents::Tint: return LcMakePooled<LcVisualTintComponent>();
+	case LcComponents::VertexColor: return LcMakePooled<LcVisualColorsComponent>();
+	case LcComponents::Texture: return LcMakePooled<LcVisualTextureComponent>();
+	}
+
+	return TVComponentPtr();
+}
+
 void IVisual::AddTintComponent(const LcAppContext& context, LcColor4 tint)
 {
-	AddComponent(std::make_shared<LcVisualTintComponent>(tint), context);
+	AddComponent(LcMakePooled<LcVisualTintComponent>(tint), context);
 }
 
 void IVisual::AddTintComponent(const LcAppContext& context, LcColor3 tint)
 {
-	AddComponent(std::make_shared<LcVisualTintComponent>(tint), context);
+	AddComponent(LcMakePooled<LcVisualTintComponent>(tint), context);
 }
 
 void IVisual::AddColorsComponent(const LcAppContext& context, LcColor4 inLeftTop, LcColor4 inRightTop, LcColor4 inRightBottom, LcColor4 inLeftBottom)
 {
-	AddComponent(std::make_shared<LcVisualColorsComponent>(inLeftTop, inRightTop, inRightBottom, inLeftBottom), context);
+	AddComponent(LcMakePooled<LcVisualColorsComponent>(inLeftTop, inRightTop, inRightBottom, inLeftBottom), context);
 }
 
 void IVisual::AddColorsComponent(const LcAppContext& context, LcColor3 inLeftTop, LcColor3 inRightTop, LcColor3 inRightBottom, LcColor3 inLeftBottom)
 {
-	AddComponent(std::make_shared<LcVisualColorsComponent>(inLeftTop, inRightTop, inRightBottom, inLeftBottom), context);
+	AddComponent(LcMakePooled<LcVisualColorsComponent>(inLeftTop, inRightTop, inRightBottom, inLeftBottom), context);
 }
 
 void IVisual::AddTextureComponent(const LcAppContext& context, const std::string& inTexture)
 {
-	AddComponent(std::make_shared<LcVisualTextureComponent>(inTexture), context);
+	AddComponent(LcMakePooled<LcVisualTextureComponent>(inTexture), context);
 }
 
 void IVisual::AddTextureComponent(const LcAppContext& context, const LcBytes& inData)
 {
-	AddComponent(std::make_shared<LcVisualTextureComponent>(inData), context);
+	AddComponent(LcMakePooled<LcVisualTextureComponent>(inData), context);
 }
 
 
@@ -191,7 +249,10 @@ void IVisualComponent::Update(float deltaSeconds, const LcAppContext& context)
 		{
 			lifespan = -1.0f;
 			if (lifespanHandler) lifespanHandler(*this, context);
-			if (owner) owner->RemoveComponent(this, context);
+
+			// owner could be iterated now, world defers removal to sync point
+			if (owner && context.world) context.world->RemoveComponent(owner, this);
+			else if (owner) owner->RemoveComponent(this, context);
 		}
 		else
 		{
@@ -217,47 +278,92 @@ void IVisualBase::Destroy(const LcAppContext& context)
 	for (auto& comp : components) comp->Destroy(context);
 }
 
+void IVisualBase::Reset(const LcAppContext& context)
+{
+	for (auto& comp : components) comp->Destroy(context);
+
+	// keep list capacity for the next owner
+	components.clear();
+	componentMask = 0;
+	featureMask = 0;
+	OnFeaturesChanged();
+
+	tag = LcNoTag;
+	rooted = false;
+}
+
 void IVisualBase::Update(float deltaSeconds, const LcAppContext& context)
 {
-	for (auto& comp : components) comp->Update(deltaSeconds, context);
+	for (size_t i = 0; i < components.size();)
+	{
+		auto comp = components[i].get();
+		comp->Update(deltaSeconds, context);
+
+		// component could be removed by its lifespan
+		if (i < components.size() && components[i].get() == comp) i++;
+	}
 }
 
 void IVisualBase::AddComponent(TVComponentPtr comp, const LcAppContext& context)
 {
 	if (!comp) throw std::exception("IVisualBase::AddComponent(): Invalid component");
 
+	TVFeatureMask typeBit = ToFeatureBit(comp->GetType());
+	if (!typeBit) throw std::exception("IVisualBase::AddComponent(): Invalid component type");
+
 	comp->SetOwner(this);
-	components.push_back(comp);
-	components.back()->Init(context);
+
+	size_t slot = ToSlot(typeBit);
+	if (componentMask & typeBit)
+	{
+		// replace component of the same type
+		components[slot]->Destroy(context);
+		components[slot] = comp;
+	}
+	else
+	{
+		components.insert(components.begin() + slot, comp);
+		componentMask |= typeBit;
+	}
+
+	comp->Init(context);
+
+	OnFeaturesChanged();
 }
 
 void IVisualBase::RemoveComponent(class IVisualComponent* comp, const LcAppContext& context)
 {
-	auto it = std::find_if(components.begin(), components.end(), [comp](const TVComponentPtr& ptr) {
-		return comp == ptr.get();
-	});
+	TVFeatureMask typeBit = comp ? ToFeatureBit(comp->GetType()) : 0;
+	if (!(componentMask & typeBit)) return;
 
-	if (it != components.end())
-	{
-		(*it)->Destroy(context);
-		components.erase(it);
-	}
+	size_t slot = ToSlot(typeBit);
+	if (components[slot].get() != comp) return;
+
+	// keep alive until removed
+	TVComponentPtr removed = components[slot];
+	removed->Destroy(context);
+	components.erase(components.begin() + slot);
+	componentMask &= ~typeBit;
+
+	OnFeaturesChanged();
 }
 
-TVComponentPtr IVisualBase::GetComponent(EVCType type) const
+bool IVisualBase::CanUpdateInParallel() const
 {
-	auto result = std::find_if(components.begin(), components.end(), [type](auto& comp) {
-		return comp->GetType() == type;
-	});
-	return (result == components.end()) ? TVComponentPtr() : *result;
+	for (auto& comp : components)
+	{
+		if (!comp->CanUpdateInParallel()) return false;
+	}
+
+	return true;
 }
 
-bool IVisualBase::HasComponent(EVCType type) const
+const TVComponentPtr& IVisualBase::GetComponent(EVCType type) const
 {
-	auto result = std::find_if(components.begin(), components.end(), [type](auto& comp) {
-		return comp->GetType() == type;
-	});
-	return result != components.end();
+	static const TVComponentPtr noComponent;
+
+	TVFeatureMask typeBit = ToFeatureBit(type);
+	return (componentMask & typeBit) ? components[ToSlot(typeBit)] : noComponent;
 }
 
 
@@ -7,13 +7,15 @@
 #pragma once
 
 #include <set>
-#include <deque>
+#include <vector>
+#include <bitset>
 #include <memory>
 #include <functional>
 
 #include "Module.h"
 #include "Core/LCTypesEx.h"
 #include "Core/InputSystem.h"
+#include "Core/LCPoolAllocator.h"
 
 #pragma warning(disable : 4251)
 #pragma warning(disable : 4275)
@@ -64,12 +66,62 @@ CORE_API LcTextAlignment ToAlignment(const std::string& alignment);
 /** Visual feature list */
 typedef std::set<EVCType> TVFeaturesList;
 
+/** Visual features bitmask, one bit per component type */
+typedef unsigned long long TVFeatureMask;
+
+/** Get feature bit of the component type */
+inline TVFeatureMask ToFeatureBit(EVCType type) { return (type >= 0 && type < 64) ? (1ull << type) : 0ull; }
+
+/** Render pipeline is not resolved for the current visual features */
+constexpr int LcUnresolvedPipeline = -2;
+
+
+/**
+* Visual storage interface. Implemented by world visual containers */
+class IVisualStorage
+{
+public:
+	/**
+	* Virtual destructor */
+	virtual ~IVisualStorage() {}
+	/**
+	* Move visual to the bucket matching its current Z */
+	virtual void UpdateLayer(class IVisual* visual) = 0;
+	/**
+	* Visual position, size or rotation was changed */
+	virtual void UpdateBounds(class IVisual* visual) = 0;
+};
+
+/** Visual placement in world storage */
+struct LcVisualSlot
+{
+	LcVisualSlot() : bucket(-1), index(0), storage(nullptr), cells{ 0, 0, -1, -1 },
+		dirtyIndex(-1), unboundedIndex(-1), queryStamp(0) {}
+	// storage bucket, -1 if not stored
+	int bucket;
+	// index in bucket
+	size_t index;
+	// storage that owns visual
+	IVisualStorage* storage;
+	// spatial grid cells range, empty if not in grid
+	LcRect cells;
+	// index in grid dirty list, -1 if bounds are valid
+	int dirtyIndex;
+	// index in grid unbounded list, -1 if bounded
+	int unboundedIndex;
+	// last grid query
+	unsigned int queryStamp;
+};
+
 
 /**
 * Visual interface */
 class CORE_API IVisual : public IObjectBase
 {
 public:
+	/**
+	* Constructor */
+	IVisual() : featureMask(0), renderPipeline(LcUnresolvedPipeline) {}
 	/**
 	* Virtual destructor */
 	virtual ~IVisual() {}
@@ -80,17 +132,21 @@ public:
 	* Destroy visual */
 	virtual void Destroy(const LcAppContext& context) = 0;
 	/**
+	* Reset visual to default state to reuse it after removal */
+	virtual void Reset(const LcAppContext& context) = 0;
+	/**
 	* Update visual */
 	virtual void Update(float deltaSeconds, const LcAppContext& context) = 0;
 	/**
-	* Add component */
+	* Add component. Visual has one component of each type: component of the same type
+	* is replaced and destroyed */
 	virtual void AddComponent(TVComponentPtr comp, const LcAppContext& context) = 0;
 	/**
 	* Remove component */
 	virtual void RemoveComponent(class IVisualComponent* comp, const LcAppContext& context) = 0;
 	/**
 	* Get component */
-	virtual TVComponentPtr GetComponent(EVCType type) const = 0;
+	virtual const TVComponentPtr& GetComponent(EVCType type) const = 0;
 	/**
 	* Get features list */
 	virtual const TVFeaturesList& GetFeaturesList() const = 0;
@@ -98,6 +154,9 @@ public:
 	* Check for component type */
 	virtual bool HasComponent(EVCType type) const = 0;
 	/**
+	* Get component types of the visual, bit per type, see ToFeatureBit() */
+	virtual TVFeatureMask GetComponentMask() const = 0;
+	/**
 	* Visual size in pixels */
 	virtual void SetSize(LcSizef size) = 0;
 	/**
@@ -134,6 +193,9 @@ public:
 	* Get visual id (LcCreatables) */
 	virtual int GetTypeId() const = 0;
 	/**
+	* Check Update() could run on worker thread, while other visuals are updated */
+	virtual bool CanUpdateInParallel() const = 0;
+	/**
 	* Mouse button event */
 	virtual void OnMouseButton(int btn, LcKeyState state, int x, int y, const LcAppContext& context) = 0;
 	/**
@@ -175,6 +237,44 @@ public:
 	//
 	class IVisualTextureComponent* GetTextureComponent() const { return (class IVisualTextureComponent*)GetComponent(LcComponents::Texture).get(); }
 
+
+public:
+	/**
+	* Get world storage slot */
+	inline const LcVisualSlot& GetSlot() const { return slot; }
+	/**
+	* Get world storage slot */
+	inline LcVisualSlot& GetSlot() { return slot; }
+	/**
+	* Get features bitmask, matches features list */
+	inline TVFeatureMask GetFeatureMask() const { return featureMask; }
+	/**
+	* Get render pipeline index cached by render system */
+	inline int GetRenderPipeline() const { return renderPipeline; }
+	/**
+	* Cache render pipeline index. Reset on component changes */
+	inline void SetRenderPipeline(int pipeline) const { renderPipeline = pipeline; }
+
+
+protected:
+	/**
+	* Notify world storage that visual Z was changed */
+	inline void OnLayerChanged() { if (slot.storage) slot.storage->UpdateLayer(this); }
+	/**
+	* Notify world storage that visual bounds were changed */
+	inline void OnBoundsChanged() { if (slot.storage && slot.dirtyIndex < 0) slot.storage->UpdateBounds(this); }
+	/**
+	* Components were changed, render pipeline should be resolved again */
+	inline void OnFeaturesChanged() { renderPipeline = LcUnresolvedPipeline; }
+
+
+protected:
+	LcVisualSlot slot;
+	//
+	TVFeatureMask featureMask;
+	//
+	mutable int renderPipeline;
+
 };
 
 
@@ -217,6 +317,18 @@ public:
 	/**
 	* Get type */
 	virtual EVCType GetType() const = 0;
+	/**
+	* Update() is thread safe: changes only component state, world changes go through IWorld */
+	virtual bool IsThreadSafe() const { return false; }
+	/**
+	* Update could run on worker thread. Lifespan handler is user code, so it is not */
+	inline bool CanUpdateInParallel() const { return IsThreadSafe() && !lifespanHandler; }
+	/**
+	* Write component state to world snapshot. Returns false if component could not be saved */
+	virtual bool Save(class LcBlobWriter& writer) const { return false; }
+	/**
+	* Read component state written by Save(). Called before component is added to visual */
+	virtual void Load(class LcBlobReader& reader) {}
 
 
 protected:
@@ -234,25 +346,43 @@ protected:
 * Visual base interface */
 class CORE_API IVisualBase : public IVisual
 {
+public:
+	IVisualBase() : componentMask(0) {}
+
+
 public: // IVisual interface implementation
 	//
 	virtual void Init(const LcAppContext& context) override {}
 	//
 	virtual void Destroy(const LcAppContext& context) override;
 	//
+	virtual void Reset(const LcAppContext& context) override;
+	//
 	virtual void Update(float deltaSeconds, const LcAppContext& context) override;
 	//
 	virtual void AddComponent(TVComponentPtr comp, const LcAppContext& context) override;
 	//
 	virtual void RemoveComponent(class IVisualComponent* comp, const LcAppContext& context) override;
 	//
-	virtual TVComponentPtr GetComponent(EVCType type) const override;
+	virtual const TVComponentPtr& GetComponent(EVCType type) const override;
+	//
+	virtual bool HasComponent(EVCType type) const override { return (componentMask & ToFeatureBit(type)) != 0; }
 	//
-	virtual bool HasComponent(EVCType type) const override;
+	virtual TVFeatureMask GetComponentMask() const override { return componentMask; }
+	//
+	virtual bool CanUpdateInParallel() const override;
+
+
+protected:
+	/** Get index of component type in components list: number of present types below it */
+	inline size_t ToSlot(TVFeatureMask typeBit) const { return std::bitset<64>(componentMask & (typeBit - 1)).count(); }
 
 
 protected:
-	std::deque<TVComponentPtr> components;
+	// one component per type, sorted by type
+	std::vector<TVComponentPtr> components;
+	// presence bit per component type
+	TVFeatureMask componentMask;
 
 };
 
@@ -294,6 +424,12 @@ protected:
 };
 
 
+/**
+* Create default component of Tint, VertexColor or Texture type to load it from snapshot.
+* Returns nullptr for other types */
+CORE_API TVComponentPtr CreateVisualComponent(EVCType type);
+
+
 /** Visual tint component */
 class IVisualTintComponent : public IVisualComponent
 {
@@ -15,18 +15,7 @@
 
 bool HasInvisibleParent(IWidget* widget)
 {
-    if (widget)
-    {
-        if (widget->GetParent())
-        {
-            if (!widget->GetParent()->IsVisible())
-                return true;
-            else
-                return HasInvisibleParent(widget->GetParent());
-        }
-    }
-
-    return false;
+    return widget && !widget->IsParentVisible();
 }
 
 void LcGuiManager::OnKeys(int btn, LcKeyState state, const LcAppContext& context)
@@ -43,7 +32,7 @@ void LcGuiManager::OnKeys(int btn, LcKeyState state, const LcAppContext& context
         }
 
         auto widget = static_cast<IWidget*>(visual.get());
-        if (HasInvisibleParent(widget)) continue;
+        if (!widget->IsParentVisible()) continue;
 
         if (widget->HasFocus() && !widget->IsDisabled())
         {
@@ -71,7 +60,7 @@ void LcGuiManager::OnMouseButton(int btn, LcKeyState state, int x, int y, const
         }
 
         auto widget = static_cast<IWidget*>(visual.get());
-        if (HasInvisibleParent(widget)) continue;
+        if (!widget->IsParentVisible()) continue;
 
         LcVector2 point{ (float)x, (float)y };
         LcVector2 widgetPos = To2(widget->GetPos() * scale3);
@@ -105,7 +94,7 @@ void LcGuiManager::OnMouseMove(int x, int y, const LcAppContext& context)
         }
 
         auto widget = static_cast<IWidget*>(visual.get());
-        if (HasInvisibleParent(widget)) continue;
+        if (!widget->IsParentVisible()) continue;
 
         LcVector2 point{ (float)x, (float)y };
         LcVector2 widgetPos = To2(widget->GetPos() * scale3);
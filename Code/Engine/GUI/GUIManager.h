@@ -12,6 +12,8 @@
 #include "Core/LCTypesEx.h"
 
 
+/**
+* Widget has invisible parent. Kept for compatibility, reads cached IWidget::IsParentVisible() */
 GUI_API bool HasInvisibleParent(class IWidget* widget);
 
 
@@ -9,7 +9,9 @@
 #include <memory>
 
 
-#ifndef GUI_EXPORTS
+#if !defined(_WIN32)
+#define GUI_API
+#elif !defined(GUI_EXPORTS)
 #define GUI_API __declspec (dllimport)
 #else
 #define GUI_API __declspec (dllexport)
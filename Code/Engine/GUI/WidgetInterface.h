@@ -130,6 +130,12 @@ public:
 };
 
 
+/**
+* Create default widget component of the type to load it from snapshot. Returns nullptr for other types,
+* click and check handlers are not saved */
+GUI_API TVComponentPtr CreateWidgetComponent(EVCType type);
+
+
 /**
 * Widget interface */
 class GUI_API IWidget : public IVisualBase
@@ -156,6 +162,12 @@ public:
     /**
     * Get child widgets */
     virtual TChildsList& GetChilds() = 0;
+    /**
+    * All parent widgets are visible. Cached, updated by SetVisible(), AddChild() and RemoveChild() */
+    virtual bool IsParentVisible() const = 0;
+    /**
+    * Widget and all its parents are visible */
+    inline bool IsVisibleInHierarchy() const { return IsVisible() && IsParentVisible(); }
     //
     static int GetStaticId() { return LcCreatables::Widget; }
     /**
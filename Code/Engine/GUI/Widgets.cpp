@@ -9,29 +9,30 @@
 #include "pch.h"
 #include "GUI/Widgets.h"
 #include "World/WorldInterface.h"
+#include "Core/LCSerializer.h"
 
 
 void IWidget::AddTextComponent(const LcAppContext& context, const std::string& inTextKey, const LcTextBlockSettings& inSettings)
 {
-    AddComponent(std::make_shared<LcWidgetTextComponent>(inTextKey, inSettings), context);
+    AddComponent(LcMakePooled<LcWidgetTextComponent>(inTextKey, inSettings), context);
 }
 
 void IWidget::AddButtonComponent(const LcAppContext& context, const std::string& texture, LcVector2 idlePos, LcVector2 overPos, LcVector2 pressedPos)
 {
     AddTextureComponent(context, texture);
-    AddComponent(std::make_shared<LcWidgetButtonComponent>(idlePos, overPos, pressedPos), context);
+    AddComponent(LcMakePooled<LcWidgetButtonComponent>(idlePos, overPos, pressedPos), context);
 }
 
 void IWidget::AddCheckboxComponent(const LcAppContext& context, const std::string& texture, LcVector2 uncheckedPos, LcVector2 uncheckedHoveredPos,
     LcVector2 checkedPos, LcVector2 checkedHoveredPos)
 {
     AddTextureComponent(context, texture);
-    AddComponent(std::make_shared<LcWidgetCheckboxComponent>(uncheckedPos, uncheckedHoveredPos, checkedPos, checkedHoveredPos), context);
+    AddComponent(LcMakePooled<LcWidgetCheckboxComponent>(uncheckedPos, uncheckedHoveredPos, checkedPos, checkedHoveredPos), context);
 }
 
 void IWidget::AddClickHandlerComponent(const LcAppContext& context, LcClickHandler handler, bool addDefaultSkin)
 {
-    AddComponent(std::make_shared<LcWidgetClickComponent>(handler), context);
+    AddComponent(LcMakePooled<LcWidgetClickComponent>(handler), context);
 
     if (addDefaultSkin) AddButtonComponent(context, "../../Assets/button.png",
         LcVector2{ 2.0f, 2.0f }, LcVector2{ 2.0f, 44.0f }, LcVector2{ 2.0f, 86.0f });
@@ -39,13 +40,91 @@ void IWidget::AddClickHandlerComponent(const LcAppContext& context, LcClickHandl
 
 void IWidget::AddCheckHandlerComponent(const LcAppContext& context, LcCheckHandler handler, bool addDefaultSkin)
 {
-    AddComponent(std::make_shared<LcWidgetCheckComponent>(handler), context);
+    AddComponent(LcMakePooled<LcWidgetCheckComponent>(handler), context);
 
     if (addDefaultSkin) AddCheckboxComponent(context, "../../Assets/checkbox.png",
         LcVector2{ 0.0f, 0.0f }, LcVector2{ 32.0f, 0.0f }, LcVector2{ 0.0f, 32.0f }, LcVector2{ 32.0f, 32.0f });
 }
 
 
+TVComponentPtr CreateWidgetComponent(EVCType type)
+{
+    switch (type)
+    {
+    case LcComponents::Text: return LcMakePooled<LcWidgetTextComponent>();
+    case LcComponents::Button: return LcMakePooled<LcWidgetButtonComponent>();
+    case LcComponents::Checkbox: return LcMakePooled<LcWidgetCheckboxComponent>();
+    }
+
+    return TVComponentPtr();
+}
+
+/** Get skin position in pixels from UV generated by Init() */
+static LcVector2 ToSkinPos(const IVisual* owner, const LcVector4& uv)
+{
+    auto texComp = owner ? owner->GetTextureComponent() : nullptr;
+    LcVector2 texSize = texComp ? texComp->GetTextureSize() : LcDefaults::ZeroVec2;
+    if (texSize.x <= 0.0f || texSize.y <= 0.0f) return LcVector2{ uv.x, uv.y };
+
+    return LcVector2{ uv.x * texSize.x, uv.y * texSize.y };
+}
+
+bool LcWidgetTextComponent::Save(LcBlobWriter& writer) const
+{
+    writer.WriteString(textKey);
+    writer.Write(settings.textColor);
+    writer.Write(settings.textAlign);
+    writer.WriteString(settings.fontName);
+    writer.Write(settings.fontWeight);
+    writer.Write(settings.fontSize);
+    return true;
+}
+
+void LcWidgetTextComponent::Load(LcBlobReader& reader)
+{
+    textKey = reader.ReadString();
+    settings.textColor = reader.Read<LcColor4>();
+    settings.textAlign = reader.Read<LcTextAlignment>();
+    settings.fontName = reader.ReadWString();
+    settings.fontWeight = reader.Read<LcFontWeight>();
+    settings.fontSize = reader.Read<unsigned short>();
+}
+
+bool LcWidgetButtonComponent::Save(LcBlobWriter& writer) const
+{
+    writer.Write(ToSkinPos(owner, idle[0]));
+    writer.Write(ToSkinPos(owner, over[0]));
+    writer.Write(ToSkinPos(owner, pressed[0]));
+    return true;
+}
+
+void LcWidgetButtonComponent::Load(LcBlobReader& reader)
+{
+    idle[0] = To4(reader.Read<LcVector2>());
+    over[0] = To4(reader.Read<LcVector2>());
+    pressed[0] = To4(reader.Read<LcVector2>());
+    state = EBtnState::Idle;
+}
+
+bool LcWidgetCheckboxComponent::Save(LcBlobWriter& writer) const
+{
+    writer.Write(ToSkinPos(owner, unchecked[0]));
+    writer.Write(ToSkinPos(owner, uncheckedH[0]));
+    writer.Write(ToSkinPos(owner, checked[0]));
+    writer.Write(ToSkinPos(owner, checkedH[0]));
+    writer.Write(IsChecked());
+    return true;
+}
+
+void LcWidgetCheckboxComponent::Load(LcBlobReader& reader)
+{
+    unchecked[0] = To4(reader.Read<LcVector2>());
+    uncheckedH[0] = To4(reader.Read<LcVector2>());
+    checked[0] = To4(reader.Read<LcVector2>());
+    checkedH[0] = To4(reader.Read<LcVector2>());
+    state = reader.Read<bool>() ? ECheckboxState::Checked : ECheckboxState::Unchecked;
+}
+
 LcWidgetButtonComponent::LcWidgetButtonComponent(const LcWidgetButtonComponent& button) : state(EBtnState::Idle)
 {
     memcpy(idle, button.idle, sizeof(LcVector4) * 4);
@@ -186,6 +265,7 @@ void LcWidget::AddChild(IWidget* child)
 
     auto widget = static_cast<LcWidget*>(child);
     widget->parent = this;
+    widget->SetParentVisible(visible && parentVisible);
 }
 
 void LcWidget::RemoveChild(IWidget* child)
@@ -197,11 +277,63 @@ void LcWidget::RemoveChild(IWidget* child)
     {
         auto widget = static_cast<LcWidget*>(*it);
         widget->parent = nullptr;
+        widget->SetParentVisible(true);
         childs.erase(it);
 
     }
 }
 
+void LcWidget::SetVisible(bool inVisible)
+{
+    if (visible == inVisible) return;
+
+    visible = inVisible;
+    if (parentVisible) UpdateChildsVisibility();
+}
+
+void LcWidget::SetParentVisible(bool inParentVisible)
+{
+    if (parentVisible == inParentVisible) return;
+
+    parentVisible = inParentVisible;
+
+    // hidden widget hides its subtree regardless of parents
+    if (visible) UpdateChildsVisibility();
+}
+
+void LcWidget::UpdateChildsVisibility()
+{
+    bool childParentVisible = visible && parentVisible;
+    for (auto child : childs)
+    {
+        static_cast<LcWidget*>(child)->SetParentVisible(childParentVisible);
+    }
+}
+
+void LcWidget::Reset(const LcAppContext& context)
+{
+    IVisualBase::Reset(context);
+
+    if (parent) parent->RemoveChild(this);
+    for (auto child : childs)
+    {
+        auto widget = static_cast<LcWidget*>(child);
+        widget->parent = nullptr;
+        widget->SetParentVisible(true);
+    }
+
+    childs.clear();
+    features = TVFeaturesList{ LcComponents::Texture };
+    featureMask = ToFeatureBit(LcComponents::Texture);
+    pos = LcDefaults::ZeroVec3;
+    size = LcDefaults::ZeroSize;
+    visible = true;
+    parentVisible = true;
+    disabled = false;
+    hovered = false;
+    focused = false;
+}
+
 void LcWidget::OnMouseButton(int btn, LcKeyState state, int x, int y, const LcAppContext& context)
 {
     if (auto button = GetButtonComponent())
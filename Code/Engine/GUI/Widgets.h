@@ -34,6 +34,10 @@ public: // IWidgetTextComponent interface implementation
 public: // IVisualComponent interface implementation
     //
     virtual EVCType GetType() const override { return LcComponents::Text; }
+    //
+    virtual bool Save(LcBlobWriter& writer) const override;
+    //
+    virtual void Load(LcBlobReader& reader) override;
 
 
 protected:
@@ -68,6 +72,11 @@ public: // IVisualComponent interface implementation
     virtual void Init(const LcAppContext& context) override;
     //
     virtual EVCType GetType() const override { return LcComponents::Button; }
+    /**
+    * Saves skin positions, UVs are generated again by Init() */
+    virtual bool Save(LcBlobWriter& writer) const override;
+    //
+    virtual void Load(LcBlobReader& reader) override;
 
 
 protected:
@@ -104,6 +113,11 @@ public: // IVisualComponent interface implementation
     virtual void Init(const LcAppContext& context) override;
     //
     virtual EVCType GetType() const override { return LcComponents::Checkbox; }
+    /**
+    * Saves skin positions and check state, UVs are generated again by Init() */
+    virtual bool Save(LcBlobWriter& writer) const override;
+    //
+    virtual void Load(LcBlobReader& reader) override;
 
 
 protected:
@@ -181,10 +195,12 @@ public:
         , pos(LcDefaults::ZeroVec3)
         , size(LcDefaults::ZeroSize)
         , visible(true)
+        , parentVisible(true)
         , disabled(false)
         , focused(false)
         , hovered(false)
     {
+        featureMask = ToFeatureBit(LcComponents::Texture);
     }
     //
     ~LcWidget() {}
@@ -202,6 +218,8 @@ public:// IWidget interface implementation
     //
     virtual TChildsList& GetChilds() override { return childs; }
     //
+    virtual bool IsParentVisible() const override { return parentVisible; }
+    //
     virtual void OnKeys(int btn, LcKeyState state, const LcAppContext& context) override {}
     //
     virtual void RecreateFont(const LcAppContext& context) override {}
@@ -220,6 +238,8 @@ public:// IWidget interface implementation
 
 
 public:// IVisual interface implementation
+    //
+    virtual void Reset(const LcAppContext& context) override;
     //
     virtual const TVFeaturesList& GetFeaturesList() const override { return features; }
     //
@@ -227,11 +247,11 @@ public:// IVisual interface implementation
     //
     virtual LcSizef GetSize() const override { return size; }
     //
-    virtual void SetPos(LcVector3 inPos) override { pos = inPos; }
+    virtual void SetPos(LcVector3 inPos) override { bool newLayer = (pos.z != inPos.z); pos = inPos; if (newLayer) OnLayerChanged(); }
     //
     virtual void SetPos(LcVector2 inPos) override { pos = LcVector3{ inPos.x, inPos.y, pos.z }; }
     //
-    virtual void AddPos(LcVector3 inPos) override { pos = pos + inPos; }
+    virtual void AddPos(LcVector3 inPos) override { pos = pos + inPos; if (inPos.z != 0.0f) OnLayerChanged(); }
     //
     virtual LcVector3 GetPos() const override { return pos; }
     //
@@ -241,9 +261,11 @@ public:// IVisual interface implementation
     //
     virtual float GetRotZ() const override { return 0.0f; }
     //
-    virtual void SetVisible(bool inVisible) override { visible = inVisible; }
+    virtual void SetVisible(bool inVisible) override;
     //
     virtual bool IsVisible() const override { return visible; }
+    // widgets could render text in Update()
+    virtual bool CanUpdateInParallel() const override { return false; }
     //
     virtual void OnMouseButton(int btn, LcKeyState state, int x, int y, const LcAppContext& context) override;
     //
@@ -254,6 +276,14 @@ public:// IVisual interface implementation
     virtual void OnMouseLeave(const LcAppContext& context) override;
 
 
+protected:
+    /**
+    * Set parent visibility and pass it down the subtree if it changed */
+    void SetParentVisible(bool inParentVisible);
+    //
+    void UpdateChildsVisibility();
+
+
 protected:
     //
     IWidget* parent;
@@ -267,6 +297,8 @@ protected:
     LcSizef size;
     //
     bool visible;
+    // all parents are visible
+    bool parentVisible;
     //
     bool disabled;
     //
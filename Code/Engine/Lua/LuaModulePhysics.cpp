@@ -248,14 +248,15 @@ static int SetBodyUserData(lua_State* luaState)
 	int top = lua_gettop(luaState);
 
 	if (!lua_islightuserdata(luaState, top - 1) ||
-		!lua_islightuserdata(luaState, top - 0))
+		!lua_isuserdata(luaState, top - 0))
 	{
 		throw std::exception("SetBodyUserData(): Invalid params");
 	}
 	else
 	{
 		IPhysicsBody* body = static_cast<IPhysicsBody*>(lua_touserdata(luaState, top - 1));
-		void* userData = lua_touserdata(luaState, top - 0);
+		// body keeps visual address, as C++ code reads it with GetUserObject()
+		void* userData = IsVisual(luaState, top - 0) ? GetVisual(luaState, top - 0) : lua_touserdata(luaState, top - 0);
 
 		body->SetUserData(userData);
 	}
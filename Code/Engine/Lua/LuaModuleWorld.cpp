@@ -13,6 +13,20 @@
 #include "src/lua.hpp"
 
 
+static ISprite* GetSprite(lua_State* luaState, int index)
+{
+	auto visual = GetVisual(luaState, index);
+	if (visual->GetTypeId() != LcCreatables::Sprite) throw std::exception("GetSprite(): Visual is not a sprite");
+	return static_cast<ISprite*>(visual);
+}
+
+static IWidget* GetWidget(lua_State* luaState, int index)
+{
+	auto visual = GetVisual(luaState, index);
+	if (visual->GetTypeId() != LcCreatables::Widget) throw std::exception("GetWidget(): Visual is not a widget");
+	return static_cast<IWidget*>(visual);
+}
+
 static int AddSprite(lua_State* luaState)
 {
 	bool visible = true;
@@ -48,7 +62,7 @@ static int AddSprite(lua_State* luaState)
 	if (world)
 	{
 		auto sprite = world->AddSprite(x, y, LcLayersRange(z), width, height, rotation, visible);
-		lua_pushlightuserdata(luaState, sprite);
+		PushVisual(luaState, sprite);
 	}
 	else throw std::exception("AddSprite(): Invalid World");
 
@@ -88,7 +102,7 @@ static int AddWidget(lua_State* luaState)
 	if (world)
 	{
 		auto widget = world->AddWidget(x, y, LcLayersRange(z), width, height, visible);
-		lua_pushlightuserdata(luaState, widget);
+		PushVisual(luaState, widget);
 	}
 	else throw std::exception("AddWidget(): Invalid World");
 
@@ -103,7 +117,7 @@ static int AddTintComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top))
 	{
-		visual = static_cast<IVisual*>(lua_touserdata(luaState, top));
+		visual = GetVisual(luaState, top);
 		tint = GetColor(luaState, top - 1);
 	}
 	else
@@ -133,7 +147,7 @@ static int AddColorsComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top - 4))
 	{
-		visual = static_cast<IVisual*>(lua_touserdata(luaState, top - 4));
+		visual = GetVisual(luaState, top - 4);
 		leftTop = GetColor(luaState, top - 3);
 		rightTop = GetColor(luaState, top - 2);
 		rightBottom = GetColor(luaState, top - 1);
@@ -169,7 +183,7 @@ static int AddTextureComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top))
 	{
-		visual = static_cast<IVisual*>(lua_touserdata(luaState, top));
+		visual = GetVisual(luaState, top);
 		texture = lua_tolstring(luaState, top - 1, 0);
 	}
 	else
@@ -199,7 +213,7 @@ static int AddCustomUVComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top - 4))
 	{
-		sprite = static_cast<ISprite*>(lua_touserdata(luaState, top - 4));
+		sprite = GetSprite(luaState, top - 4);
 		leftTop = GetVector2(luaState, top - 3);
 		rightTop = GetVector2(luaState, top - 2);
 		rightBottom = GetVector2(luaState, top - 1);
@@ -237,7 +251,7 @@ static int AddAnimationComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top - 3))
 	{
-		sprite = static_cast<ISprite*>(lua_touserdata(luaState, top - 3));
+		sprite = GetSprite(luaState, top - 3);
 		frameSize = GetVector2(luaState, top - 2);
 		numFrames = lua_toint(luaState, top - 1);
 		framesPerSecond = lua_tofloat(luaState, top - 0);
@@ -274,7 +288,7 @@ static int AddTiledComponent(lua_State* luaState)
 		lua_isstring(luaState, top - 1) &&
 		lua_isstring(luaState, top - 0))
 	{
-		sprite = static_cast<ISprite*>(lua_touserdata(luaState, top - 2));
+		sprite = GetSprite(luaState, top - 2);
 		tilesPath = lua_tolstring(luaState, top - 1, 0);
 		handlerName = lua_tolstring(luaState, top - 0, 0);
 	}
@@ -282,7 +296,7 @@ static int AddTiledComponent(lua_State* luaState)
 		lua_isuserdata(luaState, top - 1) &&
 		lua_isstring(luaState, top - 0))
 	{
-		sprite = static_cast<ISprite*>(lua_touserdata(luaState, top - 1));
+		sprite = GetSprite(luaState, top - 1);
 		tilesPath = lua_tolstring(luaState, top - 0, 0);
 	}
 	else
@@ -365,7 +379,7 @@ static int AddParticlesComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top - 2))
 	{
-		sprite = static_cast<ISprite*>(lua_touserdata(luaState, top - 2));
+		sprite = GetSprite(luaState, top - 2);
 		numSprites = lua_toint(luaState, top - 1);
 		settings = GetParticleSettings(luaState, top - 0);
 	}
@@ -400,7 +414,7 @@ static int AddTextComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top - 2))
 	{
-		widget = static_cast<IWidget*>(lua_touserdata(luaState, top - 2));
+		widget = GetWidget(luaState, top - 2);
 		textKey = lua_tolstring(luaState, top - 1, 0);
 		settings = GetTextBlockSettings(luaState, top - 0);
 	}
@@ -433,7 +447,7 @@ static int AddButtonComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top - 4))
 	{
-		widget = static_cast<IWidget*>(lua_touserdata(luaState, top - 4));
+		widget = GetWidget(luaState, top - 4);
 		texture = lua_tolstring(luaState, top - 3, 0);
 		idlePos = GetVector2(luaState, top - 2);
 		overPos = GetVector2(luaState, top - 1);
@@ -470,7 +484,7 @@ static int AddCheckboxComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top - 5))
 	{
-		widget = static_cast<IWidget*>(lua_touserdata(luaState, top - 5));
+		widget = GetWidget(luaState, top - 5);
 		texture = lua_tolstring(luaState, top - 4, 0);
 		uncheckedPos = GetVector2(luaState, top - 3);
 		uncheckedHoveredPos = GetVector2(luaState, top - 2);
@@ -508,7 +522,7 @@ static int AddClickHandlerComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top - 1))
 	{
-		widget = static_cast<IWidget*>(lua_touserdata(luaState, top - 1));
+		widget = GetWidget(luaState, top - 1);
 		handlerName = lua_tolstring(luaState, top - 0, 0);
 	}
 	else
@@ -545,7 +559,7 @@ static int AddCheckHandlerComponent(lua_State* luaState)
 
 	if (lua_isuserdata(luaState, top - 1))
 	{
-		widget = static_cast<IWidget*>(lua_touserdata(luaState, top - 1));
+		widget = GetWidget(luaState, top - 1);
 		handlerName = lua_tolstring(luaState, top - 0, 0);
 	}
 	else
@@ -586,7 +600,7 @@ static int SetVisualPos(lua_State* luaState)
 	}
 	else
 	{
-		IVisual* visual = static_cast<IVisual*>(lua_touserdata(luaState, top - 1));
+		IVisual* visual = GetVisual(luaState, top - 1);
 		LcVector3 pos = GetVector(luaState, top - 0);
 
 		visual->SetPos(pos);
@@ -605,7 +619,7 @@ static int GetVisualPos(lua_State* luaState)
 	}
 	else
 	{
-		IVisual* visual = static_cast<IVisual*>(lua_touserdata(luaState, top));
+		IVisual* visual = GetVisual(luaState, top);
 		LcVector3 pos = visual->GetPos();
 
 		lua_createtable(luaState, 0, 3);
@@ -633,7 +647,35 @@ static int GetVisualByTag(lua_State* luaState)
 		int tag = lua_toint(luaState, top);
 		auto world = GetWorld(luaState);
 
-		lua_pushlightuserdata(luaState, world->GetVisualByTag(tag));
+		PushVisual(luaState, world->GetVisualByTag(tag));
+	}
+
+	return 1;
+}
+
+static int GetVisualsByTag(lua_State* luaState)
+{
+	static std::vector<IVisual*> visuals;
+	int top = lua_gettop(luaState);
+
+	if (!lua_isinteger(luaState, top))
+	{
+		throw std::exception("GetVisualsByTag(): Invalid params");
+	}
+	else
+	{
+		int tag = lua_toint(luaState, top);
+		auto world = GetWorld(luaState);
+
+		visuals.clear();
+		world->GetVisualsByTag(tag, visuals);
+
+		lua_createtable(luaState, (int)visuals.size(), 0);
+		for (int i = 0; i < (int)visuals.size(); i++)
+		{
+			PushVisual(luaState, visuals[i]);
+			lua_rawseti(luaState, -2, i + 1);
+		}
 	}
 
 	return 1;
@@ -714,6 +756,9 @@ void AddLuaModuleWorld(const LcAppContext& context, IScriptSystem* scriptSystem)
 
 	lua_pushcfunction(luaState, GetVisualByTag);
 	lua_setglobal(luaState, "GetVisualByTag");
+
+	lua_pushcfunction(luaState, GetVisualsByTag);
+	lua_setglobal(luaState, "GetVisualsByTag");
 }
 
 
@@ -20,6 +20,7 @@ static int GetTag(lua_State* luaState);
 static int AddToRoot(lua_State* luaState);
 static int RemoveFromRoot(lua_State* luaState);
 static int IsRooted(lua_State* luaState);
+static int VisualEquals(lua_State* luaState);
 
 
 LcLuaScriptSystem::~LcLuaScriptSystem()
@@ -63,6 +64,12 @@ void LcLuaScriptSystem::Init(const LcAppContext& context)
 	lua_setfield(luaState, -2, "Axis");
 	lua_setglobal(luaState, "ScriptHandler");
 
+	// visual handles are userdata of this type, so they are not mixed with bodies and sounds
+	luaL_newmetatable(luaState, LuaVisualMetaName);
+	lua_pushcfunction(luaState, VisualEquals);
+	lua_setfield(luaState, -2, "__eq");
+	lua_pop(luaState, 1);
+
 	lua_pushlightuserdata(luaState, this);
 	lua_setglobal(luaState, LuaScriptGlobalName);
 
@@ -276,8 +283,9 @@ int SetTag(lua_State* luaState)
 	}
 	else
 	{
-		IObjectBase* object = static_cast<IObjectBase*>(lua_touserdata(luaState, top - 1));
+		IObjectBase* object = GetObjectBase(luaState, top - 1);
 		int tag = lua_toint(luaState, top - 0);
+		object->SetTag(tag);
 	}
 
 	return 0;
@@ -293,7 +301,7 @@ int GetTag(lua_State* luaState)
 	}
 	else
 	{
-		IObjectBase* object = static_cast<IObjectBase*>(lua_touserdata(luaState, top));
+		IObjectBase* object = GetObjectBase(luaState, top);
 		lua_pushinteger(luaState, object->GetTag());
 	}
 
@@ -310,7 +318,7 @@ int AddToRoot(lua_State* luaState)
 	}
 	else
 	{
-		IObjectBase* object = static_cast<IObjectBase*>(lua_touserdata(luaState, top));
+		IObjectBase* object = GetObjectBase(luaState, top);
 
 		object->AddToRoot();
 	}
@@ -328,7 +336,7 @@ int RemoveFromRoot(lua_State* luaState)
 	}
 	else
 	{
-		IObjectBase* object = static_cast<IObjectBase*>(lua_touserdata(luaState, top));
+		IObjectBase* object = GetObjectBase(luaState, top);
 
 		object->RemoveFromRoot();
 	}
@@ -346,13 +354,22 @@ int IsRooted(lua_State* luaState)
 	}
 	else
 	{
-		IObjectBase* object = static_cast<IObjectBase*>(lua_touserdata(luaState, top));
+		IObjectBase* object = GetObjectBase(luaState, top);
 		lua_pushboolean(luaState, object->IsRooted() ? 1 : 0);
 	}
 
 	return 1;
 }
 
+int VisualEquals(lua_State* luaState)
+{
+	auto a = static_cast<LcObjectHandle*>(luaL_testudata(luaState, 1, LuaVisualMetaName));
+	auto b = static_cast<LcObjectHandle*>(luaL_testudata(luaState, 2, LuaVisualMetaName));
+	lua_pushboolean(luaState, (a && b && *a == *b) ? 1 : 0);
+
+	return 1;
+}
+
 IScriptSystem* GetScript(struct lua_State* luaState)
 {
 	lua_getglobal(luaState, LuaScriptGlobalName);
@@ -407,6 +424,49 @@ IInputSystem* GetInput(struct lua_State* luaState)
 	return input;
 }
 
+void PushVisual(struct lua_State* luaState, const IVisual* visual)
+{
+	if (!visual || visual->GetHandle() == LcInvalidHandle)
+	{
+		lua_pushnil(luaState);
+		return;
+	}
+
+	auto handle = static_cast<LcObjectHandle*>(lua_newuserdata(luaState, sizeof(LcObjectHandle)));
+	*handle = visual->GetHandle();
+	luaL_setmetatable(luaState, LuaVisualMetaName);
+}
+
+bool IsVisual(struct lua_State* luaState, int index)
+{
+	return luaL_testudata(luaState, index, LuaVisualMetaName) != nullptr;
+}
+
+IVisual* GetVisual(struct lua_State* luaState, int index)
+{
+	auto handlePtr = static_cast<LcObjectHandle*>(luaL_testudata(luaState, index, LuaVisualMetaName));
+	if (!handlePtr) throw std::exception("GetVisual(): Invalid visual");
+
+	auto handle = *handlePtr;
+	auto world = GetWorld(luaState);
+	lua_pop(luaState, 1);
+
+	// handle is stale when visual is removed, its address could be reused by new visual
+	auto visual = world->GetVisualByHandle(handle);
+	if (!visual) throw std::exception("GetVisual(): Visual is removed");
+	return visual;
+}
+
+IObjectBase* GetObjectBase(struct lua_State* luaState, int index)
+{
+	if (IsVisual(luaState, index)) return GetVisual(luaState, index);
+
+	// physics bodies and sounds are light userdata
+	auto object = static_cast<IObjectBase*>(lua_touserdata(luaState, index));
+	if (!lua_islightuserdata(luaState, index) || !object) throw std::exception("GetObjectBase(): Invalid object");
+	return object;
+}
+
 LcColor4 GetColor(struct lua_State* luaState, int table)
 {
 	if (!lua_istable(luaState, table)) throw std::exception("GetColor(): Invalid table");
@@ -36,6 +36,18 @@ LCLUA_API IAudioSystem* GetAudio(struct lua_State* luaState);
 // throws exception if can't get
 LCLUA_API IInputSystem* GetInput(struct lua_State* luaState);
 
+// push visual handle as userdata with LuaVisualMetaName metatable, or nil, scripts never keep visual address
+LCLUA_API void PushVisual(struct lua_State* luaState, const class IVisual* visual);
+
+// check if value is visual handle pushed with PushVisual()
+LCLUA_API bool IsVisual(struct lua_State* luaState, int index);
+
+// get visual by handle pushed with PushVisual(), throws exception if visual is removed
+LCLUA_API class IVisual* GetVisual(struct lua_State* luaState, int index);
+
+// get visual by handle or physics body or sound by light userdata, throws exception if can't get
+LCLUA_API class IObjectBase* GetObjectBase(struct lua_State* luaState, int index);
+
 // throws exception if can't get
 LCLUA_API LcColor4 GetColor(struct lua_State* luaState, int table);
 
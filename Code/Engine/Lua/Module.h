@@ -9,7 +9,9 @@
 #include "Core/ScriptSystem.h"
 
 
-#ifndef LUA_EXPORTS
+#if !defined(_WIN32)
+#define LCLUA_API
+#elif !defined(LUA_EXPORTS)
 #define LCLUA_API __declspec (dllimport)
 #else
 #define LCLUA_API __declspec (dllexport)
@@ -30,29 +32,31 @@ LCLUA_API void AddLuaModuleApplication(const LcAppContext& context, IScriptSyste
 
 /**
 * @brief Add World functions to script system.
+* Sprites and widgets are passed to scripts as visual handles, userdata with LuaVisualMetaName metatable.
+* Handles of the same visual are equal, functions throw if the visual is removed.
 * Functions:
 *
-* - ISprite* AddSprite(float x, float y, [optional { float z },] float width, float height, float rotation, bool visible)
+* - SpriteHandle AddSprite(float x, float y, [optional { float z },] float width, float height, float rotation, bool visible)
 *
-* - IWidget* AddWidget(float x, float y, [optional { float z },] float width, float height, bool visible)
+* - WidgetHandle AddWidget(float x, float y, [optional { float z },] float width, float height, bool visible)
 *
-* - void AddTintComponent([optional IVisual* visual,] LcColor4 tint)
+* - void AddTintComponent([optional VisualHandle visual,] LcColor4 tint)
 *
 *	LcColor4 -> { r = 1.0, g = 0.0, b = 0.0, a = 1.0 }
-* - void AddColorsComponent([optional IVisual* visual,] LcColor4 leftTop, LcColor4 rightTop, LcColor4 rightBottom, LcColor4 leftBottom)
+* - void AddColorsComponent([optional VisualHandle visual,] LcColor4 leftTop, LcColor4 rightTop, LcColor4 rightBottom, LcColor4 leftBottom)
 *
-* - void AddTextureComponent([optional IVisual* visual,] string texPath)
+* - void AddTextureComponent([optional VisualHandle visual,] string texPath)
 *
 *	LcVector2 -> { x = 1.0, y = 1.0 }
-* - void AddCustomUVComponent([optional ISprite* sprite,] LcVector2 leftTop, LcVector2 rightTop, LcVector2 rightBottom, LcVector2 leftBottom)
+* - void AddCustomUVComponent([optional SpriteHandle sprite,] LcVector2 leftTop, LcVector2 rightTop, LcVector2 rightBottom, LcVector2 leftBottom)
 *
-* - void AddAnimationComponent([optional ISprite* sprite,] LcVector2 frameSize, int numFrames, float framesPerSecond)
+* - void AddAnimationComponent([optional SpriteHandle sprite,] LcVector2 frameSize, int numFrames, float framesPerSecond)
 *
-* - void AddTiledComponent([optional ISprite* sprite,] string tilesPath)
+* - void AddTiledComponent([optional SpriteHandle sprite,] string tilesPath)
 *
 *   LcTiledProps -> { string name, any value }
 *   Handler -> void (string layerName, string objName, string objType, LcTiledProps objProps, LcVector2 objPos, LcSizef objSize)
-* - void AddTiledComponent([optional ISprite* sprite,] string tilesPath, string objectsHandlerName)
+* - void AddTiledComponent([optional SpriteHandle sprite,] string tilesPath, string objectsHandlerName)
 *
 *	LcBasicParticleSettings -> {
 *		frameSize = { x = 32.0, y = 32.0 },
@@ -63,7 +67,7 @@ LCLUA_API void AddLuaModuleApplication(const LcAppContext& context, IScriptSyste
 *		fadeOutRate = 0.3,
 *		speed = 0.2
 *	}
-* - void AddParticlesComponent([optional ISprite* sprite,] int numSprites, LcBasicParticleSettings settings)
+* - void AddParticlesComponent([optional SpriteHandle sprite,] int numSprites, LcBasicParticleSettings settings)
 *
 *	LcTextBlockSettings -> {
 *		textColor = { r = 1.0, g = 0.0, b = 0.0 },
@@ -72,21 +76,23 @@ LCLUA_API void AddLuaModuleApplication(const LcAppContext& context, IScriptSyste
 *		fontWeight = "Normal",
 *		fontSize = 20
 *	}
-* - void AddTextComponent([optional IWidget* widget,] string textKey, LcTextBlockSettings settings)
+* - void AddTextComponent([optional WidgetHandle widget,] string textKey, LcTextBlockSettings settings)
 *
-* - void AddButtonComponent([optional ISprite* sprite,] string texPath, LcVector2 idlePos, LcVector2 overPos, LcVector2 pressedPos)
+* - void AddButtonComponent([optional SpriteHandle sprite,] string texPath, LcVector2 idlePos, LcVector2 overPos, LcVector2 pressedPos)
 *
-* - void AddCheckboxComponent([optional ISprite* sprite,] string texPath, LcVector2 uncheckedPos, LcVector2 uncheckedHoveredPos, LcVector2 checkedPos, LcVector2 checkedHoveredPos)
+* - void AddCheckboxComponent([optional SpriteHandle sprite,] string texPath, LcVector2 uncheckedPos, LcVector2 uncheckedHoveredPos, LcVector2 checkedPos, LcVector2 checkedHoveredPos)
 *
-* - void AddClickHandlerComponent([optional ISprite* sprite,] string handlerFuncName)
+* - void AddClickHandlerComponent([optional SpriteHandle sprite,] string handlerFuncName)
 *
-* - void AddCheckHandlerComponent([optional ISprite* sprite,] string handlerFuncName)
+* - void AddCheckHandlerComponent([optional SpriteHandle sprite,] string handlerFuncName)
 *
-* - void SetVisualPos(ISprite* sprite, LcVector3 pos)
+* - void SetVisualPos(SpriteHandle sprite, LcVector3 pos)
 *
-* - LcVector3 GetVisualPos(ISprite* sprite)
+* - LcVector3 GetVisualPos(SpriteHandle sprite)
 *
-* - IVisual* GetVisualByTag(int tag)
+* - VisualHandle GetVisualByTag(int tag)
+*
+* - table<VisualHandle> GetVisualsByTag(int tag)
 */
 LCLUA_API void AddLuaModuleWorld(const LcAppContext& context, IScriptSystem* scriptSystem = nullptr);
 
@@ -129,7 +135,7 @@ LCLUA_API void AddLuaModuleAudio(const LcAppContext& context, IScriptSystem* scr
 *
 * - bool InBodyFalling(IPhysicsBody* body)
 *
-* - void SetBodyUserData(IPhysicsBody* body, void* userData)
+* - void SetBodyUserData(IPhysicsBody* body, VisualHandle or userdata userData), visual is stored by address
 *
 * - IPhysicsBody* GetBodyByTag(int tag)
 */
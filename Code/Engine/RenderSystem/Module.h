@@ -9,7 +9,9 @@
 #include <memory>
 
 
-#ifndef RENDERSYSTEM_EXPORTS
+#if !defined(_WIN32)
+#define RENDERSYSTEM_API
+#elif !defined(RENDERSYSTEM_EXPORTS)
 #define RENDERSYSTEM_API __declspec (dllimport)
 #else
 #define RENDERSYSTEM_API __declspec (dllexport)
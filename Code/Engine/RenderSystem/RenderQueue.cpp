@@ -0,0 +1,82 @@
+/**
+* RenderQueue.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "RenderSystem/RenderQueue.h"
+
+
+void LcRenderQueue::Clear()
+{
+    items.clear();
+    batches.clear();
+    stats = LcRenderQueueStats{};
+    prevState = LcRenderState{ -1, nullptr, 0 };
+}
+
+void LcRenderQueue::Add(const IVisual* visual, int bucket, const LcRenderState& state)
+{
+    if (!visual) return;
+
+    if (items.empty() || state != prevState) stats.numStateChangesSaved++;
+    prevState = state;
+
+    items.push_back(LcRenderItem{ MakeKey(bucket, state), visual, state });
+}
+
+void LcRenderQueue::Sort()
+{
+    // LSD radix sort by 8-bit digits, passes with the same digit for all items are skipped
+    sortBuffer.resize(items.size());
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t counts[256] = {};
+        for (auto& item : items) counts[(item.key >> shift) & 0xFF]++;
+
+        if (items.empty() || counts[(items[0].key >> shift) & 0xFF] == items.size()) continue;
+
+        size_t offset = 0;
+        for (auto& count : counts)
+        {
+            size_t numDigits = count;
+            count = offset;
+            offset += numDigits;
+        }
+
+        for (auto& item : items) sortBuffer[counts[(item.key >> shift) & 0xFF]++] = item;
+
+        items.swap(sortBuffer);
+    }
+
+    // group visuals with the same state
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        if (batches.empty() || items[i].state != batches.back().GetState())
+        {
+            batches.push_back(LcRenderBatch{ &items[i], 1 });
+        }
+        else
+        {
+            batches.back().numItems++;
+        }
+    }
+
+    stats.numItems = (int)items.size();
+    stats.numBatches = (int)batches.size();
+    stats.numStateChanges = (int)batches.size();
+    stats.numStateChangesSaved -= stats.numStateChanges;
+}
+
+unsigned long long LcRenderQueue::MakeKey(int bucket, const LcRenderState& state)
+{
+    // fibonacci hashing of texture pointer, collisions only break batches
+    unsigned long long texHash = ((unsigned long long)(size_t)state.texture * 0x9E3779B97F4A7C15ull) >> 40;
+
+    return ((unsigned long long)(bucket & 0x1F) << 59) |
+        ((unsigned long long)((state.pipeline + 1) & 0x3F) << 53) |
+        ((texHash & 0xFFFFFF) << 29) |
+        ((unsigned long long)(state.blend & 0x7) << 26);
+}
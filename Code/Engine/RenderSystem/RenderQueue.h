@@ -0,0 +1,118 @@
+/**
+* RenderQueue.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "RenderSystem/Module.h"
+
+#include <vector>
+
+#pragma warning(disable : 4251)
+
+
+/** Render state of the visual, filled by render system backend */
+struct LcRenderState
+{
+	// backend pipeline (renderer) index, -1 for not supported visuals
+	int pipeline;
+	// bound texture, nullptr if no texture
+	const void* texture;
+	// blend mode, 0 - alpha blending
+	int blend;
+	//
+	inline bool operator==(const LcRenderState& state) const { return pipeline == state.pipeline && texture == state.texture && blend == state.blend; }
+	//
+	inline bool operator!=(const LcRenderState& state) const { return !(*this == state); }
+};
+
+
+/** Render queue stats for the last frame */
+struct LcRenderQueueStats
+{
+	int numItems;
+	// runs of visuals with the same render state
+	int numBatches;
+	// reported by render system backend
+	int numDrawCalls;
+	// render state changes in sorted order
+	int numStateChanges;
+	// state changes avoided by sorting
+	int numStateChangesSaved;
+};
+
+
+/** Queued visual */
+struct LcRenderItem
+{
+	unsigned long long key;
+	//
+	const class IVisual* visual;
+	//
+	LcRenderState state;
+};
+
+
+/** Run of queued visuals with the same render state */
+struct LcRenderBatch
+{
+	const LcRenderItem* items;
+	//
+	size_t numItems;
+	//
+	const LcRenderState& GetState() const { return items[0].state; }
+};
+
+
+/**
+* Render queue. Visuals are sorted by 64-bit key: layer bucket, pipeline, texture, blend mode.
+* Radix sort is stable, so visuals with the same key keep storage order.
+* Layer order is always preserved, inside the layer visuals are grouped by render state.
+*/
+class RENDERSYSTEM_API LcRenderQueue
+{
+public:
+	typedef std::vector<LcRenderItem> TItemsList;
+	//
+	typedef std::vector<LcRenderBatch> TBatchesList;
+
+
+public:
+	LcRenderQueue() : stats{}, prevState{ -1, nullptr, 0 } {}
+	/**
+	* Start new frame */
+	void Clear();
+	/**
+	* Add visual. Bucket is the layer bucket of the visual storage, back layers go first */
+	void Add(const class IVisual* visual, int bucket, const LcRenderState& state);
+	/**
+	* Sort queued visuals and build batches */
+	void Sort();
+	/**
+	* Add backend draw calls to stats */
+	inline void AddDrawCalls(int numDrawCalls) { stats.numDrawCalls += numDrawCalls; }
+	//
+	inline const TItemsList& GetItems() const { return items; }
+	//
+	inline const TBatchesList& GetBatches() const { return batches; }
+	//
+	inline const LcRenderQueueStats& GetStats() const { return stats; }
+	/**
+	* Make sort key. Bits: 63-59 bucket, 58-53 pipeline, 52-29 texture hash, 28-26 blend */
+	static unsigned long long MakeKey(int bucket, const LcRenderState& state);
+
+
+protected:
+	TItemsList items;
+	//
+	TItemsList sortBuffer;
+	//
+	TBatchesList batches;
+	//
+	LcRenderQueueStats stats;
+	// state of the last added visual, used to count unsorted state changes
+	LcRenderState prevState;
+
+};
@@ -0,0 +1,152 @@
+/**
+* RenderSnapshot.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "RenderSystem/RenderSnapshot.h"
+
+
+LcRenderSnapshot& LcRenderSnapshotBuffer::BeginWrite()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this]() {
+        return stopped || (writeIndex != readIndex && writeIndex != pendingIndex);
+    });
+
+    auto& snapshot = snapshots[writeIndex];
+    snapshot.Clear();
+    snapshot.frame = numPublished;
+
+    return snapshot;
+}
+
+void LcRenderSnapshotBuffer::Publish()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopped) return;
+
+        if (pendingIndex >= 0) numDropped++;
+        pendingIndex = writeIndex;
+        writeIndex = 1 - writeIndex;
+        numPublished++;
+    }
+
+    condition.notify_all();
+}
+
+const LcRenderSnapshot* LcRenderSnapshotBuffer::Acquire()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this]() { return stopped || pendingIndex >= 0; });
+
+    if (stopped) return nullptr;
+
+    readIndex = pendingIndex;
+    pendingIndex = -1;
+
+    return &snapshots[readIndex];
+}
+
+void LcRenderSnapshotBuffer::Release()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        readIndex = -1;
+    }
+
+    condition.notify_all();
+}
+
+void LcRenderSnapshotBuffer::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this]() { return stopped || (pendingIndex < 0 && readIndex < 0); });
+}
+
+void LcRenderSnapshotBuffer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+        pendingIndex = -1;
+    }
+
+    condition.notify_all();
+}
+
+void LcRenderSnapshotBuffer::Restart()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stopped = false;
+    pendingIndex = -1;
+    readIndex = -1;
+}
+
+unsigned long long LcRenderSnapshotBuffer::GetNumDropped()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return numDropped;
+}
+
+
+void LcRenderThread::Start(LcRenderSnapshotBuffer& inBuffer, TRenderSnapshotHandler handler)
+{
+    if (running) throw std::exception("LcRenderThread::Start(): Thread is already running");
+    if (!handler) throw std::exception("LcRenderThread::Start(): Invalid handler");
+
+    buffer = &inBuffer;
+    buffer->Restart();
+    running = true;
+
+    thread = std::thread([this, handler]() {
+        while (auto snapshot = buffer->Acquire())
+        {
+            try
+            {
+                handler(*snapshot);
+            }
+            catch (...)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    error = std::current_exception();
+                }
+
+                buffer->Release();
+                buffer->Stop();
+                break;
+            }
+
+            buffer->Release();
+        }
+    });
+}
+
+void LcRenderThread::Stop()
+{
+    if (!running) return;
+
+    buffer->Stop();
+    if (thread.joinable()) thread.join();
+
+    running = false;
+}
+
+void LcRenderThread::RethrowError()
+{
+    std::exception_ptr threadError;
+    {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        std::swap(threadError, error);
+    }
+
+    if (threadError)
+    {
+        // join finished thread, so next frame could start it again
+        Stop();
+        std::rethrow_exception(threadError);
+    }
+}
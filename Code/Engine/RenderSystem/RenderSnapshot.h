@@ -0,0 +1,183 @@
+/**
+* RenderSnapshot.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "RenderSystem/Module.h"
+#include "RenderSystem/RenderQueue.h"
+#include "Core/LCTypesEx.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#pragma warning(disable : 4251)
+
+
+/** Draw data of one visual, copied from the world at the end of simulation frame */
+struct LcRenderProxy
+{
+	LcVector3 pos;
+	//
+	LcVector2 size;
+	//
+	float rotZ;
+	// left top, right top, right bottom, left bottom
+	LcVector4 uvs[4];
+	//
+	LcColor4 colors[4];
+	// frame animation data, zero if not animated
+	LcVector4 animData;
+	//
+	LcRenderState state;
+	//
+	int typeId;
+	// number of tiles or particles, 0 for simple quads
+	unsigned int numElements;
+};
+
+
+/** Run of proxies with the same render state */
+struct LcRenderSnapshotBatch
+{
+	size_t firstProxy;
+	//
+	size_t numProxies;
+	//
+	LcRenderState state;
+};
+
+
+/**
+* Render snapshot. Proxies are sorted by render queue, so render thread
+* draws batches in order without access to the world.
+*/
+struct LcRenderSnapshot
+{
+	LcRenderSnapshot() : cameraPos(LcDefaults::ZeroVec3), cameraTarget(LcDefaults::ZeroVec3),
+		worldScale(LcDefaults::OneVec2), frame(0) {}
+	//
+	void Clear() { proxies.clear(); batches.clear(); }
+	//
+	std::vector<LcRenderProxy> proxies;
+	//
+	std::vector<LcRenderSnapshotBatch> batches;
+	//
+	LcVector3 cameraPos;
+	//
+	LcVector3 cameraTarget;
+	//
+	LcVector2 worldScale;
+	//
+	unsigned long long frame;
+};
+
+
+/**
+* Double buffered render snapshot. Writer fills one snapshot while reader draws
+* the other one, so writer is never more than one frame ahead.
+* Published snapshot not acquired by reader yet is replaced by the next one, so reader
+* always draws the latest frame. Replaced snapshots are counted, see GetNumDropped().
+* Writer: BeginWrite(), fill, Publish(). Reader: Acquire(), draw, Release().
+*/
+class RENDERSYSTEM_API LcRenderSnapshotBuffer
+{
+public:
+	LcRenderSnapshotBuffer() : writeIndex(0), pendingIndex(-1), readIndex(-1), stopped(false), numPublished(0), numDropped(0) {}
+	/**
+	* Wait until write snapshot is not used by reader and return it cleared */
+	LcRenderSnapshot& BeginWrite();
+	/**
+	* Pass written snapshot to reader, replaces published snapshot not acquired yet */
+	void Publish();
+	/**
+	* Wait for published snapshot. Returns nullptr when buffer is stopped */
+	const LcRenderSnapshot* Acquire();
+	/**
+	* Return acquired snapshot to writer */
+	void Release();
+	/**
+	* Wait until reader has drawn all published snapshots */
+	void WaitIdle();
+	/**
+	* Wake up and stop reader. Published snapshot is dropped */
+	void Stop();
+	/**
+	* Allow to use buffer after stop */
+	void Restart();
+	/**
+	* Get number of published snapshots replaced before reader acquired them */
+	unsigned long long GetNumDropped();
+
+
+protected:
+	LcRenderSnapshot snapshots[2];
+	//
+	std::mutex mutex;
+	//
+	std::condition_variable condition;
+	//
+	int writeIndex;
+	//
+	int pendingIndex;
+	//
+	int readIndex;
+	//
+	bool stopped;
+	//
+	unsigned long long numPublished;
+	//
+	unsigned long long numDropped;
+
+};
+
+
+/** Render thread snapshot handler */
+typedef std::function<void(const LcRenderSnapshot&)> TRenderSnapshotHandler;
+
+
+/**
+* Render thread. Draws published snapshots with the handler.
+* Handler exception stops drawing, it is rethrown by RethrowError() on the writer thread.
+*/
+class RENDERSYSTEM_API LcRenderThread
+{
+public:
+	LcRenderThread() : buffer(nullptr), running(false) {}
+	//
+	~LcRenderThread() { Stop(); }
+	//
+	LcRenderThread(const LcRenderThread&) = delete;
+	//
+	LcRenderThread& operator=(const LcRenderThread&) = delete;
+	/**
+	* Start thread reading the buffer */
+	void Start(LcRenderSnapshotBuffer& buffer, TRenderSnapshotHandler handler);
+	/**
+	* Stop buffer and join thread */
+	void Stop();
+	/**
+	* Rethrow handler exception on the calling thread. Thread is stopped in this case */
+	void RethrowError();
+	//
+	inline bool IsRunning() const { return running; }
+
+
+protected:
+	std::thread thread;
+	//
+	LcRenderSnapshotBuffer* buffer;
+	//
+	std::exception_ptr error;
+	//
+	std::mutex errorMutex;
+	//
+	bool running;
+
+};
@@ -9,10 +9,19 @@
 #include "World/WorldInterface.h"
 #include "World/SpriteInterface.h"
 #include "GUI/WidgetInterface.h"
-#include "GUI/GuiManager.h"
+#include "GUI/GUIManager.h"
 #include "World/Camera.h"
 #include "Core/LCUtils.h"
 #include "Core/LCException.h"
+#include "Core/LCJobSystem.h"
+
+#include <chrono>
+
+
+static float ElapsedMs(std::chrono::steady_clock::time_point startTime)
+{
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
 
 
 void LcRenderSystemBase::LoadShaders(const char* folderPath)
@@ -43,27 +52,51 @@ void LcRenderSystemBase::Create(void* windowHandle, LcWinMode mode, bool inVSync
     allowFullscreen = inAllowFullscreen;
 }
 
+void LcRenderSystemBase::SetThreadedRender(bool threaded)
+{
+    if (threaded && !SupportsThreadedRender())
+    {
+        throw std::exception("LcRenderSystemBase::SetThreadedRender(): Render system does not support threaded render");
+    }
+
+    threadedRender = threaded;
+    if (!threaded) StopRenderThread();
+}
+
 void LcRenderSystemBase::Update(float deltaSeconds, const LcAppContext& context)
 {
     LC_TRY
 
-    // update visuals
-    const auto& visuals = context.world->GetVisuals();
-    for (const auto& visual : visuals)
+    auto startTime = std::chrono::steady_clock::now();
+
+    // update visuals, structural changes are applied after traversal
+    LcWorldDeferredScope deferredScope(*context.world);
+
+    if (parallelUpdate && context.jobs)
     {
-        if (visual->GetTypeId() == LcCreatables::Widget)
+        UpdateParallel(deltaSeconds, context);
+    }
+    else
+    {
+        const auto& visuals = context.world->GetVisuals();
+        for (const auto& visual : visuals)
         {
-            auto widget = static_cast<IWidget*>(visual.get());
-            if (HasInvisibleParent(widget)) continue;
+            if (visual->GetTypeId() == LcCreatables::Widget)
+            {
+                auto widget = static_cast<IWidget*>(visual.get());
+                if (!widget->IsParentVisible()) continue;
 
-            if (visual->IsVisible()) visual->Update(deltaSeconds, context);
-        }
-        else
-        {
-            if (visual->IsVisible()) visual->Update(deltaSeconds, context);
+                if (visual->IsVisible()) visual->Update(deltaSeconds, context);
+            }
+            else
+            {
+                if (visual->IsVisible()) visual->Update(deltaSeconds, context);
+            }
         }
     }
 
+    deferredScope.Apply();
+
     // update camera
     auto newPos = context.world->GetCamera().GetPosition();
     auto newTarget = context.world->GetCamera().GetTarget();
@@ -75,29 +108,157 @@ void LcRenderSystemBase::Update(float deltaSeconds, const LcAppContext& context)
         cameraTarget = newTarget;
     }
 
+    updateTime = ElapsedMs(startTime);
+
     LC_CATCH{ LC_THROW("LcRenderSystemBase::Update()") }
 }
 
+void LcRenderSystemBase::UpdateParallel(float deltaSeconds, const LcAppContext& context)
+{
+    static const size_t UpdateGrainSize = 256;
+
+    parallelVisuals.clear();
+    serialVisuals.clear();
+
+    for (const auto& visual : context.world->GetVisuals())
+    {
+        if (!visual->IsVisible()) continue;
+        if (visual->GetTypeId() == LcCreatables::Widget && !static_cast<IWidget*>(visual.get())->IsParentVisible()) continue;
+
+        if (visual->CanUpdateInParallel())
+            parallelVisuals.push_back(visual.get());
+        else
+            serialVisuals.push_back(visual.get());
+    }
+
+    context.jobs->ParallelFor(0, parallelVisuals.size(), UpdateGrainSize, [this, deltaSeconds, &context](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            parallelVisuals[i]->Update(deltaSeconds, context);
+        }
+    }, "VisualsUpdate");
+
+    for (auto visual : serialVisuals)
+    {
+        visual->Update(deltaSeconds, context);
+    }
+}
+
 void LcRenderSystemBase::Render(const LcAppContext& context)
 {
     LC_TRY
 
-    const auto& visuals = context.world->GetVisuals();
+    auto startTime = std::chrono::steady_clock::now();
 
-    for (const auto& visual : visuals)
+    // render visuals in camera view
+    visibleVisuals.clear();
+    context.world->GetVisibleVisuals(context.world->GetCameraRect(), visibleVisuals);
+
+    // sort by layer and render state
+    renderQueue.Clear();
+    for (auto visual : visibleVisuals)
     {
-        if (visual->GetTypeId() == LcCreatables::Widget)
-        {
-            auto widget = static_cast<IWidget*>(visual.get());
-            if (HasInvisibleParent(widget)) continue;
+        if (!visual->IsVisible()) continue;
+        if (visual->GetTypeId() == LcCreatables::Widget && !static_cast<IWidget*>(visual)->IsParentVisible()) continue;
 
-            if (visual->IsVisible()) Render(visual.get(), context);
+        renderQueue.Add(visual, visual->GetSlot().bucket, GetRenderState(visual));
+    }
+
+    renderQueue.Sort();
+
+    if (threadedRender && SupportsThreadedRender())
+    {
+        // draw on render thread while next frame is simulated
+        renderThread.RethrowError();
+        if (!renderThread.IsRunning())
+        {
+            renderThread.Start(snapshots, [this](const LcRenderSnapshot& snapshot) {
+                snapshotDrawCalls = RenderSnapshot(snapshot);
+            });
         }
-        else
+
+        auto& snapshot = snapshots.BeginWrite();
+        Extract(context, snapshot);
+        snapshots.Publish();
+
+        renderQueue.AddDrawCalls(snapshotDrawCalls.load());
+    }
+    else
+    {
+        for (auto& batch : renderQueue.GetBatches())
         {
-            if (visual->IsVisible()) Render(visual.get(), context);
+            RenderBatch(batch, context);
         }
     }
 
+    renderTime = ElapsedMs(startTime);
+
     LC_CATCH{ LC_THROW("LcRenderSystemBase::Render()") }
 }
+
+void LcRenderSystemBase::RenderBatch(const LcRenderBatch& batch, const LcAppContext& context)
+{
+    for (size_t i = 0; i < batch.numItems; i++)
+    {
+        Render(batch.items[i].visual, context);
+    }
+
+    renderQueue.AddDrawCalls((int)batch.numItems);
+}
+
+void LcRenderSystemBase::Extract(const LcAppContext& context, LcRenderSnapshot& snapshot) const
+{
+    snapshot.cameraPos = cameraPos;
+    snapshot.cameraTarget = cameraTarget;
+    snapshot.worldScale = context.world->GetWorldScale().GetScale();
+
+    snapshot.proxies.resize(renderQueue.GetItems().size());
+    snapshot.batches.reserve(renderQueue.GetBatches().size());
+
+    size_t proxyIndex = 0;
+    for (auto& batch : renderQueue.GetBatches())
+    {
+        snapshot.batches.push_back(LcRenderSnapshotBatch{ proxyIndex, batch.numItems, batch.GetState() });
+
+        for (size_t i = 0; i < batch.numItems; i++)
+        {
+            ExtractProxy(batch.items[i].visual, batch.items[i].state, snapshot.proxies[proxyIndex++]);
+        }
+    }
+}
+
+void LcRenderSystemBase::ExtractProxy(const IVisual* visual, const LcRenderState& state, LcRenderProxy& outProxy)
+{
+    static const LcVector4 defaultUVs[] = { { 0.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f } };
+
+    outProxy.pos = visual->GetPos();
+    outProxy.size = visual->GetSize();
+    outProxy.rotZ = visual->GetRotZ();
+    outProxy.state = state;
+    outProxy.typeId = visual->GetTypeId();
+    outProxy.animData = LcDefaults::ZeroVec4;
+    outProxy.numElements = 0;
+
+    auto colors = visual->GetColorsComponent();
+    auto tint = visual->GetTintComponent();
+    const LcColor4* colorsData = colors ? (const LcColor4*)colors->GetData() : (tint ? (const LcColor4*)tint->GetData() : nullptr);
+    for (int i = 0; i < 4; i++)
+    {
+        outProxy.colors[i] = colorsData ? colorsData[i] : LcDefaults::White4;
+    }
+
+    const LcVector4* uvsData = defaultUVs;
+    if (outProxy.typeId == LcCreatables::Sprite)
+    {
+        auto sprite = static_cast<const ISprite*>(visual);
+        if (auto customUV = sprite->GetCustomUVComponent()) uvsData = (const LcVector4*)customUV->GetData();
+        if (auto animation = sprite->GetAnimationComponent()) outProxy.animData = animation->GetAnimData();
+        if (auto tiled = sprite->GetTiledComponent()) outProxy.numElements = tiled->GetNumTiles();
+        if (auto particles = sprite->GetParticlesComponent()) outProxy.numElements = (unsigned int)particles->GetNumParticles();
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        outProxy.uvs[i] = uvsData[i];
+    }
+}
@@ -7,12 +7,16 @@
 #pragma once
 
 #include "Module.h"
+#include "RenderSystem/RenderQueue.h"
+#include "RenderSystem/RenderSnapshot.h"
 #include "GUI/Module.h"
 #include "Core/Visual.h"
 #include "Core/LCTypesEx.h"
 #include "Core/LCDelegate.h"
 
 #include <map>
+#include <atomic>
+#include <vector>
 #include <string>
 
 #pragma warning(disable : 4251)
@@ -24,6 +28,12 @@ struct LcRSStats
 	int numTextures;
 	int numTilemaps;
 	int numFonts;
+	//
+	LcRenderQueueStats queue;
+	// CPU time of the last Update() and Render() in milliseconds
+	float updateTime;
+	//
+	float renderTime;
 };
 
 
@@ -48,6 +58,9 @@ public:
 	* Subscribe to world scale delegate */
 	virtual void Subscribe(const LcAppContext& context) = 0;
 	/**
+	* Remove world listeners added by Subscribe(). Called before world is destroyed */
+	virtual void Unsubscribe(const LcAppContext& context) = 0;
+	/**
 	* Update world */
 	virtual void Update(float deltaSeconds, const LcAppContext& context) = 0;
 	/**
@@ -72,6 +85,15 @@ public:
 	* Update camera */
 	virtual void UpdateCamera(float deltaSeconds, LcVector3 newPos, LcVector3 newTarget) = 0;
 	/**
+	* Update visuals on job system workers. Visuals with thread unsafe components
+	* and widgets are updated on the calling thread after them */
+	virtual void SetParallelUpdate(bool parallel) = 0;
+	/**
+	* Draw extracted render snapshot on render thread, while next frame is simulated.
+	* Only render systems with snapshot support (Null) could draw on render thread,
+	* DX10 draws visuals on the calling thread and throws exception */
+	virtual void SetThreadedRender(bool threaded) = 0;
+	/**
 	* Return current stats */
 	virtual LcRSStats GetStats() const = 0;
 	/**
@@ -88,7 +110,13 @@ class RENDERSYSTEM_API LcRenderSystemBase : public IRenderSystem
 public:
 	typedef std::map<std::string, std::string> SHADERS_MAP;
 	//
-	LcRenderSystemBase() : cameraPos(LcDefaults::ZeroVec3), cameraTarget(LcDefaults::ZeroVec3), vSync(true), allowFullscreen(false) {}
+	LcRenderSystemBase() : cameraPos(LcDefaults::ZeroVec3), cameraTarget(LcDefaults::ZeroVec3), updateTime(0.0f), renderTime(0.0f), vSync(true), allowFullscreen(false), parallelUpdate(false), snapshotDrawCalls(0), threadedRender(false) {}
+	/**
+	* Wait until render thread has drawn all extracted frames */
+	void WaitRenderThread() { if (renderThread.IsRunning()) snapshots.WaitIdle(); }
+	/**
+	* Get number of extracted frames replaced by newer ones before render thread has drawn them */
+	unsigned long long GetNumDroppedFrames() { return snapshots.GetNumDropped(); }
 
 
 public:// IRenderSystem interface implementation
@@ -97,10 +125,12 @@ public:// IRenderSystem interface implementation
 	//
 	virtual void Create(void* windowHandle, LcWinMode mode, bool vSync, bool allowFullscreen, const LcAppContext& context) override;
 	//
-	virtual void Shutdown() override {}
+	virtual void Shutdown() override { StopRenderThread(); }
 	//
 	virtual void Subscribe(const LcAppContext& context) {}
 	//
+	virtual void Unsubscribe(const LcAppContext& context) {}
+	//
 	virtual void Update(float deltaSeconds, const LcAppContext& context) override;
 	//
 	virtual void Render(const LcAppContext& context) override;
@@ -110,24 +140,75 @@ public:// IRenderSystem interface implementation
 	virtual void Resize(int width, int height, const LcAppContext& context) override {}
 	//
 	virtual void SetMode(LcWinMode mode) override {}
+	//
+	virtual void SetParallelUpdate(bool parallel) override { parallelUpdate = parallel; }
+	//
+	virtual void SetThreadedRender(bool threaded) override;
 
 
 protected:
+	/**
+	* Update visuals, split to chunks on job system workers */
+	void UpdateParallel(float deltaSeconds, const LcAppContext& context);
 	/**
 	* Render visual */
 	virtual void Render(const class IVisual* visual, const LcAppContext& context) = 0;
+	/**
+	* Get render state used for sorting and batching */
+	virtual LcRenderState GetRenderState(const class IVisual* visual) const { return LcRenderState{ 0, nullptr, 0 }; }
+	/**
+	* Render visuals with the same render state */
+	virtual void RenderBatch(const LcRenderBatch& batch, const LcAppContext& context);
+	/**
+	* Check render snapshot support, see RenderSnapshot() */
+	virtual bool SupportsThreadedRender() const { return false; }
+	/**
+	* Draw snapshot on render thread. Returns number of draw calls */
+	virtual int RenderSnapshot(const LcRenderSnapshot& snapshot) { return 0; }
+	/**
+	* Copy draw data of sorted render queue to snapshot */
+	void Extract(const LcAppContext& context, LcRenderSnapshot& snapshot) const;
+	/**
+	* Copy draw data of the visual */
+	static void ExtractProxy(const class IVisual* visual, const LcRenderState& state, LcRenderProxy& outProxy);
+	//
+	void StopRenderThread() { renderThread.Stop(); }
+	//
+	inline bool IsRenderThreaded() const { return renderThread.IsRunning(); }
 
 
 protected:
 	SHADERS_MAP shaders;
+	// visuals in camera view, reused every frame
+	std::vector<class IVisual*> visibleVisuals;
+	// visuals updated on workers, reused every frame
+	std::vector<class IVisual*> parallelVisuals;
+	// visuals updated on the calling thread, reused every frame
+	std::vector<class IVisual*> serialVisuals;
+	//
+	LcRenderQueue renderQueue;
 	//
 	LcVector3 cameraPos;
 	//
 	LcVector3 cameraTarget;
+	// CPU time of the last update in milliseconds
+	float updateTime;
+	// CPU time of the last render in milliseconds
+	float renderTime;
 	// allow true fullscreen mode
 	bool allowFullscreen;
 	//
 	bool vSync;
+	//
+	bool parallelUpdate;
+	//
+	LcRenderSnapshotBuffer snapshots;
+	//
+	LcRenderThread renderThread;
+	// draw calls of the last frame drawn on render thread
+	std::atomic<int> snapshotDrawCalls;
+	//
+	bool threadedRender;
 
 };
 
@@ -144,7 +225,7 @@ public:
 	* Render sprite */
 	virtual void Render(const class IVisual* visual, const LcAppContext& context) = 0;
 	/**
-	* Checks support for the feature */
-	virtual bool Supports(const TVFeaturesList& features) const = 0;
+	* Checks support for the visual features mask */
+	virtual bool Supports(TVFeatureMask features) const = 0;
 
 };
@@ -162,13 +162,7 @@ void LcAnimatedSpriteRenderDX10::Render(const IVisual* visual, const LcAppContex
 	d3dDevice->Draw(4, 0);
 }
 
-bool LcAnimatedSpriteRenderDX10::Supports(const TVFeaturesList& features) const
+bool LcAnimatedSpriteRenderDX10::Supports(TVFeatureMask features) const
 {
-	bool needAnimation = false, needTiles = false;
-	for (auto& feature : features)
-	{
-		needAnimation |= (feature == LcComponents::FrameAnimation);
-		needTiles |= (feature == LcComponents::Tiled);
-	}
-	return !needTiles && needAnimation;
+	return (features & ToFeatureBit(LcComponents::Tiled)) == 0 && (features & ToFeatureBit(LcComponents::FrameAnimation)) != 0;
 }
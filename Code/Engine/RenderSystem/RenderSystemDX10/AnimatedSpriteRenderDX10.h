@@ -27,7 +27,7 @@ public:// IVisual2DRender interface implementation
 	//
 	virtual void Render(const IVisual* visual, const LcAppContext& context) override;
 	//
-	virtual bool Supports(const TVFeaturesList& features) const override;
+	virtual bool Supports(TVFeatureMask features) const override;
 
 
 protected:
@@ -8,7 +8,7 @@
 #include "RenderSystem/RenderSystemDX10/BasicParticlesRenderDX10.h"
 #include "RenderSystem/RenderSystemDX10/RenderSystemDX10.h"
 #include "RenderSystem/RenderSystemDX10/VisualsDX10.h"
-#include "Core/LcUtils.h"
+#include "Core/LCUtils.h"
 
 
 static const char* basicParticlesShaderName = "BasicParticles2d.shader";
@@ -244,15 +244,9 @@ void LcBasicParticlesRenderDX10::Render(const IVisual* visual, const LcAppContex
 	d3dDevice->Draw(vbIt->second.vertexCount, 0);
 }
 
-bool LcBasicParticlesRenderDX10::Supports(const TVFeaturesList& features) const
+bool LcBasicParticlesRenderDX10::Supports(TVFeatureMask features) const
 {
-	bool needTexture = false, needAnimation = false, needTiles = false, needBasicParticles = false;
-	for (auto& feature : features)
-	{
-		needTexture |= (feature == LcComponents::Texture);
-		needAnimation |= (feature == LcComponents::FrameAnimation);
-		needTiles |= (feature == LcComponents::Tiled);
-		needBasicParticles |= (feature == LcComponents::Particles);
-	}
-	return !needAnimation && !needTiles && needTexture && needBasicParticles;
+	const TVFeatureMask excluded = ToFeatureBit(LcComponents::FrameAnimation) | ToFeatureBit(LcComponents::Tiled);
+	const TVFeatureMask required = ToFeatureBit(LcComponents::Texture) | ToFeatureBit(LcComponents::Particles);
+	return (features & excluded) == 0 && (features & required) == required;
 }
@@ -145,14 +145,8 @@ void LcColoredSpriteRenderDX10::Render(const IVisual* visual, const LcAppContext
 	d3dDevice->Draw(4, 0);
 }
 
-bool LcColoredSpriteRenderDX10::Supports(const TVFeaturesList& features) const
+bool LcColoredSpriteRenderDX10::Supports(TVFeatureMask features) const
 {
-	bool needTexture = false, needAnimation = false, needTiles = false;
-	for (auto& feature : features)
-	{
-		needTexture |= (feature == LcComponents::Texture);
-		needAnimation |= (feature == LcComponents::FrameAnimation);
-		needTiles |= (feature == LcComponents::Tiled);
-	}
-	return !needTiles && !needAnimation && !needTexture;
+	const TVFeatureMask excluded = ToFeatureBit(LcComponents::Texture) | ToFeatureBit(LcComponents::FrameAnimation) | ToFeatureBit(LcComponents::Tiled);
+	return (features & excluded) == 0;
 }
@@ -17,44 +17,45 @@
 #include "World/SpriteInterface.h"
 #include "World/World.h"
 #include "World/Camera.h"
-#include "GUI/GuiManager.h"
+#include "GUI/GUIManager.h"
 #include "Core/LCException.h"
 
 
-class LcVisual2DLifetimeStrategyDX10 : public LcLifetimeStrategy<IVisual, IWorld::TVisualSet>
+class LcVisual2DLifetimeStrategyDX10 : public LcVisualPoolStrategy
 {
 public:
-	LcVisual2DLifetimeStrategyDX10() {}
+	LcVisual2DLifetimeStrategyDX10(const LcAppContext& inContext) : LcVisualPoolStrategy(inContext) {}
 	//
 	virtual ~LcVisual2DLifetimeStrategyDX10() {}
 	//
-	virtual std::shared_ptr<IVisual> Create(const void* userData) override
-	{
-		auto layerPtr = static_cast<const float*>(userData);
-		std::shared_ptr<IVisual> newVisual;
+	virtual void Destroy(IVisual& item, IWorld::TVisualSet& items) override {}
+
 
-		switch (curTypeId)
+protected: // LcVisualPoolStrategy interface implementation
+	//
+	virtual std::shared_ptr<IVisual> NewVisual(int typeId) override
+	{
+		switch (typeId)
 		{
-		case LcCreatables::Sprite: newVisual = std::make_shared<LcSpriteDX10>(); break;
-		case LcCreatables::Widget: newVisual = std::make_shared<LcWidgetDX10>(); break;
+		case LcCreatables::Sprite: return std::make_shared<LcSpriteDX10>();
+		case LcCreatables::Widget: return std::make_shared<LcWidgetDX10>();
 		}
 
-		// add layer Z for initial valid sorting in multiset
-		newVisual->SetPos(LcVector3{ 0.0f, 0.0f, *layerPtr });
-
-		return newVisual;
+		return std::shared_ptr<IVisual>();
 	}
-	//
-	virtual void Destroy(IVisual& item, IWorld::TVisualSet& items) override {}
 };
 
 
 LcRenderSystemDX10::LcRenderSystemDX10()
 	: tiledRender(nullptr)
+	, particlesRender(nullptr)
 	, textureRender(nullptr)
+	, scaleListener(LcInvalidHandle)
+	, tintListener(LcInvalidHandle)
 	, renderSystemSize{ 0, 0 }
 	, worldScale{ 1.0f, 1.0f, 1.0f }
 	, worldScaleFonts(false)
+	, prevPipeline(-1)
 	, prevSetupRequested(false)
 {
 }
@@ -175,8 +176,9 @@ void LcRenderSystemDX10::Create(void* windowHandle, LcWinMode winMode, bool inVS
 	textureRender = static_cast<IVisual2DRender*>(visual2DRenders.back().get());
 	visual2DRenders.push_back(std::make_shared<LcAnimatedSpriteRenderDX10>(context));
 	visual2DRenders.push_back(std::make_shared<LcTiledVisual2DRenderDX10>(context));
-	visual2DRenders.push_back(std::make_shared<LcBasicParticlesRenderDX10>(context));
 	tiledRender = static_cast<LcTiledVisual2DRenderDX10*>(visual2DRenders.back().get());
+	visual2DRenders.push_back(std::make_shared<LcBasicParticlesRenderDX10>(context));
+	particlesRender = static_cast<LcBasicParticlesRenderDX10*>(visual2DRenders.back().get());
 	visual2DRenders.front()->Setup(nullptr, context);
 
 	// add widget render
@@ -193,7 +195,7 @@ void LcRenderSystemDX10::Create(void* windowHandle, LcWinMode winMode, bool inVS
 
 	// add factory
 	LcWorld& worldRef = static_cast<LcWorld&>(*context.world);
-	worldRef.SetLifetimeStrategy(std::make_shared<LcVisual2DLifetimeStrategyDX10>());
+	worldRef.SetLifetimeStrategy(std::make_shared<LcVisual2DLifetimeStrategyDX10>(context));
 
 	// init render system
 	LcRenderSystemBase::Create(this, winMode, inVSync, inAllowFullscreen, context);
@@ -227,6 +229,7 @@ void LcRenderSystemDX10::Clear(IWorld* world, bool removeRooted)
 	{
 		texLoader->RemoveTextures();
 		if (tiledRender) tiledRender->RemoveTiles();
+		if (particlesRender) particlesRender->RemoveTiles();
 		if (textRender) textRender->RemoveFonts();
 	}
 	else
@@ -241,7 +244,10 @@ void LcRenderSystemDX10::Subscribe(const LcAppContext& context)
 {
 	auto contextPtr = &context;
 
-	context.world->GetWorldScale().onScaleChanged.AddListener([this, contextPtr](LcVector2 newScale)
+	// repeated subscription replaces listeners
+	Unsubscribe(context);
+
+	scaleListener = context.world->GetWorldScale().onScaleChanged.AddListener([this, contextPtr](LcVector2 newScale)
 	{
 		LC_TRY
 
@@ -263,7 +269,7 @@ void LcRenderSystemDX10::Subscribe(const LcAppContext& context)
 		LC_CATCH{ LC_THROW("LcRenderSystemDX10::worldScaleUpdated()") }
 	});
 
-	context.world->onTintChanged.AddListener([this](LcColor3 globalTint)
+	tintListener = context.world->onTintChanged.AddListener([this](LcColor3 globalTint)
 	{
 		if (constBuffers.settingsBuffer)
 		{
@@ -274,6 +280,17 @@ void LcRenderSystemDX10::Subscribe(const LcAppContext& context)
 	});
 }
 
+void LcRenderSystemDX10::Unsubscribe(const LcAppContext& context)
+{
+	if (!context.world) return;
+
+	context.world->GetWorldScale().onScaleChanged.RemoveListener(scaleListener);
+	context.world->onTintChanged.RemoveListener(tintListener);
+
+	scaleListener = LcInvalidHandle;
+	tintListener = LcInvalidHandle;
+}
+
 void LcRenderSystemDX10::Update(float deltaSeconds, const LcAppContext& context)
 {
 	LcRenderSystemBase::Update(deltaSeconds, context);
@@ -297,6 +314,7 @@ void LcRenderSystemDX10::Render(const LcAppContext& context)
 	LcColor4 color{ 0.0f, 0.0f, 1.0f, 0.0f };
 	d3dDevice->ClearRenderTargetView(renderTargetView.Get(), (FLOAT*)&color);
 
+	prevPipeline = -1;
 	LcRenderSystemBase::Render(context);
 
 	swapChain->Present(vSync ? DXGI_SWAP_EFFECT_SEQUENTIAL : DXGI_SWAP_EFFECT_DISCARD, 0);
@@ -397,7 +415,10 @@ LcRSStats LcRenderSystemDX10::GetStats() const
 	return LcRSStats{
 		texLoader->GetNumTextures(),
 		tiledRender ? tiledRender->GetNumTiles() : 0,
-		textRender ? textRender->GetNumFonts() : 0
+		textRender ? textRender->GetNumFonts() : 0,
+		renderQueue.GetStats(),
+		updateTime,
+		renderTime
 	};
 }
 
@@ -407,23 +428,85 @@ void LcRenderSystemDX10::Render(const IVisual* visual, const LcAppContext& conte
 
 	if (!visual) throw std::exception("LcRenderSystemDX10::Render(): Invalid visual");
 
-	for (auto& render : visual2DRenders)
+	LcRenderItem item{ 0, visual, GetRenderState(visual) };
+	RenderBatch(LcRenderBatch{ &item, 1 }, context);
+
+	LC_CATCH{ LC_THROW("LcRenderSystemDX10::Render()") }
+}
+
+LcRenderState LcRenderSystemDX10::GetRenderState(const IVisual* visual) const
+{
+	LcRenderState state{ visual->GetRenderPipeline(), nullptr, 0 };
+
+	if (state.pipeline == LcUnresolvedPipeline)
 	{
-		if (render->Supports(visual->GetFeaturesList()))
+		// resolve once after components change
+		state.pipeline = -1;
+		for (int i = 0; i < (int)visual2DRenders.size(); i++)
 		{
-			if (prevSpriteFeatures != visual->GetFeaturesList() || prevSetupRequested)
+			if (visual2DRenders[i]->Supports(visual->GetFeatureMask()))
 			{
-				prevSetupRequested = false;
-				prevSpriteFeatures = visual->GetFeaturesList();
-				render->Setup(visual, context);
+				state.pipeline = i;
+				break;
 			}
+		}
 
-			render->Render(visual, context);
-			break;
+		visual->SetRenderPipeline(state.pipeline);
+	}
+
+	if (visual->HasComponent(LcComponents::Texture))
+	{
+		if (visual->GetTypeId() == LcCreatables::Sprite) state.texture = static_cast<const LcSpriteDX10*>(visual)->textureSV;
+		if (visual->GetTypeId() == LcCreatables::Widget) state.texture = static_cast<const LcWidgetDX10*>(visual)->spriteTextureSV;
+	}
+
+	return state;
+}
+
+void LcRenderSystemDX10::RenderBatch(const LcRenderBatch& batch, const LcAppContext& context)
+{
+	LC_TRY
+
+	int pipeline = batch.GetState().pipeline;
+	if (pipeline < 0 || pipeline >= (int)visual2DRenders.size()) return;
+
+	auto& render = visual2DRenders[pipeline];
+	auto spriteBatchRender = (render.get() == textureRender) ? static_cast<LcTexturedVisual2DRenderDX10*>(textureRender) : nullptr;
+	int numDrawCalls = 0;
+
+	for (size_t i = 0; i < batch.numItems; i++)
+	{
+		auto visual = batch.items[i].visual;
+
+		if (spriteBatchRender && visual->GetTypeId() == LcCreatables::Sprite)
+		{
+			// textured sprites are merged by sprite batcher, widgets are drawn one by one
+			size_t numSprites = 1;
+			while (i + numSprites < batch.numItems && batch.items[i + numSprites].visual->GetTypeId() == LcCreatables::Sprite) numSprites++;
+
+			numDrawCalls += spriteBatchRender->RenderSprites(&batch.items[i], numSprites, context);
+			prevPipeline = -1;
+			i += numSprites - 1;
+			continue;
 		}
+
+		// particles and tiles request setup for every visual
+		if (prevPipeline != pipeline || prevSetupRequested)
+		{
+			prevSetupRequested = false;
+			prevPipeline = pipeline;
+			render->Setup(visual, context);
+		}
+
+		render->Render(visual, context);
+
+		numDrawCalls++;
+		if (visual->GetTypeId() == LcCreatables::Widget && static_cast<const LcWidgetDX10*>(visual)->textTextureSV) numDrawCalls++;
 	}
 
-	LC_CATCH{ LC_THROW("LcRenderSystemDX10::Render()") }
+	renderQueue.AddDrawCalls(numDrawCalls);
+
+	LC_CATCH{ LC_THROW("LcRenderSystemDX10::RenderBatch()") }
 }
 
 std::string LcRenderSystemDX10::GetShaderCode(const std::string& shaderName) const
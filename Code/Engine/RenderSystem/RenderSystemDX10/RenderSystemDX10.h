@@ -52,7 +52,7 @@ public:
 
 
 /**
-* DirectX 10 render system */
+* DirectX 10 render system. Draws visuals on the calling thread, threaded render is not supported */
 class RENDERSYSTEMDX10_API LcRenderSystemDX10
 	: public LcRenderSystemBase
 	, public IRenderDeviceDX10
@@ -66,6 +66,8 @@ public:
 	//
 	class LcTiledVisual2DRenderDX10* GetTiledRender() { return tiledRender; }
 	//
+	class LcBasicParticlesRenderDX10* GetParticlesRender() { return particlesRender; }
+	//
 	class IVisual2DRender* GetTextureRender() { return textureRender; }
 
 
@@ -81,6 +83,8 @@ public:// IRenderSystem interface implementation
 	//
 	virtual void Subscribe(const LcAppContext& context);
 	//
+	virtual void Unsubscribe(const LcAppContext& context);
+	//
 	virtual void Update(float deltaSeconds, const LcAppContext& context) override;
 	//
 	virtual void UpdateCamera(float deltaSeconds, LcVector3 newPos, LcVector3 newTarget) override;
@@ -103,6 +107,10 @@ public:// IRenderSystem interface implementation
 protected:// LcRenderSystemBase interface implementation
 	//
 	virtual void Render(const IVisual* visual, const LcAppContext& context) override;
+	//
+	virtual LcRenderState GetRenderState(const IVisual* visual) const override;
+	//
+	virtual void RenderBatch(const LcRenderBatch& batch, const LcAppContext& context) override;
 
 
 public:// IDX10RenderDevice interface implementation
@@ -141,9 +149,15 @@ protected:
 	//
 	class LcTiledVisual2DRenderDX10* tiledRender;
 	//
+	class LcBasicParticlesRenderDX10* particlesRender;
+	//
 	class IVisual2DRender* textureRender;
 	//
-	TVFeaturesList prevSpriteFeatures;
+	LcDelegateHandle scaleListener;
+	//
+	LcDelegateHandle tintListener;
+	//
+	int prevPipeline;
 	//
 	LcSize renderSystemSize;
 	//
@@ -120,6 +120,10 @@ LcTextRenderDX10::~LcTextRenderDX10()
 
 void LcTextRenderDX10::Shutdown()
 {
+    if (localization) localization->onCultureChanged.RemoveListener(cultureListener);
+    localization = nullptr;
+    cultureListener = LcInvalidHandle;
+
     dwriteFactory.Reset();
     d2dFactory.Reset();
 }
@@ -151,7 +155,9 @@ void LcTextRenderDX10::Init(const LcAppContext& context)
         throw std::exception("LcTextRenderDX10::Init(): Cannot create DirectWrite factory");
     }
 
-    context.text->onCultureChanged.AddListener([this](std::string newCulture, const LcAppContext& context) {
+    // Init() is called again on resize, Shutdown() above removed previous listener
+    localization = context.text;
+    cultureListener = localization->onCultureChanged.AddListener([this](std::string newCulture, const LcAppContext& context) {
         CultureChangedHandler(newCulture, context);
     });
 
@@ -16,6 +16,7 @@
 
 #include "Core/LCTypesEx.h"
 #include "Core/Visual.h"
+#include "Core/LCDelegate.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -35,7 +36,7 @@ public:
 class LcTextRenderDX10
 {
 public:
-	LcTextRenderDX10(float inDpi) : dpi(inDpi), features{ LcComponents::Texture } {}
+	LcTextRenderDX10(float inDpi) : dpi(inDpi), features{ LcComponents::Texture }, localization(nullptr), cultureListener(LcInvalidHandle) {}
 	//
 	~LcTextRenderDX10();
 	//
@@ -69,6 +70,10 @@ protected:
 	ComPtr<IDWriteFactory> dwriteFactory;
 	//
 	std::map<std::wstring, std::shared_ptr<ITextFont>> fonts;
+	// culture listener owner, it outlives render system
+	class ILocalizationManager* localization;
+	//
+	LcDelegateHandle cultureListener;
 	//
 	float dpi;
 
@@ -11,6 +11,7 @@
 
 
 static const char* texturedSpriteShaderName = "TexturedSprite2d.shader";
+static const char* spriteBatchShaderName = "SpriteBatch2d.shader";
 struct DX10TEXTUREDSPRITEDATA
 {
 	LcVector3 pos;		// position
@@ -23,6 +24,13 @@ LcTexturedVisual2DRenderDX10::LcTexturedVisual2DRenderDX10(const LcAppContext& c
 	ps = nullptr;
 	vertexBuffer = nullptr;
 	vertexLayout = nullptr;
+	batchVertexBuffer = nullptr;
+	batchIndexBuffer = nullptr;
+	batchVertexLayout = nullptr;
+	batchVS = nullptr;
+	batchPS = nullptr;
+	boundTexture = nullptr;
+	textureBound = false;
 
 	auto render = static_cast<LcRenderSystemDX10*>(context.render);
 	auto d3dDevice = render ? render->GetD3D10Device() : nullptr;
@@ -83,6 +91,73 @@ LcTexturedVisual2DRenderDX10::LcTexturedVisual2DRenderDX10(const LcAppContext& c
 	vertices[2] = DX10TEXTUREDSPRITEDATA{ LcVector3{ -0.5, 0.5, 0 }, 0 };
 	vertices[3] = DX10TEXTUREDSPRITEDATA{ LcVector3{ -0.5,-0.5, 0 }, 3 };
 	vertexBuffer->Unmap();
+
+	// create sprite batch shaders
+	auto batchShaderCode = render->GetShaderCode(spriteBatchShaderName);
+
+	ComPtr<ID3D10Blob> batchVertexBlob;
+	if (FAILED(D3D10CompileShader(batchShaderCode.c_str(), batchShaderCode.length(), NULL, NULL, NULL, "VShader", "vs_4_0", 0, batchVertexBlob.GetAddressOf(), NULL)))
+	{
+		throw std::exception("LcTexturedVisual2DRenderDX10(): Cannot compile batch vertex shader");
+	}
+
+	if (FAILED(d3dDevice->CreateVertexShader((DWORD*)batchVertexBlob->GetBufferPointer(), batchVertexBlob->GetBufferSize(), &batchVS)))
+	{
+		throw std::exception("LcTexturedVisual2DRenderDX10(): Cannot create batch vertex shader");
+	}
+
+	ComPtr<ID3D10Blob> batchPixelBlob;
+	if (FAILED(D3D10CompileShader(batchShaderCode.c_str(), batchShaderCode.length(), NULL, NULL, NULL, "PShader", "ps_4_0", 0, batchPixelBlob.GetAddressOf(), NULL)))
+	{
+		throw std::exception("LcTexturedVisual2DRenderDX10(): Cannot compile batch pixel shader");
+	}
+
+	if (FAILED(d3dDevice->CreatePixelShader((DWORD*)batchPixelBlob->GetBufferPointer(), batchPixelBlob->GetBufferSize(), &batchPS)))
+	{
+		throw std::exception("LcTexturedVisual2DRenderDX10(): Cannot create batch pixel shader");
+	}
+
+	D3D10_INPUT_ELEMENT_DESC batchLayout[] =
+	{
+		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 0,  D3D10_INPUT_PER_VERTEX_DATA, 0},
+		{"COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D10_INPUT_PER_VERTEX_DATA, 0},
+		{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,       0, 28, D3D10_INPUT_PER_VERTEX_DATA, 0}
+	};
+
+	if (FAILED(d3dDevice->CreateInputLayout(batchLayout, 3, batchVertexBlob->GetBufferPointer(), batchVertexBlob->GetBufferSize(), &batchVertexLayout)))
+	{
+		throw std::exception("LcTexturedVisual2DRenderDX10(): Cannot create batch input layout");
+	}
+
+	// create ring vertex buffer
+	D3D10_BUFFER_DESC batchBufferDesc;
+	batchBufferDesc.Usage = D3D10_USAGE_DYNAMIC;
+	batchBufferDesc.ByteWidth = sizeof(LcSpriteVertex) * LcSpriteBatcher::VerticesPerQuad * batcher.GetMaxQuads();
+	batchBufferDesc.BindFlags = D3D10_BIND_VERTEX_BUFFER;
+	batchBufferDesc.CPUAccessFlags = D3D10_CPU_ACCESS_WRITE;
+	batchBufferDesc.MiscFlags = 0;
+	if (FAILED(d3dDevice->CreateBuffer(&batchBufferDesc, NULL, &batchVertexBuffer)))
+	{
+		throw std::exception("LcTexturedVisual2DRenderDX10(): Cannot create batch vertex buffer");
+	}
+
+	// create shared index buffer
+	std::vector<unsigned short> indices;
+	LcSpriteBatcher::MakeIndices(batcher.GetMaxQuads(), indices);
+
+	D3D10_BUFFER_DESC indexBufferDesc;
+	indexBufferDesc.Usage = D3D10_USAGE_IMMUTABLE;
+	indexBufferDesc.ByteWidth = (UINT)(sizeof(unsigned short) * indices.size());
+	indexBufferDesc.BindFlags = D3D10_BIND_INDEX_BUFFER;
+	indexBufferDesc.CPUAccessFlags = 0;
+	indexBufferDesc.MiscFlags = 0;
+
+	D3D10_SUBRESOURCE_DATA indexData{};
+	indexData.pSysMem = indices.data();
+	if (FAILED(d3dDevice->CreateBuffer(&indexBufferDesc, &indexData, &batchIndexBuffer)))
+	{
+		throw std::exception("LcTexturedVisual2DRenderDX10(): Cannot create batch index buffer");
+	}
 }
 
 LcTexturedVisual2DRenderDX10::~LcTexturedVisual2DRenderDX10()
@@ -91,6 +166,11 @@ LcTexturedVisual2DRenderDX10::~LcTexturedVisual2DRenderDX10()
 	if (vertexLayout) { vertexLayout->Release(); vertexLayout = nullptr; }
 	if (vs) { vs->Release(); vs = nullptr; }
 	if (ps) { ps->Release(); ps = nullptr; }
+	if (batchVertexBuffer) { batchVertexBuffer->Release(); batchVertexBuffer = nullptr; }
+	if (batchIndexBuffer) { batchIndexBuffer->Release(); batchIndexBuffer = nullptr; }
+	if (batchVertexLayout) { batchVertexLayout->Release(); batchVertexLayout = nullptr; }
+	if (batchVS) { batchVS->Release(); batchVS = nullptr; }
+	if (batchPS) { batchPS->Release(); batchPS = nullptr; }
 }
 
 void LcTexturedVisual2DRenderDX10::Setup(const IVisual* visual, const LcAppContext& context)
@@ -107,6 +187,9 @@ void LcTexturedVisual2DRenderDX10::Setup(const IVisual* visual, const LcAppConte
 	UINT offset = 0;
 	d3dDevice->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
 	d3dDevice->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+
+	// other renders could change texture
+	textureBound = false;
 }
 
 void LcTexturedVisual2DRenderDX10::Render(const IVisual* visual, const LcAppContext& context)
@@ -155,7 +238,7 @@ void LcTexturedVisual2DRenderDX10::Render(const IVisual* visual, const LcAppCont
 		if (sprite->HasComponent(LcComponents::Texture))
 		{
 			const LcSpriteDX10* spriteDX10 = (LcSpriteDX10*)sprite;
-			d3dDevice->PSSetShaderResources(0, 1, (ID3D10ShaderResourceView**)&spriteDX10->textureSV);
+			BindTexture(d3dDevice, spriteDX10->textureSV);
 			flags.bHasTexture = TRUE;
 		}
 
@@ -207,13 +290,12 @@ void LcTexturedVisual2DRenderDX10::Render(const IVisual* visual, const LcAppCont
 		auto widgetDX10 = static_cast<const LcWidgetDX10*>(widget);
 		if (widget->HasComponent(LcComponents::Texture))
 		{
-			d3dDevice->PSSetShaderResources(0, 1, (ID3D10ShaderResourceView**)&widgetDX10->spriteTextureSV);
+			BindTexture(d3dDevice, widgetDX10->spriteTextureSV);
 			flags.bHasTexture = TRUE;
 		}
 		else
 		{
-			ID3D10ShaderResourceView* nullSRV[1] = { nullptr };
-			d3dDevice->PSSetShaderResources(0, 1, nullSRV);
+			BindTexture(d3dDevice, nullptr);
 		}
 
 		d3dDevice->UpdateSubresource(flagsBuffer, 0, NULL, &flags, 0, 0);
@@ -232,7 +314,7 @@ void LcTexturedVisual2DRenderDX10::Render(const IVisual* visual, const LcAppCont
 		if (widgetDX10->textTextureSV)
 		{
 			// set text texture
-			d3dDevice->PSSetShaderResources(0, 1, (ID3D10ShaderResourceView**)widgetDX10->textTextureSV.GetAddressOf());
+			BindTexture(d3dDevice, widgetDX10->textTextureSV.Get());
 			flags.bHasTexture = TRUE;
 
 			static LcVector4 defaultUVs[] = { To4(LcVector2{ 0.0, 0.0 }), To4(LcVector2{ 1.0, 0.0 }), To4(LcVector2{ 1.0, 1.0 }), To4(LcVector2{ 0.0, 1.0 }) };
@@ -251,15 +333,78 @@ void LcTexturedVisual2DRenderDX10::Render(const IVisual* visual, const LcAppCont
 	}
 }
 
-bool LcTexturedVisual2DRenderDX10::Supports(const TVFeaturesList& features) const
+int LcTexturedVisual2DRenderDX10::RenderSprites(const LcRenderItem* items, size_t numItems, const LcAppContext& context)
 {
-	bool needTexture = false, needAnimation = false, needTiles = false, needBasicParticles = false;
-	for (auto& feature : features)
+	auto render = static_cast<LcRenderSystemDX10*>(context.render);
+	auto d3dDevice = render ? render->GetD3D10Device() : nullptr;
+	if (!d3dDevice || !items) throw std::exception("LcTexturedVisual2DRenderDX10::RenderSprites(): Invalid render params");
+
+	// setup batch pipeline
+	d3dDevice->VSSetShader(batchVS);
+	d3dDevice->PSSetShader(batchPS);
+	d3dDevice->IASetInputLayout(batchVertexLayout);
+
+	UINT stride = sizeof(LcSpriteVertex);
+	UINT offset = 0;
+	d3dDevice->IASetVertexBuffers(0, 1, &batchVertexBuffer, &stride, &offset);
+	d3dDevice->IASetIndexBuffer(batchIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
+	d3dDevice->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	// all sprites in the run have the same texture
+	auto firstSprite = static_cast<const LcSpriteDX10*>(items[0].visual);
+	textureBound = false;
+	BindTexture(d3dDevice, firstSprite->textureSV);
+
+	int numDrawCalls = 0;
+	batcher.Begin(context.world->GetWorldScale().GetScale());
+
+	for (size_t i = 0; i < numItems; i++)
 	{
-		needTexture |= (feature == LcComponents::Texture);
-		needAnimation |= (feature == LcComponents::FrameAnimation);
-		needTiles |= (feature == LcComponents::Tiled);
-		needBasicParticles |= (feature == LcComponents::Particles);
+		batcher.Add(*static_cast<const ISprite*>(items[i].visual));
+
+		if (batcher.GetNumQuads() == batcher.GetMaxQuads()) numDrawCalls += FlushSprites(d3dDevice);
 	}
-	return !needAnimation && !needTiles && !needBasicParticles && needTexture;
+
+	numDrawCalls += FlushSprites(d3dDevice);
+	return numDrawCalls;
+}
+
+int LcTexturedVisual2DRenderDX10::FlushSprites(ID3D10Device1* d3dDevice)
+{
+	unsigned int numQuads = batcher.GetNumQuads();
+	if (numQuads == 0) return 0;
+
+	bool discard = false;
+	unsigned int firstQuad = batcher.Allocate(numQuads, discard);
+
+	// append to ring buffer, discard it only on wrap
+	LcSpriteVertex* vertices = nullptr;
+	if (FAILED(batchVertexBuffer->Map(discard ? D3D10_MAP_WRITE_DISCARD : D3D10_MAP_WRITE_NO_OVERWRITE, 0, (void**)&vertices)))
+	{
+		throw std::exception("LcTexturedVisual2DRenderDX10::FlushSprites(): Cannot map vertex buffer");
+	}
+
+	memcpy(vertices + firstQuad * LcSpriteBatcher::VerticesPerQuad, batcher.GetVertices(), sizeof(LcSpriteVertex) * LcSpriteBatcher::VerticesPerQuad * numQuads);
+	batchVertexBuffer->Unmap();
+
+	d3dDevice->DrawIndexed(numQuads * LcSpriteBatcher::IndicesPerQuad, 0, firstQuad * LcSpriteBatcher::VerticesPerQuad);
+
+	batcher.Begin(batcher.GetWorldScale());
+	return 1;
+}
+
+void LcTexturedVisual2DRenderDX10::BindTexture(ID3D10Device1* d3dDevice, ID3D10ShaderResourceView* texture)
+{
+	// skip redundant binding for sorted visuals with the same texture
+	if (textureBound && boundTexture == texture) return;
+
+	d3dDevice->PSSetShaderResources(0, 1, &texture);
+	boundTexture = texture;
+	textureBound = true;
+}
+
+bool LcTexturedVisual2DRenderDX10::Supports(TVFeatureMask features) const
+{
+	const TVFeatureMask excluded = ToFeatureBit(LcComponents::FrameAnimation) | ToFeatureBit(LcComponents::Tiled) | ToFeatureBit(LcComponents::Particles);
+	return (features & excluded) == 0 && (features & ToFeatureBit(LcComponents::Texture)) != 0;
 }
@@ -8,6 +8,7 @@
 
 #include "Core/LCTypes.h"
 #include "RenderSystem/RenderSystemDX10/RenderSystemDX10.h"
+#include "RenderSystem/SpriteBatcher.h"
 
 
 /**
@@ -29,7 +30,21 @@ public:// IVisual2DRender interface implementation
 	//
 	virtual void Render(const IVisual* visual, const LcAppContext& context) override;
 	//
-	virtual bool Supports(const TVFeaturesList& features) const override;
+	virtual bool Supports(TVFeatureMask features) const override;
+
+
+public:
+	/**
+	* Render textured sprites with the same texture through sprite batcher.
+	* Changes render state, returns number of draw calls */
+	int RenderSprites(const LcRenderItem* items, size_t numItems, const LcAppContext& context);
+
+
+protected:
+	//
+	void BindTexture(ID3D10Device1* d3dDevice, ID3D10ShaderResourceView* texture);
+	//
+	int FlushSprites(ID3D10Device1* d3dDevice);
 
 
 protected:
@@ -41,5 +56,21 @@ protected:
 	ID3D10VertexShader* vs;
 	//
 	ID3D10PixelShader* ps;
+	//
+	ID3D10Buffer* batchVertexBuffer;
+	//
+	ID3D10Buffer* batchIndexBuffer;
+	//
+	ID3D10InputLayout* batchVertexLayout;
+	//
+	ID3D10VertexShader* batchVS;
+	//
+	ID3D10PixelShader* batchPS;
+	//
+	LcSpriteBatcher batcher;
+	//
+	ID3D10ShaderResourceView* boundTexture;
+	//
+	bool textureBound;
 
 };
@@ -8,10 +8,13 @@
 #include "RenderSystem/RenderSystemDX10/TiledVisual2DRenderDX10.h"
 #include "RenderSystem/RenderSystemDX10/RenderSystemDX10.h"
 #include "RenderSystem/RenderSystemDX10/VisualsDX10.h"
+#include "RenderSystem/SpriteBatcher.h"
 #include "Core/LCException.h"
 
 
 static const char* tiledSpriteShaderName = "TiledSprite2d.shader";
+// 16-bit indices address 65536 vertices, bigger ranges are split to several draws
+static const unsigned int maxQuadsPerDraw = 0x10000 / LcSpriteBatcher::VerticesPerQuad;
 struct DX10TILEDSPRITEDATA
 {
 	LcVector3 pos;		// position
@@ -23,6 +26,7 @@ LcTiledVisual2DRenderDX10::LcTiledVisual2DRenderDX10(const LcAppContext& context
 	vs = nullptr;
 	ps = nullptr;
 	vertexLayout = nullptr;
+	indexBuffer = nullptr;
 
 	auto render = static_cast<LcRenderSystemDX10*>(context.render);
 	auto d3dDevice = render ? render->GetD3D10Device() : nullptr;
@@ -62,12 +66,31 @@ LcTiledVisual2DRenderDX10::LcTiledVisual2DRenderDX10(const LcAppContext& context
 	{
 		throw std::exception("LcTiledVisual2DRenderDX10(): Cannot create input layout");
 	}
+
+	// create shared index buffer
+	std::vector<unsigned short> indices;
+	LcSpriteBatcher::MakeIndices(maxQuadsPerDraw, indices);
+
+	D3D10_BUFFER_DESC indexBufferDesc;
+	indexBufferDesc.Usage = D3D10_USAGE_IMMUTABLE;
+	indexBufferDesc.ByteWidth = (UINT)(sizeof(unsigned short) * indices.size());
+	indexBufferDesc.BindFlags = D3D10_BIND_INDEX_BUFFER;
+	indexBufferDesc.CPUAccessFlags = 0;
+	indexBufferDesc.MiscFlags = 0;
+
+	D3D10_SUBRESOURCE_DATA indexData{};
+	indexData.pSysMem = indices.data();
+	if (FAILED(d3dDevice->CreateBuffer(&indexBufferDesc, &indexData, &indexBuffer)))
+	{
+		throw std::exception("LcTiledVisual2DRenderDX10(): Cannot create index buffer");
+	}
 }
 
 LcTiledVisual2DRenderDX10::~LcTiledVisual2DRenderDX10()
 {
 	vertexBuffers.clear();
 
+	if (indexBuffer) { indexBuffer->Release(); indexBuffer = nullptr; }
 	if (vertexLayout) { vertexLayout->Release(); vertexLayout = nullptr; }
 	if (vs) { vs->Release(); vs = nullptr; }
 	if (ps) { ps->Release(); ps = nullptr; }
@@ -113,19 +136,19 @@ void LcTiledVisual2DRenderDX10::ClearCache(IWorld* world)
     LC_CATCH{ LC_THROW("LcTiledVisual2DRenderDX10::ClearCache()") }
 }
 
-std::vector<DX10TILEDSPRITEDATA> GenerateTiles(const LcTiledSpriteComponent& tiledComp)
+std::vector<DX10TILEDSPRITEDATA> GenerateTiles(const std::vector<LC_TILES_DATA>& tilesData, const std::vector<unsigned int>& order)
 {
 	std::vector<DX10TILEDSPRITEDATA> tiles;
-	tiles.reserve(tiledComp.GetTilesData().size() * 6);
+	tiles.reserve(order.size() * LcSpriteBatcher::VerticesPerQuad);
 
-	for (const auto& tile : tiledComp.GetTilesData())
+	// quad indices make triangles (1, 2, 0) and (1, 0, 3) of the tile, same winding as before
+	for (auto index : order)
 	{
-		tiles.push_back(DX10TILEDSPRITEDATA{ tile.pos[0], tile.uv[0] });
+		const auto& tile = tilesData[index];
 		tiles.push_back(DX10TILEDSPRITEDATA{ tile.pos[1], tile.uv[1] });
 		tiles.push_back(DX10TILEDSPRITEDATA{ tile.pos[2], tile.uv[2] });
 		tiles.push_back(DX10TILEDSPRITEDATA{ tile.pos[0], tile.uv[0] });
 		tiles.push_back(DX10TILEDSPRITEDATA{ tile.pos[3], tile.uv[3] });
-		tiles.push_back(DX10TILEDSPRITEDATA{ tile.pos[1], tile.uv[1] });
 	}
 
 	return tiles;
@@ -143,26 +166,37 @@ void LcTiledVisual2DRenderDX10::Setup(const IVisual* visual, const LcAppContext&
 	auto vbIt = vertexBuffers.find(visual);
 	if (vbIt == vertexBuffers.end())
 	{
-		// create vertex buffer
-		auto tilesData = GenerateTiles(*tiledComp);
-		auto& vertexBuffer = vertexBuffers[visual];
+		// tiles data could be released after previous upload
+		tiledComp->RestoreTilesData();
+
+		auto& sourceTiles = tiledComp->GetTilesData();
+		if (sourceTiles.empty()) throw std::exception("LcTiledVisual2DRenderDX10::Setup(): No tiles found");
+
+		// split tiles to chunks and create vertex buffer in chunks order
+		LcTileChunks chunks;
+		chunks.Build(sourceTiles.data(), sourceTiles.size());
+
+		auto tilesData = GenerateTiles(sourceTiles, chunks.GetOrder());
+		LC_TILES_BUFFER vertexBuffer;
 		vertexBuffer.vertexCount = (int)tilesData.size();
+		vertexBuffer.chunks = std::move(chunks);
 
 		D3D10_BUFFER_DESC bufferDesc;
-		bufferDesc.Usage = D3D10_USAGE_DYNAMIC;
+		bufferDesc.Usage = D3D10_USAGE_IMMUTABLE;
 		bufferDesc.ByteWidth = sizeof(DX10TILEDSPRITEDATA) * vertexBuffer.vertexCount;
 		bufferDesc.BindFlags = D3D10_BIND_VERTEX_BUFFER;
-		bufferDesc.CPUAccessFlags = D3D10_CPU_ACCESS_WRITE;
+		bufferDesc.CPUAccessFlags = 0;
 		bufferDesc.MiscFlags = 0;
-		if (FAILED(d3dDevice->CreateBuffer(&bufferDesc, NULL, vertexBuffer.buffer.GetAddressOf())))
+
+		D3D10_SUBRESOURCE_DATA vertexData{};
+		vertexData.pSysMem = tilesData.data();
+		if (FAILED(d3dDevice->CreateBuffer(&bufferDesc, &vertexData, vertexBuffer.buffer.GetAddressOf())))
 		{
 			throw std::exception("LcTiledVisual2DRenderDX10::Setup(): Cannot create vertex buffer");
 		}
 
-		DX10TILEDSPRITEDATA* vertices;
-		vertexBuffer.buffer->Map(D3D10_MAP_WRITE_DISCARD, 0, (void**)&vertices);
-		memcpy(vertices, &tilesData[0], sizeof(DX10TILEDSPRITEDATA) * vertexBuffer.vertexCount);
-		vertexBuffer.buffer->Unmap();
+		vertexBuffers[visual] = std::move(vertexBuffer);
+		tiledComp->OnTilesUploaded();
 
 		vbIt = vertexBuffers.find(visual);
 	}
@@ -174,6 +208,7 @@ void LcTiledVisual2DRenderDX10::Setup(const IVisual* visual, const LcAppContext&
 	UINT stride = sizeof(DX10TILEDSPRITEDATA);
 	UINT offset = 0;
 	d3dDevice->IASetVertexBuffers(0, 1, vbIt->second.buffer.GetAddressOf(), &stride, &offset);
+	d3dDevice->IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R16_UINT, 0);
 	d3dDevice->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	// force setup because next sprite anyway will have another vertex buffer
@@ -206,23 +241,29 @@ void LcTiledVisual2DRenderDX10::Render(const IVisual* visual, const LcAppContext
 	LcVector3 worldScale{ worldScale2D.x, worldScale2D.y, 1.0f };
 	LcVector3 spritePos = sprite->GetPos() * worldScale;
 	LcVector2 spriteSize = sprite->GetSize() * worldScale2D;
-	if (auto tiledComp = sprite->GetTiledComponent()) spriteSize = tiledComp->GetTilesScale() * To2(worldScale);
+	auto tiledComp = sprite->GetTiledComponent();
+	if (tiledComp) spriteSize = tiledComp->GetTilesScale() * To2(worldScale);
 
 	LcMatrix4 trans = TransformMatrix(spritePos, spriteSize, 0.0f, false);
 	d3dDevice->UpdateSubresource(transBuffer, 0, NULL, &trans, 0, 0);
 
-	// render sprite
-	d3dDevice->Draw(vbIt->second.vertexCount, 0);
-}
+	// render only chunks in camera view
+	LcRectf tilesRect = LcTileChunks::ToTilesRect(context.world->GetCameraRect(), sprite->GetPos(),
+		tiledComp ? tiledComp->GetTilesScale() : sprite->GetSize());
+	vbIt->second.chunks.GetVisibleRanges(tilesRect, visibleRanges);
 
-bool LcTiledVisual2DRenderDX10::Supports(const TVFeaturesList& features) const
-{
-	bool needTexture = false, needAnimation = false, needTiles = false;
-	for (auto& feature : features)
+	for (const auto& range : visibleRanges)
 	{
-		needTexture |= (feature == LcComponents::Texture);
-		needAnimation |= (feature == LcComponents::FrameAnimation);
-		needTiles |= (feature == LcComponents::Tiled);
+		for (unsigned int drawn = 0; drawn < range.numTiles; drawn += maxQuadsPerDraw)
+		{
+			unsigned int numQuads = (std::min)(range.numTiles - drawn, maxQuadsPerDraw);
+			d3dDevice->DrawIndexed(numQuads * LcSpriteBatcher::IndicesPerQuad, 0, (range.firstTile + drawn) * LcSpriteBatcher::VerticesPerQuad);
+		}
 	}
-	return !needAnimation && needTexture && needTiles;
+}
+
+bool LcTiledVisual2DRenderDX10::Supports(TVFeatureMask features) const
+{
+	const TVFeatureMask required = ToFeatureBit(LcComponents::Texture) | ToFeatureBit(LcComponents::Tiled);
+	return (features & ToFeatureBit(LcComponents::FrameAnimation)) == 0 && (features & required) == required;
 }
@@ -8,12 +8,16 @@
 
 #include "Core/LCTypes.h"
 #include "RenderSystem/RenderSystemDX10/RenderSystemDX10.h"
+#include "RenderSystem/TileChunks.h"
 
 
 struct LC_TILES_BUFFER
 {
 	ComPtr<ID3D10Buffer> buffer;
+	// 4 vertices per tile, drawn with shared quad indices
 	int vertexCount;
+	// vertices are in chunks order
+	LcTileChunks chunks;
 };
 
 typedef std::map<const IVisual*, LC_TILES_BUFFER> LcTileBuffersList;
@@ -44,17 +48,21 @@ public:// IVisual2DRender interface implementation
 	//
 	virtual void Render(const IVisual* visual, const LcAppContext& context) override;
 	//
-	virtual bool Supports(const TVFeaturesList& features) const override;
+	virtual bool Supports(TVFeatureMask features) const override;
 
 
 protected:
 	//
 	LcTileBuffersList vertexBuffers;
+	// shared 16-bit quad indices
+	ID3D10Buffer* indexBuffer;
 	//
 	ID3D10InputLayout* vertexLayout;
 	//
 	ID3D10VertexShader* vs;
 	//
 	ID3D10PixelShader* ps;
+	// reused to avoid allocations per frame
+	std::vector<LcTileRange> visibleRanges;
 
 };
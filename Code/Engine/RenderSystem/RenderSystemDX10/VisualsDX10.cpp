@@ -8,6 +8,7 @@
 #include "RenderSystem/RenderSystemDX10/VisualsDX10.h"
 #include "RenderSystem/RenderSystemDX10/RenderSystemDX10.h"
 #include "RenderSystem/RenderSystemDX10/TiledVisual2DRenderDX10.h"
+#include "RenderSystem/RenderSystemDX10/BasicParticlesRenderDX10.h"
 #include "RenderSystem/RenderSystemDX10/TextRenderDX10.h"
 #include "World/SpriteInterface.h"
 #include "Core/LCLocalization.h"
@@ -24,6 +25,21 @@ void LcSpriteDX10::Destroy(const LcAppContext& context)
     {
         tiledRender->RemoveTiles(this);
     }
+
+    if (auto particlesRender = renderDX10 ? renderDX10->GetParticlesRender() : nullptr)
+    {
+        particlesRender->RemoveTiles(this);
+    }
+}
+
+void LcSpriteDX10::Reset(const LcAppContext& context)
+{
+    // render buffers are mapped by visual address, which is reused
+    Destroy(context);
+    LcSprite::Reset(context);
+
+    texture = nullptr;
+    textureSV = nullptr;
 }
 
 void LcSpriteDX10::AddComponent(TVComponentPtr comp, const LcAppContext& context)
@@ -48,6 +64,19 @@ void LcSpriteDX10::AddComponent(TVComponentPtr comp, const LcAppContext& context
     LC_CATCH{ LC_THROW("LcSpriteDX10::AddComponent()") }
 }
 
+void LcWidgetDX10::Reset(const LcAppContext& context)
+{
+    LcWidget::Reset(context);
+
+    spriteTexture = nullptr;
+    spriteTextureSV = nullptr;
+    textTexture.Reset();
+    textTextureSV.Reset();
+    textRenderTarget.Reset();
+    prevRenderedText.clear();
+    font = nullptr;
+}
+
 void LcWidgetDX10::Update(float deltaSeconds, const LcAppContext& context)
 {
     IVisualBase::Update(deltaSeconds, context);
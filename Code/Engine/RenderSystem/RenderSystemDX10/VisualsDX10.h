@@ -35,6 +35,8 @@ public:// IVisualBase interface implementation
 	virtual void AddComponent(TVComponentPtr comp, const LcAppContext& context) override;
 	//
 	virtual void Destroy(const LcAppContext& context) override;
+	//
+	virtual void Reset(const LcAppContext& context) override;
 
 };
 
@@ -50,6 +52,8 @@ public:
 
 
 public: // IVisualBase interface implementation
+	virtual void Reset(const LcAppContext& context) override;
+	//
 	virtual void Update(float deltaSeconds, const LcAppContext& context) override;
 	//
 	virtual void AddComponent(TVComponentPtr comp, const LcAppContext& context) override;
@@ -0,0 +1,254 @@
+/**
+* RenderSystemNull.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "RenderSystem/RenderSystemNull/RenderSystemNull.h"
+#include "World/WorldInterface.h"
+#include "World/SpriteInterface.h"
+#include "World/Camera.h"
+#include "Core/LCException.h"
+
+
+LcRenderSystemNull::LcRenderSystemNull(LcSize inViewportSize)
+	: viewportSize(inViewportSize)
+	, numFrames(0)
+	, created(false)
+{
+}
+
+void LcRenderSystemNull::Create(void* windowHandle, LcWinMode mode, bool inVSync, bool inAllowFullscreen, const LcAppContext& context)
+{
+	LC_TRY
+
+	LcRenderSystemBase::Create(windowHandle, mode, inVSync, inAllowFullscreen, context);
+
+	created = true;
+	Resize(viewportSize.x, viewportSize.y, context);
+
+	LC_CATCH{ LC_THROW("LcRenderSystemNull::Create()") }
+}
+
+void LcRenderSystemNull::Shutdown()
+{
+	LcRenderSystemBase::Shutdown();
+
+	commands.clear();
+	textures.clear();
+	created = false;
+}
+
+void LcRenderSystemNull::Clear(IWorld* world, bool removeRooted)
+{
+	WaitRenderThread();
+
+	commands.clear();
+	if (removeRooted) textures.clear();
+}
+
+void LcRenderSystemNull::Render(const LcAppContext& context)
+{
+	LC_TRY
+
+	// commands are written by render thread in threaded mode
+	if (!IsRenderThreaded()) commands.clear();
+
+	LcRenderSystemBase::Render(context);
+	numFrames++;
+
+	LC_CATCH{ LC_THROW("LcRenderSystemNull::Render()") }
+}
+
+void LcRenderSystemNull::Resize(int width, int height, const LcAppContext& context)
+{
+	if (!context.world) throw std::exception("LcRenderSystemNull::Resize(): Invalid world");
+
+	WaitRenderThread();
+
+	viewportSize = LcSize{ width, height };
+
+	cameraPos = LcVector3{ width / 2.0f, height / 2.0f, 0.0f };
+	cameraTarget = LcVector3{ cameraPos.x, cameraPos.y, 1.0f };
+
+	context.world->UpdateWorldScale(viewportSize);
+	context.world->GetCamera().Set(cameraPos, cameraTarget);
+}
+
+LcRSStats LcRenderSystemNull::GetStats() const
+{
+	return LcRSStats{
+		(int)textures.size(),
+		0,
+		0,
+		renderQueue.GetStats(),
+		updateTime,
+		renderTime
+	};
+}
+
+void LcRenderSystemNull::Render(const IVisual* visual, const LcAppContext& context)
+{
+	if (!visual) throw std::exception("LcRenderSystemNull::Render(): Invalid visual");
+
+	Record(visual, GetRenderState(visual));
+}
+
+LcRenderState LcRenderSystemNull::GetRenderState(const IVisual* visual) const
+{
+	LcRenderState state{ visual->GetRenderPipeline(), nullptr, 0 };
+
+	TVFeatureMask features = visual->GetFeatureMask();
+	bool hasTexture = (features & ToFeatureBit(LcComponents::Texture)) != 0;
+
+	if (state.pipeline == LcUnresolvedPipeline)
+	{
+		// resolve once after components change
+		bool hasAnimation = (features & ToFeatureBit(LcComponents::FrameAnimation)) != 0;
+		bool hasTiles = (features & ToFeatureBit(LcComponents::Tiled)) != 0;
+		bool hasParticles = (features & ToFeatureBit(LcComponents::Particles)) != 0;
+
+		state.pipeline = -1;
+		if (!hasTiles && !hasAnimation && !hasTexture) state.pipeline = LcNullPipelines::Colored;
+		else if (!hasTiles && !hasAnimation && !hasParticles && hasTexture) state.pipeline = LcNullPipelines::Textured;
+		else if (!hasTiles && hasAnimation) state.pipeline = LcNullPipelines::Animated;
+		else if (!hasAnimation && hasTiles && hasTexture) state.pipeline = LcNullPipelines::Tiled;
+		else if (!hasAnimation && !hasTiles && hasParticles && hasTexture) state.pipeline = LcNullPipelines::Particles;
+
+		visual->SetRenderPipeline(state.pipeline);
+	}
+
+	if (auto texture = hasTexture ? visual->GetTextureComponent() : nullptr)
+	{
+		state.texture = &*textures.insert(texture->GetTexturePath()).first;
+	}
+
+	return state;
+}
+
+void LcRenderSystemNull::RenderBatch(const LcRenderBatch& batch, const LcAppContext& context)
+{
+	if (batch.GetState().pipeline < 0) return;
+
+	size_t prevSize = commands.size();
+
+	for (size_t i = 0; i < batch.numItems; i++)
+	{
+		if (batch.GetState().pipeline == LcNullPipelines::Textured && batch.items[i].visual->GetTypeId() == LcCreatables::Sprite)
+		{
+			// textured sprites are merged like in sprite batcher of the GPU render
+			size_t numSprites = 1;
+			while (i + numSprites < batch.numItems && batch.items[i + numSprites].visual->GetTypeId() == LcCreatables::Sprite) numSprites++;
+
+			RecordSprites(&batch.items[i], numSprites, context);
+			i += numSprites - 1;
+			continue;
+		}
+
+		Record(batch.items[i].visual, batch.GetState());
+	}
+
+	renderQueue.AddDrawCalls((int)(commands.size() - prevSize));
+}
+
+void LcRenderSystemNull::RecordSprites(const LcRenderItem* items, size_t numItems, const LcAppContext& context)
+{
+	batcher.Begin(context.world->GetWorldScale().GetScale());
+
+	for (size_t i = 0; i < numItems; i++)
+	{
+		batcher.Add(*static_cast<const ISprite*>(items[i].visual));
+
+		if (batcher.GetNumQuads() == batcher.GetMaxQuads() || i + 1 == numItems)
+		{
+			commands.push_back(LcRenderCommand{
+				LcNullPipelines::Textured,
+				items[0].state.texture,
+				LcVector3{ 0.0f, 0.0f, 0.0f },
+				LcVector2{ 0.0f, 0.0f },
+				0.0f,
+				batcher.GetNumQuads() * LcSpriteBatcher::VerticesPerQuad
+			});
+
+			batcher.Begin(batcher.GetWorldScale());
+		}
+	}
+}
+
+int LcRenderSystemNull::RenderSnapshot(const LcRenderSnapshot& snapshot)
+{
+	commands.clear();
+
+	for (auto& batch : snapshot.batches)
+	{
+		if (batch.state.pipeline < 0) continue;
+
+		const LcRenderProxy* proxies = &snapshot.proxies[batch.firstProxy];
+		for (size_t i = 0; i < batch.numProxies; i++)
+		{
+			if (batch.state.pipeline == LcNullPipelines::Textured && proxies[i].typeId == LcCreatables::Sprite)
+			{
+				size_t numSprites = 1;
+				while (i + numSprites < batch.numProxies && proxies[i + numSprites].typeId == LcCreatables::Sprite) numSprites++;
+
+				RecordSprites(&proxies[i], numSprites, snapshot.worldScale);
+				i += numSprites - 1;
+				continue;
+			}
+
+			const auto& proxy = proxies[i];
+			unsigned int numVertices = (proxy.numElements > 0) ? proxy.numElements * 6 : 4;
+			commands.push_back(LcRenderCommand{ batch.state.pipeline, batch.state.texture, proxy.pos, proxy.size, proxy.rotZ, numVertices });
+		}
+	}
+
+	return (int)commands.size();
+}
+
+void LcRenderSystemNull::RecordSprites(const LcRenderProxy* proxies, size_t numProxies, LcVector2 worldScale)
+{
+	batcher.Begin(worldScale);
+
+	for (size_t i = 0; i < numProxies; i++)
+	{
+		const auto& proxy = proxies[i];
+		batcher.Add(proxy.pos, proxy.size, proxy.rotZ, proxy.colors, proxy.uvs);
+
+		if (batcher.GetNumQuads() == batcher.GetMaxQuads() || i + 1 == numProxies)
+		{
+			commands.push_back(LcRenderCommand{
+				LcNullPipelines::Textured,
+				proxies[0].state.texture,
+				LcVector3{ 0.0f, 0.0f, 0.0f },
+				LcVector2{ 0.0f, 0.0f },
+				0.0f,
+				batcher.GetNumQuads() * LcSpriteBatcher::VerticesPerQuad
+			});
+
+			batcher.Begin(batcher.GetWorldScale());
+		}
+	}
+}
+
+void LcRenderSystemNull::Record(const IVisual* visual, const LcRenderState& state)
+{
+	unsigned int numVertices = 4;
+
+	if (auto tiled = (state.pipeline == LcNullPipelines::Tiled) ? static_cast<const ITiledSpriteComponent*>(visual->GetComponent(LcComponents::Tiled).get()) : nullptr)
+	{
+		numVertices = tiled->GetNumTiles() * LcSpriteBatcher::VerticesPerQuad;
+	}
+
+	if (auto particles = (state.pipeline == LcNullPipelines::Particles) ? static_cast<const IBasicParticlesComponent*>(visual->GetComponent(LcComponents::Particles).get()) : nullptr)
+	{
+		numVertices = (unsigned int)particles->GetNumParticles() * 6;
+	}
+
+	commands.push_back(LcRenderCommand{ state.pipeline, state.texture, visual->GetPos(), visual->GetSize(), visual->GetRotZ(), numVertices });
+}
+
+TRenderSystemPtr GetNullRenderSystem()
+{
+	return std::make_shared<LcRenderSystemNull>();
+}
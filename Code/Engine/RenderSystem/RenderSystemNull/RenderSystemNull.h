@@ -0,0 +1,131 @@
+/**
+* RenderSystemNull.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "RenderSystem/RenderSystem.h"
+#include "RenderSystem/SpriteBatcher.h"
+
+#include <unordered_set>
+#include <vector>
+#include <string>
+
+
+/** Null render pipelines, same order as DX10 visual renders */
+namespace LcNullPipelines
+{
+	constexpr int Colored = 0;
+	constexpr int Textured = 1;
+	constexpr int Animated = 2;
+	constexpr int Tiled = 3;
+	constexpr int Particles = 4;
+}
+
+
+/** Recorded draw. Batched sprites have transform baked into vertices, pos and size are zero */
+struct LcRenderCommand
+{
+	int pipeline;
+	//
+	const void* texture;
+	//
+	LcVector3 pos;
+	//
+	LcVector2 size;
+	//
+	float rotZ;
+	//
+	unsigned int numVertices;
+};
+
+
+/**
+* Null render system. Does full update and render traversal without GPU,
+* would-be draws are recorded to the command log of the last frame.
+* Used for CPU benchmarks and tests on machines without graphics device.
+* Supports threaded render, call WaitRenderThread() before reading commands in this mode.
+*/
+class RENDERSYSTEM_API LcRenderSystemNull : public LcRenderSystemBase
+{
+public:
+	typedef std::vector<LcRenderCommand> TCommandsList;
+
+
+public:
+	LcRenderSystemNull(LcSize inViewportSize = LcSize{ 1280, 720 });
+	/**
+	* Get draws of the last frame */
+	inline const TCommandsList& GetCommands() const { return commands; }
+	/**
+	* Get number of rendered frames */
+	inline unsigned int GetNumFrames() const { return numFrames; }
+
+
+public:// IRenderSystem interface implementation
+	//
+	virtual ~LcRenderSystemNull() override { StopRenderThread(); }
+	//
+	virtual void LoadShaders(const char* folderPath) override {}
+	//
+	virtual void Create(void* windowHandle, LcWinMode mode, bool inVSync, bool inAllowFullscreen, const LcAppContext& context) override;
+	//
+	virtual void Shutdown() override;
+	//
+	virtual void Clear(IWorld* world, bool removeRooted = false) override;
+	//
+	virtual void Render(const LcAppContext& context) override;
+	//
+	virtual void Resize(int width, int height, const LcAppContext& context) override;
+	//
+	virtual void UpdateCamera(float deltaSeconds, LcVector3 newPos, LcVector3 newTarget) override {}
+	//
+	virtual bool CanRender() const override { return created; }
+	//
+	virtual LcRSStats GetStats() const override;
+	//
+	virtual LcRenderSystemType GetType() const override { return LcRenderSystemType::Null; }
+
+
+protected:// LcRenderSystemBase interface implementation
+	//
+	virtual void Render(const IVisual* visual, const LcAppContext& context) override;
+	//
+	virtual LcRenderState GetRenderState(const IVisual* visual) const override;
+	//
+	virtual void RenderBatch(const LcRenderBatch& batch, const LcAppContext& context) override;
+	//
+	virtual bool SupportsThreadedRender() const override { return true; }
+	//
+	virtual int RenderSnapshot(const LcRenderSnapshot& snapshot) override;
+
+
+protected:
+	void RecordSprites(const LcRenderItem* items, size_t numItems, const LcAppContext& context);
+	//
+	void RecordSprites(const LcRenderProxy* proxies, size_t numProxies, LcVector2 worldScale);
+	//
+	void Record(const IVisual* visual, const LcRenderState& state);
+
+
+protected:
+	TCommandsList commands;
+	//
+	LcSpriteBatcher batcher;
+	// texture paths, string address is the texture id
+	mutable std::unordered_set<std::string> textures;
+	//
+	LcSize viewportSize;
+	//
+	unsigned int numFrames;
+	//
+	bool created;
+
+};
+
+
+/**
+* Null render system */
+RENDERSYSTEM_API TRenderSystemPtr GetNullRenderSystem();
@@ -0,0 +1,110 @@
+/**
+* SpriteBatcher.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "RenderSystem/SpriteBatcher.h"
+#include "World/SpriteInterface.h"
+
+#include <cmath>
+
+
+// 16-bit indices limit
+static const unsigned int MaxBatchQuads = 65536 / LcSpriteBatcher::VerticesPerQuad;
+
+LcSpriteBatcher::LcSpriteBatcher(unsigned int inMaxQuads)
+    : worldScale{ 1.0f, 1.0f }
+    , maxQuads((inMaxQuads == 0) ? 1 : ((inMaxQuads > MaxBatchQuads) ? MaxBatchQuads : inMaxQuads))
+    , ringOffset(0)
+    , ringDiscard(true)
+{
+}
+
+void LcSpriteBatcher::Begin(LcVector2 inWorldScale)
+{
+    vertices.clear();
+    worldScale = inWorldScale;
+}
+
+void LcSpriteBatcher::Add(const ISprite& sprite)
+{
+    static const LcColor4 defaultColors[] = { LcDefaults::White4, LcDefaults::White4, LcDefaults::White4, LcDefaults::White4 };
+    static const LcVector4 defaultUVs[] = { { 0.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f } };
+
+    auto colors = sprite.GetColorsComponent();
+    auto tint = sprite.GetTintComponent();
+    auto customUV = sprite.GetCustomUVComponent();
+
+    const LcColor4* colorsData = colors ? (const LcColor4*)colors->GetData() : (tint ? (const LcColor4*)tint->GetData() : defaultColors);
+    const LcVector4* uvsData = customUV ? (const LcVector4*)customUV->GetData() : defaultUVs;
+
+    Add(sprite.GetPos(), sprite.GetSize(), sprite.GetRotZ(), colorsData, uvsData);
+}
+
+void LcSpriteBatcher::Add(LcVector3 pos, LcVector2 size, float rotZ, const LcColor4* colors, const LcVector4* uvs)
+{
+    size_t first = vertices.size();
+    vertices.resize(first + VerticesPerQuad);
+
+    LcVector3 scaledPos{ pos.x * worldScale.x, pos.y * worldScale.y, pos.z };
+    MakeQuad(scaledPos, size * worldScale, rotZ, colors, uvs, &vertices[first]);
+}
+
+unsigned int LcSpriteBatcher::Allocate(unsigned int numQuads, bool& outDiscard)
+{
+    if (numQuads > maxQuads) throw std::exception("LcSpriteBatcher::Allocate(): Too many quads");
+
+    outDiscard = ringDiscard;
+    ringDiscard = false;
+
+    if (ringOffset + numQuads > maxQuads)
+    {
+        // wrap around
+        ringOffset = 0;
+        outDiscard = true;
+    }
+
+    unsigned int first = ringOffset;
+    ringOffset += numQuads;
+    return first;
+}
+
+void LcSpriteBatcher::MakeQuad(LcVector3 pos, LcVector2 size, float rotZ, const LcColor4* colors, const LcVector4* uvs, LcSpriteVertex* outVertices)
+{
+    static const LcVector2 corners[] = { { -0.5f, 0.5f }, { 0.5f, 0.5f }, { 0.5f, -0.5f }, { -0.5f, -0.5f } };
+
+    float s = (rotZ != 0.0f) ? std::sin(rotZ) : 0.0f;
+    float c = (rotZ != 0.0f) ? std::cos(rotZ) : 1.0f;
+
+    for (unsigned int i = 0; i < VerticesPerQuad; i++)
+    {
+        // scale with flipped Y, rotate and translate
+        float x = corners[i].x * size.x;
+        float y = -corners[i].y * size.y;
+
+        auto& vertex = outVertices[i];
+        vertex.pos = LcVector3{ x * c - y * s + pos.x, x * s + y * c + pos.y, pos.z };
+        vertex.color = colors[i];
+        vertex.uv = LcVector2{ uvs[i].x, uvs[i].y };
+    }
+}
+
+void LcSpriteBatcher::MakeIndices(unsigned int numQuads, std::vector<unsigned short>& outIndices)
+{
+    outIndices.resize(numQuads * IndicesPerQuad);
+
+    for (unsigned int quad = 0; quad < numQuads; quad++)
+    {
+        unsigned short base = (unsigned short)(quad * VerticesPerQuad);
+        unsigned short* indices = &outIndices[quad * IndicesPerQuad];
+
+        indices[0] = base;
+        indices[1] = base + 1;
+        indices[2] = base + 2;
+        indices[3] = base;
+        indices[4] = base + 2;
+        indices[5] = base + 3;
+    }
+}
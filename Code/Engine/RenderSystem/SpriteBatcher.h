@@ -0,0 +1,86 @@
+/**
+* SpriteBatcher.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "RenderSystem/Module.h"
+#include "Core/LCTypesEx.h"
+
+#include <vector>
+
+#pragma warning(disable : 4251)
+
+
+/** Batched sprite vertex, world position is already scaled */
+struct LcSpriteVertex
+{
+	LcVector3 pos;
+	//
+	LcColor4 color;
+	//
+	LcVector2 uv;
+};
+
+
+/**
+* Sprite batcher. Transforms sprite quads on CPU and collects them into one vertex stream.
+* Quad vertices go in order: left top, right top, right bottom, left bottom,
+* two triangles per quad are built from shared indices (see MakeIndices()).
+* Also tracks offset in ring vertex buffer of the backend.
+*/
+class RENDERSYSTEM_API LcSpriteBatcher
+{
+public:
+	static constexpr unsigned int DefaultMaxQuads = 4096;
+	//
+	static constexpr unsigned int VerticesPerQuad = 4;
+	//
+	static constexpr unsigned int IndicesPerQuad = 6;
+
+
+public:
+	LcSpriteBatcher(unsigned int inMaxQuads = DefaultMaxQuads);
+	/**
+	* Start new batch */
+	void Begin(LcVector2 inWorldScale);
+	/**
+	* Add textured sprite */
+	void Add(const class ISprite& sprite);
+	/**
+	* Add quad */
+	void Add(LcVector3 pos, LcVector2 size, float rotZ, const LcColor4* colors, const LcVector4* uvs);
+	//
+	inline const LcSpriteVertex* GetVertices() const { return vertices.data(); }
+	//
+	inline unsigned int GetNumQuads() const { return (unsigned int)(vertices.size() / VerticesPerQuad); }
+	//
+	inline unsigned int GetMaxQuads() const { return maxQuads; }
+	//
+	inline LcVector2 GetWorldScale() const { return worldScale; }
+	/**
+	* Allocate quads in ring vertex buffer of maxQuads size. Returns first quad index.
+	* outDiscard is true when buffer is wrapped and its old content must be discarded */
+	unsigned int Allocate(unsigned int numQuads, bool& outDiscard);
+	/**
+	* Transform quad corners from position, size and Z rotation. Y axis is flipped like TransformMatrix() */
+	static void MakeQuad(LcVector3 pos, LcVector2 size, float rotZ, const LcColor4* colors, const LcVector4* uvs, LcSpriteVertex* outVertices);
+	/**
+	* Make 16-bit index list for numQuads quads */
+	static void MakeIndices(unsigned int numQuads, std::vector<unsigned short>& outIndices);
+
+
+protected:
+	std::vector<LcSpriteVertex> vertices;
+	//
+	LcVector2 worldScale;
+	//
+	unsigned int maxQuads;
+	//
+	unsigned int ringOffset;
+	//
+	bool ringDiscard;
+
+};
@@ -0,0 +1,178 @@
+/**
+* TileChunks.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "RenderSystem/TileChunks.h"
+#include "World/SpriteInterface.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+
+// keeps grid small for degenerate tiles
+static const int MaxGridSide = 4096;
+
+inline bool Intersects(const LcRectf& a, const LcRectf& b)
+{
+    return a.left <= b.right && b.left <= a.right && a.top <= b.bottom && b.top <= a.bottom;
+}
+
+inline LcRectf GetTileBounds(const LC_TILES_DATA& tile)
+{
+    LcRectf bounds{ tile.pos[0].x, tile.pos[0].y, tile.pos[0].x, tile.pos[0].y };
+    for (int i = 1; i < 4; i++)
+    {
+        bounds.left = (std::min)(bounds.left, tile.pos[i].x);
+        bounds.top = (std::min)(bounds.top, tile.pos[i].y);
+        bounds.right = (std::max)(bounds.right, tile.pos[i].x);
+        bounds.bottom = (std::max)(bounds.bottom, tile.pos[i].y);
+    }
+
+    return bounds;
+}
+
+// cell of the coordinate, clamped to grid, so infinite rects are handled
+inline int ToCell(float value, float origin, float cellSize, int numCells)
+{
+    float cell = std::floor((value - origin) / cellSize);
+    if (!(cell >= 0.0f)) return 0;
+    if (cell >= (float)(numCells - 1)) return numCells - 1;
+    return (int)cell;
+}
+
+void LcTileChunks::Build(const LC_TILES_DATA* tiles, size_t inNumTiles, int chunkSize)
+{
+    Clear();
+
+    if (!tiles || inNumTiles == 0) return;
+    if (chunkSize <= 0) throw std::exception("LcTileChunks::Build(): Invalid chunk size");
+
+    numTiles = (unsigned int)inNumTiles;
+
+    // grid covers all tiles, cell size from the first tile
+    LcRectf bounds = GetTileBounds(tiles[0]);
+    LcVector2 tileSize{ bounds.right - bounds.left, bounds.bottom - bounds.top };
+    for (unsigned int i = 1; i < numTiles; i++)
+    {
+        auto tileBounds = GetTileBounds(tiles[i]);
+        bounds.left = (std::min)(bounds.left, tileBounds.left);
+        bounds.top = (std::min)(bounds.top, tileBounds.top);
+        bounds.right = (std::max)(bounds.right, tileBounds.right);
+        bounds.bottom = (std::max)(bounds.bottom, tileBounds.bottom);
+    }
+
+    origin = LcVector2{ bounds.left, bounds.top };
+    float width = bounds.right - bounds.left;
+    float height = bounds.bottom - bounds.top;
+    cellSize.x = (std::max)(tileSize.x * chunkSize, width / MaxGridSide);
+    cellSize.y = (std::max)(tileSize.y * chunkSize, height / MaxGridSide);
+    if (cellSize.x <= 0.0f) cellSize.x = 1.0f;
+    if (cellSize.y <= 0.0f) cellSize.y = 1.0f;
+
+    numColumns = (std::min)((std::max)((int)std::ceil(width / cellSize.x), 1), MaxGridSide);
+    numRows = (std::min)((std::max)((int)std::ceil(height / cellSize.y), 1), MaxGridSide);
+
+    // counting sort by cell of tile left top corner, stable
+    std::vector<unsigned int> tileCells(numTiles);
+    std::vector<unsigned int> cellOffsets((size_t)numColumns * numRows + 1, 0);
+    for (unsigned int i = 0; i < numTiles; i++)
+    {
+        auto tileBounds = GetTileBounds(tiles[i]);
+        int column = ToCell(tileBounds.left, origin.x, cellSize.x, numColumns);
+        int row = ToCell(tileBounds.top, origin.y, cellSize.y, numRows);
+        tileCells[i] = (unsigned int)(row * numColumns + column);
+        cellOffsets[tileCells[i] + 1]++;
+    }
+
+    for (size_t cell = 1; cell < cellOffsets.size(); cell++)
+    {
+        cellOffsets[cell] += cellOffsets[cell - 1];
+    }
+
+    grid.assign((size_t)numColumns * numRows, -1);
+    for (size_t cell = 0; cell < grid.size(); cell++)
+    {
+        unsigned int cellTiles = cellOffsets[cell + 1] - cellOffsets[cell];
+        if (cellTiles == 0) continue;
+
+        grid[cell] = (int)chunks.size();
+        chunks.push_back(LcTileChunk{ LcRectf{ FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX }, cellOffsets[cell], cellTiles });
+    }
+
+    order.resize(numTiles);
+    for (unsigned int i = 0; i < numTiles; i++)
+    {
+        unsigned int cell = tileCells[i];
+        order[cellOffsets[cell]++] = i;
+
+        // chunk bounds are tile bounds, tiles could go out of the cell
+        auto& chunk = chunks[grid[cell]];
+        auto tileBounds = GetTileBounds(tiles[i]);
+        chunk.bounds.left = (std::min)(chunk.bounds.left, tileBounds.left);
+        chunk.bounds.top = (std::min)(chunk.bounds.top, tileBounds.top);
+        chunk.bounds.right = (std::max)(chunk.bounds.right, tileBounds.right);
+        chunk.bounds.bottom = (std::max)(chunk.bounds.bottom, tileBounds.bottom);
+    }
+}
+
+void LcTileChunks::GetVisibleRanges(const LcRectf& rect, std::vector<LcTileRange>& outRanges) const
+{
+    outRanges.clear();
+    if (chunks.empty()) return;
+
+    // tiles belong to the cell of their left top corner, so check one more cell to the left and top
+    int firstColumn = (std::max)(ToCell(rect.left, origin.x, cellSize.x, numColumns) - 1, 0);
+    int lastColumn = ToCell(rect.right, origin.x, cellSize.x, numColumns);
+    int firstRow = (std::max)(ToCell(rect.top, origin.y, cellSize.y, numRows) - 1, 0);
+    int lastRow = ToCell(rect.bottom, origin.y, cellSize.y, numRows);
+
+    for (int row = firstRow; row <= lastRow; row++)
+    {
+        for (int column = firstColumn; column <= lastColumn; column++)
+        {
+            int chunkIndex = grid[(size_t)row * numColumns + column];
+            if (chunkIndex < 0) continue;
+
+            auto& chunk = chunks[chunkIndex];
+            if (!Intersects(chunk.bounds, rect)) continue;
+
+            if (!outRanges.empty() && outRanges.back().firstTile + outRanges.back().numTiles == chunk.firstTile)
+            {
+                outRanges.back().numTiles += chunk.numTiles;
+            }
+            else
+            {
+                outRanges.push_back(LcTileRange{ chunk.firstTile, chunk.numTiles });
+            }
+        }
+    }
+}
+
+void LcTileChunks::Clear()
+{
+    chunks.clear();
+    grid.clear();
+    order.clear();
+    origin = LcVector2{ 0.0f, 0.0f };
+    cellSize = LcVector2{ 0.0f, 0.0f };
+    numColumns = 0;
+    numRows = 0;
+    numTiles = 0;
+}
+
+LcRectf LcTileChunks::ToTilesRect(const LcRectf& worldRect, LcVector3 spritePos, LcVector2 tilesScale)
+{
+    if (tilesScale.x == 0.0f || tilesScale.y == 0.0f) return LcRectf{ -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX };
+
+    // tiles are drawn at sprite position with tiles scale
+    float left = (worldRect.left - spritePos.x) / tilesScale.x;
+    float right = (worldRect.right - spritePos.x) / tilesScale.x;
+    float top = (worldRect.top - spritePos.y) / tilesScale.y;
+    float bottom = (worldRect.bottom - spritePos.y) / tilesScale.y;
+
+    return LcRectf{ (std::min)(left, right), (std::min)(top, bottom), (std::max)(left, right), (std::max)(top, bottom) };
+}
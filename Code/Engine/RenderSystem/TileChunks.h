@@ -0,0 +1,89 @@
+/**
+* TileChunks.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "RenderSystem/Module.h"
+#include "Core/LCTypesEx.h"
+
+#include <vector>
+
+#pragma warning(disable : 4251)
+
+
+/** Chunk of tiled sprite, range of tiles in chunks order */
+struct LcTileChunk
+{
+	// bounds in tiles coordinates
+	LcRectf bounds;
+	//
+	unsigned int firstTile;
+	//
+	unsigned int numTiles;
+};
+
+
+/** Range of tiles to draw */
+struct LcTileRange
+{
+	unsigned int firstTile;
+	//
+	unsigned int numTiles;
+};
+
+
+/**
+* Tiled sprite geometry split to square chunks with bounds, so only chunks in view are drawn.
+* Tiles are ordered chunk by chunk, tiles inside chunk keep their order, so layers are drawn in order.
+* Backend neutral: backend builds its geometry in GetOrder() order and draws GetVisibleRanges().
+*/
+class RENDERSYSTEM_API LcTileChunks
+{
+public:
+	static constexpr int DefaultChunkSize = 32;
+
+
+public:
+	LcTileChunks() : origin(LcVector2{ 0.0f, 0.0f }), cellSize(LcVector2{ 0.0f, 0.0f }), numColumns(0), numRows(0), numTiles(0) {}
+	/**
+	* Split tiles to chunks of chunkSize x chunkSize tiles */
+	void Build(const struct LC_TILES_DATA* tiles, size_t inNumTiles, int chunkSize = DefaultChunkSize);
+	/**
+	* Get ranges of tiles intersecting rect in tiles coordinates. Neighbour chunks are merged to one range */
+	void GetVisibleRanges(const LcRectf& rect, std::vector<LcTileRange>& outRanges) const;
+	//
+	void Clear();
+	/**
+	* Source tile indices in chunks order */
+	inline const std::vector<unsigned int>& GetOrder() const { return order; }
+	//
+	inline const std::vector<LcTileChunk>& GetChunks() const { return chunks; }
+	//
+	inline unsigned int GetNumTiles() const { return numTiles; }
+	/**
+	* Convert world rect to tiles coordinates of tiled sprite */
+	static LcRectf ToTilesRect(const LcRectf& worldRect, LcVector3 spritePos, LcVector2 tilesScale);
+
+
+protected:
+	// not empty chunks, row by row
+	std::vector<LcTileChunk> chunks;
+	// chunk index of grid cell, -1 for empty cell
+	std::vector<int> grid;
+	//
+	std::vector<unsigned int> order;
+	// left top of the grid
+	LcVector2 origin;
+	//
+	LcVector2 cellSize;
+	//
+	int numColumns;
+	//
+	int numRows;
+	//
+	unsigned int numTiles;
+
+};
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "Core/LcTypesEx.h"
+#include "Core/LCTypesEx.h"
 
 
 /**
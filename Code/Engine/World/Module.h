@@ -9,7 +9,9 @@
 #include <memory>
 
 
-#ifndef WORLD_EXPORTS
+#if !defined(_WIN32)
+#define WORLD_API
+#elif !defined(WORLD_EXPORTS)
 #define WORLD_API __declspec (dllimport)
 #else
 #define WORLD_API __declspec (dllexport)
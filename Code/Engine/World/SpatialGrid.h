@@ -0,0 +1,310 @@
+/**
+* SpatialGrid.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Core/Visual.h"
+#include "World/SpriteInterface.h"
+
+#include <unordered_map>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+
+/**
+* Uniform grid over visual bounds in world coordinates.
+* Changed visuals are queued and placed to cells on the next query.
+* Widgets, tiled and particles sprites are not culled and returned by every query.
+*/
+class LcSpatialGrid
+{
+public:
+	typedef std::vector<IVisual*> TVisualsList;
+	//
+	static constexpr int MaxCellsPerVisual = 64 * 64;
+
+
+public:
+	LcSpatialGrid(float inCellSize = 256.0f) : cellSize(inCellSize), queryStamp(0) {}
+	//
+	LcSpatialGrid(const LcSpatialGrid&) = delete;
+	//
+	LcSpatialGrid& operator=(const LcSpatialGrid&) = delete;
+	/**
+	* Set cell size in pixels. Rebuilds grid */
+	void SetCellSize(float inCellSize)
+	{
+		if (inCellSize <= 0.0f || inCellSize == cellSize) return;
+
+		cellSize = inCellSize;
+
+		std::vector<IVisual*> visuals;
+		for (auto& cell : cells)
+		{
+			for (auto visual : cell.second)
+			{
+				visual->GetSlot().cells = LcRect{ 0, 0, -1, -1 };
+				visuals.push_back(visual);
+			}
+		}
+
+		cells.clear();
+		for (auto visual : visuals) MarkDirty(visual);
+	}
+	//
+	inline float GetCellSize() const { return cellSize; }
+	/**
+	* Queue visual bounds update */
+	void MarkDirty(IVisual* visual)
+	{
+		auto& slot = visual->GetSlot();
+		if (slot.dirtyIndex >= 0) return;
+
+		slot.dirtyIndex = static_cast<int>(dirty.size());
+		dirty.push_back(visual);
+	}
+	/**
+	* Remove visual from grid */
+	void Remove(IVisual* visual)
+	{
+		auto& slot = visual->GetSlot();
+
+		if (slot.dirtyIndex >= 0)
+		{
+			EraseAt(dirty, slot.dirtyIndex, &LcVisualSlot::dirtyIndex);
+		}
+
+		if (slot.unboundedIndex >= 0)
+		{
+			EraseAt(unbounded, slot.unboundedIndex, &LcVisualSlot::unboundedIndex);
+		}
+
+		RemoveFromCells(visual);
+	}
+	/**
+	* Remove all visuals */
+	void Clear()
+	{
+		for (auto visual : dirty) visual->GetSlot().dirtyIndex = -1;
+		for (auto visual : unbounded) visual->GetSlot().unboundedIndex = -1;
+		for (auto& cell : cells)
+		{
+			for (auto visual : cell.second) visual->GetSlot().cells = LcRect{ 0, 0, -1, -1 };
+		}
+
+		dirty.clear();
+		unbounded.clear();
+		cells.clear();
+	}
+	/**
+	* Get visuals intersecting rect and not culled visuals, sorted by storage order */
+	void Query(const LcRectf& rect, TVisualsList& outVisuals)
+	{
+		Flush();
+
+		size_t prevSize = outVisuals.size();
+		++queryStamp;
+
+		for (auto visual : unbounded)
+		{
+			visual->GetSlot().queryStamp = queryStamp;
+			outVisuals.push_back(visual);
+		}
+
+		LcRect area = ToCells(rect);
+		long long numAreaCells = (long long)(area.right - area.left + 1) * (area.bottom - area.top + 1);
+
+		if (numAreaCells > (long long)cells.size())
+		{
+			for (auto& cell : cells) CollectCell(cell.second, rect, outVisuals);
+		}
+		else
+		{
+			for (int y = area.top; y <= area.bottom; y++)
+			{
+				for (int x = area.left; x <= area.right; x++)
+				{
+					auto it = cells.find(ToKey(x, y));
+					if (it != cells.end()) CollectCell(it->second, rect, outVisuals);
+				}
+			}
+		}
+
+		std::sort(outVisuals.begin() + prevSize, outVisuals.end(), [](const IVisual* a, const IVisual* b) {
+			auto& slotA = a->GetSlot();
+			auto& slotB = b->GetSlot();
+			return (slotA.bucket == slotB.bucket) ? (slotA.index < slotB.index) : (slotA.bucket < slotB.bucket);
+		});
+	}
+	/**
+	* Get visual bounds. Returns false for not culled visuals */
+	static bool GetBounds(const IVisual& visual, LcRectf& outBounds)
+	{
+		if (visual.GetTypeId() != LcCreatables::Sprite ||
+			visual.HasComponent(LcComponents::Tiled) ||
+			visual.HasComponent(LcComponents::Particles))
+		{
+			return false;
+		}
+
+		auto pos = visual.GetPos();
+		auto size = visual.GetSize();
+		float halfX = std::abs(size.x) / 2.0f;
+		float halfY = std::abs(size.y) / 2.0f;
+
+		if (visual.GetRotZ() != 0.0f)
+		{
+			// bounding circle for rotated sprites
+			halfX = halfY = std::sqrt(halfX * halfX + halfY * halfY);
+		}
+
+		outBounds = LcRectf{ pos.x - halfX, pos.y - halfY, pos.x + halfX, pos.y + halfY };
+		return true;
+	}
+
+
+protected:
+	inline static long long ToKey(int x, int y) { return ((long long)x << 32) | (unsigned int)y; }
+	//
+	inline int ToCell(float value) const
+	{
+		// clamp to keep unbounded rects in int range
+		float cell = std::floor(value / cellSize);
+		return static_cast<int>((cell < -1.0e9f) ? -1.0e9f : ((cell > 1.0e9f) ? 1.0e9f : cell));
+	}
+	//
+	inline LcRect ToCells(const LcRectf& rect) const
+	{
+		return LcRect{ ToCell(rect.left), ToCell(rect.top), ToCell(rect.right), ToCell(rect.bottom) };
+	}
+	//
+	inline static bool Intersects(const LcRectf& a, const LcRectf& b)
+	{
+		return a.left <= b.right && a.right >= b.left && a.top <= b.bottom && a.bottom >= b.top;
+	}
+	//
+	void CollectCell(const TVisualsList& cellVisuals, const LcRectf& rect, TVisualsList& outVisuals)
+	{
+		LcRectf bounds;
+		for (auto visual : cellVisuals)
+		{
+			auto& slot = visual->GetSlot();
+			if (slot.queryStamp == queryStamp) continue;
+
+			slot.queryStamp = queryStamp;
+			if (GetBounds(*visual, bounds) && Intersects(bounds, rect)) outVisuals.push_back(visual);
+		}
+	}
+	//
+	void Flush()
+	{
+		LcRectf bounds;
+
+		for (auto visual : dirty)
+		{
+			auto& slot = visual->GetSlot();
+			slot.dirtyIndex = -1;
+
+			if (!GetBounds(*visual, bounds))
+			{
+				RemoveFromCells(visual);
+				if (slot.unboundedIndex < 0)
+				{
+					slot.unboundedIndex = static_cast<int>(unbounded.size());
+					unbounded.push_back(visual);
+				}
+				continue;
+			}
+
+			LcRect area = ToCells(bounds);
+			if ((long long)(area.right - area.left + 1) * (area.bottom - area.top + 1) > MaxCellsPerVisual)
+			{
+				// too big for grid
+				RemoveFromCells(visual);
+				if (slot.unboundedIndex < 0)
+				{
+					slot.unboundedIndex = static_cast<int>(unbounded.size());
+					unbounded.push_back(visual);
+				}
+				continue;
+			}
+
+			if (slot.unboundedIndex >= 0)
+			{
+				EraseAt(unbounded, slot.unboundedIndex, &LcVisualSlot::unboundedIndex);
+			}
+
+			auto& cur = slot.cells;
+			if (cur.left == area.left && cur.top == area.top && cur.right == area.right && cur.bottom == area.bottom) continue;
+
+			RemoveFromCells(visual);
+			for (int y = area.top; y <= area.bottom; y++)
+			{
+				for (int x = area.left; x <= area.right; x++)
+				{
+					cells[ToKey(x, y)].push_back(visual);
+				}
+			}
+
+			slot.cells = area;
+		}
+
+		dirty.clear();
+	}
+	//
+	void RemoveFromCells(IVisual* visual)
+	{
+		auto& area = visual->GetSlot().cells;
+
+		for (int y = area.top; y <= area.bottom; y++)
+		{
+			for (int x = area.left; x <= area.right; x++)
+			{
+				auto it = cells.find(ToKey(x, y));
+				if (it == cells.end()) continue;
+
+				auto& cellVisuals = it->second;
+				auto visualIt = std::find(cellVisuals.begin(), cellVisuals.end(), visual);
+				if (visualIt != cellVisuals.end())
+				{
+					*visualIt = cellVisuals.back();
+					cellVisuals.pop_back();
+				}
+
+				if (cellVisuals.empty()) cells.erase(it);
+			}
+		}
+
+		area = LcRect{ 0, 0, -1, -1 };
+	}
+	//
+	static void EraseAt(TVisualsList& visuals, int index, int LcVisualSlot::* indexMember)
+	{
+		visuals[index]->GetSlot().*indexMember = -1;
+
+		if (index + 1 != static_cast<int>(visuals.size()))
+		{
+			visuals[index] = visuals.back();
+			visuals[index]->GetSlot().*indexMember = index;
+		}
+
+		visuals.pop_back();
+	}
+
+
+protected:
+	std::unordered_map<long long, TVisualsList> cells;
+	//
+	TVisualsList dirty;
+	//
+	TVisualsList unbounded;
+	//
+	float cellSize;
+	//
+	unsigned int queryStamp;
+
+};
@@ -51,8 +51,20 @@ class ITiledSpriteComponent : public IVisualComponent
 public:
 	//
 	virtual LcVector2 GetTilesScale() const = 0;
-	// tiles vertex data
+	// tiles vertex data, empty when released
 	virtual const std::vector<LC_TILES_DATA>& GetTilesData() const = 0;
+	// number of tiles, kept when tiles data is released
+	virtual unsigned int GetNumTiles() const = 0;
+	/**
+	* Keep tiles data after render uploaded it, true by default.
+	* Tiles data is needed only to build GPU geometry, released data is rebuilt from cooked map on demand */
+	virtual void SetKeepTilesData(bool keep) = 0;
+	/**
+	* Called by render when tiles are uploaded, frees tiles data unless it is kept */
+	virtual void OnTilesUploaded() = 0;
+	/**
+	* Rebuild released tiles data, when render needs to upload tiles again */
+	virtual void RestoreTilesData() = 0;
 };
 
 
@@ -131,6 +143,11 @@ typedef std::function<void(
 LcTiledObjectHandler;
 
 
+/**
+* Create default sprite component of the type to load it from snapshot. Returns nullptr for other types */
+WORLD_API TVComponentPtr CreateSpriteComponent(EVCType type);
+
+
 /**
 * Sprite interface */
 class WORLD_API ISprite : public IVisualBase
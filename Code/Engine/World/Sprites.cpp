@@ -10,47 +10,56 @@
 #include "World/Sprites.h"
 #include "Core/LCException.h"
 #include "Core/LCUtils.h"
+#include "World/TiledMap.h"
 
-#include <filesystem>
-
-// put nlohmann's json lib in Code/Json folder
-#include "nlohmann/json.hpp"
-
-using json = nlohmann::json;
+#include <chrono>
 
 
 void ISprite::AddCustomUVComponent(const LcAppContext& context, LcVector2 inLeftTop, LcVector2 inRightTop, LcVector2 inRightBottom, LcVector2 inLeftBottom)
 {
-	AddComponent(std::make_shared<LcSpriteCustomUVComponent>(inLeftTop, inRightTop, inRightBottom, inLeftBottom), context);
+	AddComponent(LcMakePooled<LcSpriteCustomUVComponent>(inLeftTop, inRightTop, inRightBottom, inLeftBottom), context);
 }
 
 void ISprite::AddAnimationComponent(const LcAppContext& context, LcSizef inFrameSize, unsigned short inNumFrames, float inFramesPerSecond)
 {
-	AddComponent(std::make_shared<LcSpriteAnimationComponent>(inFrameSize, inNumFrames, inFramesPerSecond), context);
+	AddComponent(LcMakePooled<LcSpriteAnimationComponent>(inFrameSize, inNumFrames, inFramesPerSecond), context);
 }
 
 void ISprite::AddTiledComponent(const LcAppContext& context, const std::string& tiledJsonPath, const LcLayersList& inLayerNames)
 {
-	AddComponent(std::make_shared<LcTiledSpriteComponent>(tiledJsonPath, inLayerNames), context);
+	AddComponent(LcMakePooled<LcTiledSpriteComponent>(tiledJsonPath, inLayerNames), context);
 }
 
 void ISprite::AddTiledComponent(const LcAppContext& context, const std::string& tiledJsonPath,
 	LcTiledObjectHandler inObjectHandler, const LcLayersList& inLayerNames)
 {
-	AddComponent(std::make_shared<LcTiledSpriteComponent>(tiledJsonPath, inObjectHandler, inLayerNames), context);
+	AddComponent(LcMakePooled<LcTiledSpriteComponent>(tiledJsonPath, inObjectHandler, inLayerNames), context);
 }
 
 void ISprite::AddParticlesComponent(const LcAppContext& context, unsigned short inNumParticles, const LcBasicParticleSettings& inSettings)
 {
-	AddComponent(std::make_shared<LcBasicParticlesComponent>(inNumParticles, inSettings), context);
+	AddComponent(LcMakePooled<LcBasicParticlesComponent>(inNumParticles, inSettings), context);
 }
 
 
+TVComponentPtr CreateSpriteComponent(EVCType type)
+{
+	switch (type)
+	{
+	case LcComponents::CustomUV: return LcMakePooled<LcSpriteCustomUVComponent>();
+	case LcComponents::FrameAnimation: return LcMakePooled<LcSpriteAnimationComponent>();
+	case LcComponents::Tiled: return LcMakePooled<LcTiledSpriteComponent>();
+	case LcComponents::Particles: return LcMakePooled<LcBasicParticlesComponent>();
+	}
+
+	return TVComponentPtr();
+}
+
 void LcSpriteAnimationComponent::Update(float deltaSeconds, const LcAppContext& context)
 {
 	IVisualComponent::Update(deltaSeconds, context);
 
-	double curGameTime = (double)GetTickCount64();
+	double curGameTime = (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 	double frameDelta = curGameTime - lastFrameSeconds;
 	float frameLength = 1.0f / framesPerSecond;
 	if ((frameDelta / 1000.0) > frameLength)
@@ -67,7 +76,7 @@ LcVector4 LcSpriteAnimationComponent::GetAnimData() const
 	{
 		if (auto texComp = sprite->GetTextureComponent())
 		{
-			auto framesPerRow = unsigned short(texComp->GetTextureSize().x / frameSize.x);
+			auto framesPerRow = (unsigned short)(texComp->GetTextureSize().x / frameSize.x);
 			auto column = curFrame % framesPerRow;
 			auto row = curFrame / framesPerRow;
 			float frameWidth = frameSize.x / texComp->GetTextureSize().x;
@@ -85,49 +94,133 @@ LcVector4 LcSpriteAnimationComponent::GetAnimData() const
 	return LcDefaults::ZeroVec4;
 }
 
+bool LcSpriteAnimationComponent::Save(LcBlobWriter& writer) const
+{
+	writer.Write(frameSize);
+	writer.Write(numFrames);
+	writer.Write(curFrame);
+	writer.Write(framesPerSecond);
+	return true;
+}
+
+void LcSpriteAnimationComponent::Load(LcBlobReader& reader)
+{
+	frameSize = reader.Read<LcSizef>();
+	numFrames = reader.Read<unsigned short>();
+	curFrame = reader.Read<unsigned short>();
+	framesPerSecond = reader.Read<float>();
+	lastFrameSeconds = 0.0;
+}
+
+bool LcTiledSpriteComponent::Save(LcBlobWriter& writer) const
+{
+	writer.WriteString(tiledJsonPath);
+	writer.Write<unsigned int>((unsigned int)layerNames.size());
+	for (auto& layerName : layerNames) writer.WriteString(layerName);
+	writer.Write(scale);
+	writer.Write(numTiles);
+	writer.Write(keepTilesData);
+	// released tiles are not saved, loaded component restores them from cooked map on demand
+	writer.WriteArray(tiles.data(), tiles.size());
+	return true;
+}
+
+void LcTiledSpriteComponent::Load(LcBlobReader& reader)
+{
+	tiledJsonPath = reader.ReadString();
+	layerNames.clear();
+	unsigned int numLayers = reader.Read<unsigned int>();
+	for (unsigned int i = 0; i < numLayers; i++) layerNames.push_back(reader.ReadString());
+	scale = reader.Read<LcVector2>();
+	numTiles = reader.Read<unsigned int>();
+	keepTilesData = reader.Read<bool>();
+	reader.ReadArray(tiles);
+	if (!tiles.empty() && tiles.size() != numTiles) throw std::exception("LcTiledSpriteComponent::Load(): Invalid tiles data");
+}
+
 void LcTiledSpriteComponent::Init(const LcAppContext& context)
 {
 	LC_TRY
 
 	if (!owner) throw std::exception("LcTiledSpriteComponent::Init(): Cannot get owner");
 
-	auto tilesFileText = ReadTextFile(tiledJsonPath.c_str());
-	if (tilesFileText.empty()) throw std::exception("LcTiledSpriteComponent::Init(): Cannot read tiled file");
+	// loaded from snapshot with texture component, tiles could be released
+	if (numTiles > 0) return;
 
-	auto tilesObject = json::parse(tilesFileText);
-	auto tilesets = tilesObject["tilesets"];
+	// JSON is parsed only when cooked map is missing or stale
+	LcCookedTiledMap map;
+	LoadCookedTiledMap(tiledJsonPath, map);
 
-	// get tileset
-	std::string tilesetFileName;
-	for (auto tileset : tilesets)
-	{
-		auto source = tileset["source"].get<std::string>();
-		if (!source.empty())
-		{
-			tilesetFileName = source;
-			break;
-		}
-	}
-
-	std::filesystem::path tilesetPath(tiledJsonPath);
-	tilesetPath.replace_filename(tilesetFileName);
-	auto tilsetFileText = ReadTextFile(tilesetPath.u8string().c_str());
-	auto tilsetObject = json::parse(tilsetFileText);
+	auto& header = map.GetHeader();
 
 	// add texture
-	auto texPath = tilsetObject["image"].get<std::string>();
+	auto texPath = map.GetString(header.texturePath);
 	if (!texPath.empty())
 	{
 		context.world->GetSpriteHelper().AddTextureComponent(texPath);
 	}
 
+	BuildTiles(map);
+
+	scale.x = owner->GetSize().x / (header.tileWidth * header.width);
+	scale.y = owner->GetSize().y / (header.tileHeight * header.height);
+
+	// process objects
+	if (objectHandler)
+	{
+		auto& objects = map.GetObjects();
+		LcTiledProps props;
+		for (const auto& layer : map.GetLayers())
+		{
+			auto layerName = map.GetString(layer.name);
+			if (map.GetString(layer.type) != LcTiles::Type::ObjectGroup) continue;
+			if (!layerNames.empty() && std::find(layerNames.begin(), layerNames.end(), layerName) == layerNames.end()) continue;
+
+			for (uint32_t objectId = 0; objectId < layer.numObjects; objectId++)
+			{
+				auto& object = objects[layer.firstObject + objectId];
+				auto pos = LcVector2{ object.x + object.width / 2.0f, object.y + object.height / 2.0f } *scale;
+				auto size = LcSizef{ object.width, object.height } *scale;
+
+				map.GetObjectProps(object, props);
+				objectHandler(layerName, map.GetString(object.name), map.GetString(object.type), props, pos, size);
+			}
+		}
+	}
+
+	LC_CATCH { LC_THROW("LcTiledSpriteComponent::Init()") }
+}
+
+void LcTiledSpriteComponent::OnTilesUploaded()
+{
+	if (!keepTilesData) std::vector<LC_TILES_DATA>().swap(tiles);
+}
+
+void LcTiledSpriteComponent::RestoreTilesData()
+{
+	LC_TRY
+
+	if (!owner) throw std::exception("LcTiledSpriteComponent::RestoreTilesData(): Cannot get owner");
+	if (!tiles.empty() || numTiles == 0) return;
+
+	LcCookedTiledMap map;
+	LoadCookedTiledMap(tiledJsonPath, map);
+	BuildTiles(map);
+
+	LC_CATCH { LC_THROW("LcTiledSpriteComponent::RestoreTilesData()") }
+}
+
+void LcTiledSpriteComponent::BuildTiles(const LcCookedTiledMap& map)
+{
+	auto& header = map.GetHeader();
+
 	// check parameters
-	auto rows = tilesObject["height"].get<int>();
-	auto columns = tilesObject["width"].get<int>();
-	auto tilewidth = tilesObject["tilewidth"].get<float>();
-	auto tileheight = tilesObject["tileheight"].get<float>();
-	auto imagewidth = tilsetObject["imagewidth"].get<float>();
-	auto imageheight = tilsetObject["imageheight"].get<float>();
+	auto rows = header.height;
+	auto columns = header.width;
+	auto tilewidth = header.tileWidth;
+	auto tileheight = header.tileHeight;
+	auto imagewidth = header.imageWidth;
+	auto imageheight = header.imageHeight;
 	if (rows <= 0 ||
 		columns <= 0 ||
 		tilewidth <= 0.0f ||
@@ -137,114 +230,68 @@ void LcTiledSpriteComponent::Init(const LcAppContext& context)
 		imagewidth < tilewidth ||
 		imageheight < tileheight)
 	{
-		throw std::exception("LcTiledSpriteComponent::Init(): Invalid tileset");
+		throw std::exception("LcTiledSpriteComponent::BuildTiles(): Invalid tileset");
 	}
 
 	float uvx = tilewidth / imagewidth;
 	float uvy = tileheight / imageheight;
-	int uvRows = int(imageheight / tileheight);
-	int uvColumns = int(imagewidth / tilewidth);
 	float offsetX = tilewidth * columns / -2.0f;
 	float offsetY = tileheight * rows / -2.0f;
 	float z = owner->GetPos().z;
-	scale.x = owner->GetSize().x / (tilewidth * columns);
-	scale.y = owner->GetSize().y / (tileheight * rows);
 
-	for (auto layer : tilesObject["layers"])
+	auto isValidLayer = [this](const std::string& layerName) {
+		return layerNames.empty() || std::find(layerNames.begin(), layerNames.end(), layerName) != layerNames.end();
+	};
+
+	auto& layers = map.GetLayers();
+	auto& gids = map.GetTiles();
+	auto& uvs = map.GetUVs();
+
+	// reserve tiles once
+	size_t layersTiles = 0;
+	for (const auto& layer : layers)
 	{
-		auto curLayerName = layer["name"].get<std::string>();
-		auto curLayerType = layer["type"].get<std::string>();
-		bool layerFound = std::find(layerNames.begin(), layerNames.end(), curLayerName) != layerNames.end();
-		bool validLayer = layerFound || layerNames.empty();
-		if (!validLayer) continue;
-
-		// add tiles
-		auto layerTiles = layer["data"];
-		if (layerTiles.is_array() && (curLayerType == LcTiles::Type::TileLayer))
-		{
-			int tileId = 0;
-			for (size_t id = 0; id < layerTiles.size(); id++)
-			{
-				int uvTileId = layerTiles[id].get<int>();
-				if (uvTileId != 0)
-				{
-					uvTileId--; // 0 - means invalid, starts from 1, remap to 0
-
-					int row = tileId / columns;
-					int column = tileId % columns;
-					float x = tilewidth * column + offsetX;
-					float y = tileheight * row + offsetY;
-
-					int uvRow = uvTileId / uvColumns;
-					int uvColumn = uvTileId % uvColumns;
-					float ox = uvx * uvColumn;
-					float oy = uvy * uvRow;
-
-					LC_TILES_DATA tile{};
-					tile.pos[0] = LcVector3{ x, y, z };
-					tile.pos[1] = LcVector3{ x + tilewidth, y + tileheight, z };
-					tile.pos[2] = LcVector3{ x + tilewidth, y, z };
-					tile.pos[3] = LcVector3{ x, y + tileheight, z };
-					tile.uv[0] = LcVector2{ ox, oy };
-					tile.uv[1] = LcVector2{ ox + uvx, oy + uvy };
-					tile.uv[2] = LcVector2{ ox + uvx, oy };
-					tile.uv[3] = LcVector2{ ox, oy + uvy };
-					tiles.push_back(tile);
-				}
-
-				tileId++;
-			}
+		if (map.GetString(layer.type) != LcTiles::Type::TileLayer || !isValidLayer(map.GetString(layer.name))) continue;
 
-			continue;
-		}
+		auto layerTiles = gids.begin() + layer.firstTile;
+		layersTiles += layer.numTiles - std::count(layerTiles, layerTiles + layer.numTiles, 0u);
+	}
 
-		// process objects
-		auto layerObjects = layer["objects"];
-		if (layerObjects.is_array() && (curLayerType == LcTiles::Type::ObjectGroup) && objectHandler)
-		{
-			for (auto object : layerObjects)
-			{
-				auto x = object["x"].get<float>();
-				auto y = object["y"].get<float>();
-				auto width = object["width"].get<float>();
-				auto height = object["height"].get<float>();
-				auto pos = LcVector2{ x + width / 2.0f, y + height / 2.0f } *scale;
-				auto size = LcSizef{ width, height } *scale;
-
-				auto objectName = object["name"].get<std::string>();
-				auto objectType = object["type"].get<std::string>();
-				auto properties = object["properties"];
-
-				LcTiledProps props;
-				if (properties.is_array())
-				{
-					for (auto entry : properties)
-					{
-						std::pair<std::string, LcAny> newProp;
-						newProp.first = entry["name"].get<std::string>();
-
-						auto type = entry["type"].get<std::string>();
-						if (type == "int")
-							newProp.second = LcAny(entry["value"].get<int>());
-						else if (type == "float")
-							newProp.second = LcAny(entry["value"].get<float>());
-						else if (type == "bool")
-							newProp.second = LcAny(entry["value"].get<bool>());
-						else if (type == "string")
-							newProp.second = LcAny(entry["value"].get<std::string>());
-
-						props.push_back(newProp);
-					}
-				}
-
-				objectHandler(curLayerName, objectName, objectType, props, pos, size);
-			}
+	tiles.clear();
+	tiles.reserve(layersTiles);
+
+	for (const auto& layer : layers)
+	{
+		if (map.GetString(layer.type) != LcTiles::Type::TileLayer || !isValidLayer(map.GetString(layer.name))) continue;
 
-			continue;
+		for (uint32_t tileId = 0; tileId < layer.numTiles; tileId++)
+		{
+			uint32_t gid = gids[layer.firstTile + tileId];
+			if (gid == 0) continue; // 0 - means invalid, starts from 1
+
+			int row = int(tileId) / columns;
+			int column = int(tileId) % columns;
+			float x = tilewidth * column + offsetX;
+			float y = tileheight * row + offsetY;
+
+			auto& uv = uvs[gid - 1];
+			float ox = uv.x;
+			float oy = uv.y;
+
+			LC_TILES_DATA tile{};
+			tile.pos[0] = LcVector3{ x, y, z };
+			tile.pos[1] = LcVector3{ x + tilewidth, y + tileheight, z };
+			tile.pos[2] = LcVector3{ x + tilewidth, y, z };
+			tile.pos[3] = LcVector3{ x, y + tileheight, z };
+			tile.uv[0] = LcVector2{ ox, oy };
+			tile.uv[1] = LcVector2{ ox + uvx, oy + uvy };
+			tile.uv[2] = LcVector2{ ox + uvx, oy };
+			tile.uv[3] = LcVector2{ ox, oy + uvy };
+			tiles.push_back(tile);
 		}
 	}
 
-	LC_CATCH { LC_THROW("LcTiledSpriteComponent::Init()") }
+	numTiles = (unsigned int)tiles.size();
 }
 
 
@@ -253,6 +300,36 @@ void LcSprite::AddComponent(TVComponentPtr comp, const LcAppContext& context)
 	IVisualBase::AddComponent(comp, context);
 
 	features.insert(comp->GetType());
+	featureMask |= ToFeatureBit(comp->GetType());
+
+	// tiled and particles sprites are not culled
+	OnBoundsChanged();
+}
+
+void LcSprite::Reset(const LcAppContext& context)
+{
+	IVisualBase::Reset(context);
+
+	features.clear();
+	pos = LcDefaults::ZeroVec3;
+	size = LcDefaults::ZeroSize;
+	rotZ = 0.0f;
+	visible = true;
+}
+
+void LcSprite::RemoveComponent(IVisualComponent* comp, const LcAppContext& context)
+{
+	if (!comp) return;
+
+	EVCType type = comp->GetType();
+	IVisualBase::RemoveComponent(comp, context);
+
+	if (!HasComponent(type))
+	{
+		features.erase(type);
+		featureMask &= ~ToFeatureBit(type);
+		OnBoundsChanged();
+	}
 }
 
 
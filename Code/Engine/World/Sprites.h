@@ -9,6 +9,7 @@
 #include "Module.h"
 #include "SpriteInterface.h"
 #include "World/WorldInterface.h"
+#include "Core/LCSerializer.h"
 
 
 class LcSpriteCustomUVComponent : public ISpriteCustomUVComponent
@@ -35,6 +36,25 @@ public: // ISpriteCustomUVComponent interface implementation
 public: // IVisualComponent interface implementation
 	//
 	virtual EVCType GetType() const override { return LcComponents::CustomUV; }
+	//
+	virtual bool IsThreadSafe() const override { return true; }
+	//
+	virtual bool Save(LcBlobWriter& writer) const override
+	{
+		writer.Write(leftTop);
+		writer.Write(rightTop);
+		writer.Write(rightBottom);
+		writer.Write(leftBottom);
+		return true;
+	}
+	//
+	virtual void Load(LcBlobReader& reader) override
+	{
+		leftTop = reader.Read<LcVector4>();
+		rightTop = reader.Read<LcVector4>();
+		rightBottom = reader.Read<LcVector4>();
+		leftBottom = reader.Read<LcVector4>();
+	}
 
 
 protected:
@@ -71,6 +91,12 @@ public: // IVisualComponent interface implementation
 	virtual void Update(float deltaSeconds, const LcAppContext& context) override;
 	//
 	virtual EVCType GetType() const override { return LcComponents::FrameAnimation; }
+	//
+	virtual bool IsThreadSafe() const override { return true; }
+	//
+	virtual bool Save(LcBlobWriter& writer) const override;
+	//
+	virtual void Load(LcBlobReader& reader) override;
 
 
 protected:
@@ -86,16 +112,16 @@ class WORLD_API LcTiledSpriteComponent : public ITiledSpriteComponent
 {
 public:
 	//
-	LcTiledSpriteComponent() : scale(LcDefaults::OneVec2) {}
+	LcTiledSpriteComponent() : scale(LcDefaults::OneVec2), numTiles(0), keepTilesData(true) {}
 	//
 	LcTiledSpriteComponent(const LcTiledSpriteComponent& sprite) = default;
 	//
 	LcTiledSpriteComponent(const std::string& inTiledJsonPath, const LcLayersList& inLayerNames = LcLayersList{}) :
-		tiledJsonPath(inTiledJsonPath), layerNames(inLayerNames), scale(LcDefaults::OneVec2) {}
+		tiledJsonPath(inTiledJsonPath), layerNames(inLayerNames), scale(LcDefaults::OneVec2), numTiles(0), keepTilesData(true) {}
 	//
 	LcTiledSpriteComponent(const std::string& inTiledJsonPath, LcTiledObjectHandler inObjectHandler,
 		const LcLayersList& inLayerNames = LcLayersList{}) : tiledJsonPath(inTiledJsonPath), layerNames(inLayerNames),
-		objectHandler(inObjectHandler), scale(LcDefaults::OneVec2) {}
+		objectHandler(inObjectHandler), scale(LcDefaults::OneVec2), numTiles(0), keepTilesData(true) {}
 
 
 public: // ITiledSpriteComponent interface implementation
@@ -103,6 +129,14 @@ public: // ITiledSpriteComponent interface implementation
 	virtual LcVector2 GetTilesScale() const override { return scale; }
 	//
 	virtual const std::vector<LC_TILES_DATA>& GetTilesData() const override { return tiles; }
+	//
+	virtual unsigned int GetNumTiles() const override { return numTiles; }
+	//
+	virtual void SetKeepTilesData(bool keep) override { keepTilesData = keep; }
+	//
+	virtual void OnTilesUploaded() override;
+	//
+	virtual void RestoreTilesData() override;
 
 
 public: // IVisualComponent interface implementation
@@ -110,6 +144,14 @@ public: // IVisualComponent interface implementation
 	virtual void Init(const LcAppContext& context) override;
 	//
 	virtual EVCType GetType() const override { return LcComponents::Tiled; }
+	//
+	virtual bool IsThreadSafe() const override { return true; }
+	/**
+	* Saves built tiles, so loaded component does not parse tiled file.
+	* Released tiles are restored from cooked map when render needs them */
+	virtual bool Save(LcBlobWriter& writer) const override;
+	//
+	virtual void Load(LcBlobReader& reader) override;
 
 
 protected:
@@ -118,6 +160,12 @@ protected:
 	LcTiledObjectHandler objectHandler;
 	LcLayersList layerNames;
 	LcVector2 scale;
+	unsigned int numTiles;
+	bool keepTilesData;
+
+
+protected:
+	void BuildTiles(const class LcCookedTiledMap& map);
 };
 
 
@@ -125,7 +173,7 @@ class LcBasicParticlesComponent : public IBasicParticlesComponent
 {
 public:
 	//
-	LcBasicParticlesComponent() = default;
+	LcBasicParticlesComponent() : numParticles(0) {}
 	//
 	LcBasicParticlesComponent(const LcBasicParticlesComponent& sprite) = default;
 	//
@@ -143,6 +191,12 @@ public: // IBasicParticlesComponent interface implementation
 public: // IVisualComponent interface implementation
 	//
 	virtual EVCType GetType() const override { return LcComponents::Particles; }
+	//
+	virtual bool IsThreadSafe() const override { return true; }
+	//
+	virtual bool Save(LcBlobWriter& writer) const override { writer.Write(numParticles); writer.Write(settings); return true; }
+	//
+	virtual void Load(LcBlobReader& reader) override { numParticles = reader.Read<unsigned short>(); settings = reader.Read<LcBasicParticleSettings>(); }
 
 
 protected:
@@ -168,24 +222,28 @@ public: // ISprite interface implementation
 
 
 public: // IVisual interface implementation
+	//
+	virtual void Reset(const LcAppContext& context) override;
 	//
 	virtual void AddComponent(TVComponentPtr comp, const LcAppContext& context) override;
 	//
-	virtual void SetSize(LcSizef inSize) override { size = inSize; }
+	virtual void RemoveComponent(class IVisualComponent* comp, const LcAppContext& context) override;
+	//
+	virtual void SetSize(LcSizef inSize) override { size = inSize; OnBoundsChanged(); }
 	//
 	virtual LcSizef GetSize() const override { return size; }
 	//
-	virtual void SetPos(LcVector3 inPos) override { pos = inPos; }
+	virtual void SetPos(LcVector3 inPos) override { bool newLayer = (pos.z != inPos.z); pos = inPos; if (newLayer) OnLayerChanged(); OnBoundsChanged(); }
 	//
-	virtual void SetPos(LcVector2 inPos) override { pos = LcVector3{ inPos.x, inPos.y, pos.z }; }
+	virtual void SetPos(LcVector2 inPos) override { pos = LcVector3{ inPos.x, inPos.y, pos.z }; OnBoundsChanged(); }
 	//
-	virtual void AddPos(LcVector3 inPos) override { pos = pos + inPos; }
+	virtual void AddPos(LcVector3 inPos) override { pos = pos + inPos; if (inPos.z != 0.0f) OnLayerChanged(); OnBoundsChanged(); }
 	//
 	virtual LcVector3 GetPos() const override { return pos; }
 	//
-	virtual void SetRotZ(float inRotZ) override { rotZ = inRotZ; }
+	virtual void SetRotZ(float inRotZ) override { rotZ = inRotZ; OnBoundsChanged(); }
 	//
-	virtual void AddRotZ(float inRotZ) override { rotZ += inRotZ; }
+	virtual void AddRotZ(float inRotZ) override { rotZ += inRotZ; OnBoundsChanged(); }
 	//
 	virtual float GetRotZ() const override { return rotZ; }
 	//
@@ -0,0 +1,727 @@
+/**
+* TiledMap.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "World/TiledMap.h"
+#include "Core/LCException.h"
+#include "Core/LCCompression.h"
+
+#include <deque>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+// put nlohmann's json lib in Code/Json folder
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+
+/**
+* SAX handler for Tiled map. Tiled writes keys in alphabetical order, so map size
+* and tileset follow layers and layer name follows its data: everything is stored
+* in plain arrays and resolved after parsing.
+* Base64 layer data comes before its encoding and size, so it is decoded when layer ends.
+*/
+class LcTiledMapSaxHandler
+{
+public:
+	LcTiledMapSaxHandler(LcTiledMapData& inMap, bool inLoadObjects) : map(inMap), loadObjects(inLoadObjects), skipDepth(0),
+		layerWidth(0), layerHeight(0), propNumber(0.0), propBool(false), propKind(LcPropKind::None) {}
+	//
+	inline const std::string& GetError() const { return error; }
+
+
+public: // nlohmann SAX interface
+	//
+	bool null() { return true; }
+	//
+	bool boolean(bool value)
+	{
+		if (skipDepth == 0 && Top() == LcNode::Property && curKey == "value")
+		{
+			propBool = value;
+			propKind = LcPropKind::Bool;
+		}
+
+		return true;
+	}
+	//
+	bool number_integer(json::number_integer_t value)
+	{
+		if (skipDepth == 0 && Top() == LcNode::Data) map.layers.back().tiles.push_back(static_cast<uint32_t>(value));
+		else OnNumber(static_cast<double>(value));
+		return true;
+	}
+	//
+	bool number_unsigned(json::number_unsigned_t value)
+	{
+		if (skipDepth == 0 && Top() == LcNode::Data) map.layers.back().tiles.push_back(static_cast<uint32_t>(value));
+		else OnNumber(static_cast<double>(value));
+		return true;
+	}
+	//
+	bool number_float(json::number_float_t value, const json::string_t&)
+	{
+		if (skipDepth == 0 && Top() == LcNode::Data) map.layers.back().tiles.push_back(static_cast<uint32_t>(value));
+		else OnNumber(value);
+		return true;
+	}
+	//
+	bool string(json::string_t& value)
+	{
+		if (skipDepth > 0) return true;
+
+		switch (Top())
+		{
+		case LcNode::Layer:
+			if (curKey == "name") map.layers.back().name = std::move(value);
+			else if (curKey == "type") map.layers.back().type = std::move(value);
+			else if (curKey == "data") layerData = std::move(value);
+			else if (curKey == "encoding") layerEncoding = std::move(value);
+			else if (curKey == "compression") layerCompression = std::move(value);
+			break;
+		case LcNode::Object:
+			if (curKey == "name") map.layers.back().objects.back().name = std::move(value);
+			else if (curKey == "type") map.layers.back().objects.back().type = std::move(value);
+			break;
+		case LcNode::Property:
+			if (curKey == "name") propName = std::move(value);
+			else if (curKey == "type") propType = std::move(value);
+			else if (curKey == "value") { propString = std::move(value); propKind = LcPropKind::String; }
+			break;
+		case LcNode::Tileset:
+			if (curKey == "source" && map.tilesetSource.empty()) map.tilesetSource = std::move(value);
+			break;
+		default:
+			break;
+		}
+
+		return true;
+	}
+	//
+	bool binary(json::binary_t&) { return true; }
+	//
+	bool key(json::string_t& value)
+	{
+		if (skipDepth == 0) curKey = std::move(value);
+		return true;
+	}
+	//
+	bool start_object(std::size_t)
+	{
+		if (skipDepth > 0) { skipDepth++; return true; }
+
+		if (nodes.empty())
+		{
+			nodes.push_back(LcNode::Root);
+			return true;
+		}
+
+		switch (Top())
+		{
+		case LcNode::Layers:
+			map.layers.emplace_back();
+			layerData.clear();
+			layerEncoding.clear();
+			layerCompression.clear();
+			layerWidth = 0;
+			layerHeight = 0;
+			nodes.push_back(LcNode::Layer);
+			break;
+		case LcNode::Objects:
+			map.layers.back().objects.emplace_back(LcTiledObjectData{ "", "", 0.0f, 0.0f, 0.0f, 0.0f, LcTiledProps() });
+			nodes.push_back(LcNode::Object);
+			break;
+		case LcNode::Properties:
+			propName.clear();
+			propType.clear();
+			propString.clear();
+			propKind = LcPropKind::None;
+			nodes.push_back(LcNode::Property);
+			break;
+		case LcNode::Tilesets:
+			nodes.push_back(LcNode::Tileset);
+			break;
+		default:
+			skipDepth = 1;
+			break;
+		}
+
+		return true;
+	}
+	//
+	bool end_object()
+	{
+		if (skipDepth > 0) { skipDepth--; return true; }
+
+		if (Top() == LcNode::Property) AddProperty();
+
+		if (Top() == LcNode::Layer && !layerData.empty())
+		{
+			try
+			{
+				DecodeLayerData();
+			}
+			catch (const std::exception& ex)
+			{
+				error = "Layer '" + map.layers.back().name + "': " + ex.what();
+				return false;
+			}
+		}
+
+		nodes.pop_back();
+		return true;
+	}
+	//
+	bool start_array(std::size_t)
+	{
+		if (skipDepth > 0) { skipDepth++; return true; }
+
+		auto node = nodes.empty() ? LcNode::Root : Top();
+		if (node == LcNode::Root && curKey == "layers")
+		{
+			nodes.push_back(LcNode::Layers);
+		}
+		else if (node == LcNode::Root && curKey == "tilesets")
+		{
+			nodes.push_back(LcNode::Tilesets);
+		}
+		else if (node == LcNode::Layer && curKey == "data")
+		{
+			// layers usually have the same size
+			size_t numLayers = map.layers.size();
+			if (numLayers > 1) map.layers.back().tiles.reserve(map.layers[numLayers - 2].tiles.size());
+
+			nodes.push_back(LcNode::Data);
+		}
+		else if (node == LcNode::Layer && curKey == "objects" && loadObjects)
+		{
+			nodes.push_back(LcNode::Objects);
+		}
+		else if (node == LcNode::Object && curKey == "properties")
+		{
+			nodes.push_back(LcNode::Properties);
+		}
+		else
+		{
+			skipDepth = 1;
+		}
+
+		return true;
+	}
+	//
+	bool end_array()
+	{
+		if (skipDepth > 0) { skipDepth--; return true; }
+
+		nodes.pop_back();
+		return true;
+	}
+	//
+	bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex)
+	{
+		error = ex.what();
+		return false;
+	}
+
+
+protected:
+	enum class LcNode { Root, Layers, Layer, Data, Objects, Object, Properties, Property, Tilesets, Tileset };
+	//
+	enum class LcPropKind { None, Number, Bool, String };
+	//
+	inline LcNode Top() const { return nodes.back(); }
+	//
+	void OnNumber(double value)
+	{
+		if (skipDepth > 0 || nodes.empty()) return;
+
+		switch (Top())
+		{
+		case LcNode::Root:
+			if (curKey == "width") map.width = static_cast<int>(value);
+			else if (curKey == "height") map.height = static_cast<int>(value);
+			else if (curKey == "tilewidth") map.tileWidth = static_cast<float>(value);
+			else if (curKey == "tileheight") map.tileHeight = static_cast<float>(value);
+			break;
+		case LcNode::Layer:
+			if (curKey == "width") layerWidth = static_cast<int>(value);
+			else if (curKey == "height") layerHeight = static_cast<int>(value);
+			break;
+		case LcNode::Object:
+			{
+				auto& object = map.layers.back().objects.back();
+				if (curKey == "x") object.x = static_cast<float>(value);
+				else if (curKey == "y") object.y = static_cast<float>(value);
+				else if (curKey == "width") object.width = static_cast<float>(value);
+				else if (curKey == "height") object.height = static_cast<float>(value);
+			}
+			break;
+		case LcNode::Property:
+			if (curKey == "value")
+			{
+				propNumber = value;
+				propKind = LcPropKind::Number;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	/**
+	* Decode base64 layer data to tiles, decompressing directly to tiles array */
+	void DecodeLayerData()
+	{
+		if (layerEncoding != "base64") throw std::exception("Unsupported layer encoding");
+		if (layerWidth <= 0 || layerHeight <= 0) throw std::exception("Invalid layer size");
+		if (layerCompression == "zstd" && !IsZstdSupported())
+		{
+			throw std::exception("Zstd layer compression is not supported by this build, save map with zlib or gzip compression");
+		}
+
+		auto& tiles = map.layers.back().tiles;
+		size_t tilesSize = static_cast<size_t>(layerWidth) * static_cast<size_t>(layerHeight) * sizeof(uint32_t);
+
+		// gids are stored little endian, as on target platforms
+		tiles.resize(static_cast<size_t>(layerWidth) * static_cast<size_t>(layerHeight));
+
+		size_t decodedSize = 0;
+		if (layerCompression.empty())
+		{
+			decodedSize = DecodeBase64(layerData.data(), layerData.size(), tiles.data(), tilesSize);
+		}
+		else
+		{
+			// compressed data is shorter than text, decode it in place
+			size_t dataSize = DecodeBase64(layerData.data(), layerData.size(), layerData.data(), layerData.size());
+
+			if (layerCompression == "zlib") decodedSize = InflateZlib(layerData.data(), dataSize, tiles.data(), tilesSize);
+			else if (layerCompression == "gzip") decodedSize = InflateGzip(layerData.data(), dataSize, tiles.data(), tilesSize);
+			else if (layerCompression == "zstd") decodedSize = DecompressZstd(layerData.data(), dataSize, tiles.data(), tilesSize);
+			else throw std::exception("Unsupported layer compression");
+		}
+
+		if (decodedSize != tilesSize) throw std::exception("Invalid layer data size");
+
+		layerData.clear();
+	}
+	//
+	void AddProperty()
+	{
+		std::pair<std::string, LcAny> newProp;
+		newProp.first = std::move(propName);
+
+		if (propType == "int" && propKind == LcPropKind::Number)
+			newProp.second = LcAny(static_cast<int>(propNumber));
+		else if (propType == "float" && propKind == LcPropKind::Number)
+			newProp.second = LcAny(static_cast<float>(propNumber));
+		else if (propType == "bool" && propKind == LcPropKind::Bool)
+			newProp.second = LcAny(propBool);
+		else if (propType == "string" && propKind == LcPropKind::String)
+			newProp.second = LcAny(propString);
+
+		map.layers.back().objects.back().props.push_back(newProp);
+	}
+
+
+protected:
+	LcTiledMapData& map;
+	//
+	bool loadObjects;
+	//
+	std::deque<LcNode> nodes;
+	// last key in current object
+	std::string curKey;
+	// depth of skipped values
+	int skipDepth;
+	// current layer encoded data, decoded when layer ends
+	std::string layerData;
+	//
+	std::string layerEncoding;
+	//
+	std::string layerCompression;
+	//
+	int layerWidth;
+	//
+	int layerHeight;
+	//
+	std::string error;
+	// current object property
+	std::string propName;
+	//
+	std::string propType;
+	//
+	std::string propString;
+	//
+	double propNumber;
+	//
+	bool propBool;
+	//
+	LcPropKind propKind;
+
+};
+
+
+void ParseTiledMap(const std::string& jsonText, bool loadObjects, LcTiledMapData& outMap)
+{
+	outMap = LcTiledMapData();
+
+	LcTiledMapSaxHandler handler(outMap, loadObjects);
+	if (!json::sax_parse(jsonText, &handler))
+	{
+		throw std::exception(("ParseTiledMap(): " + handler.GetError()).c_str());
+	}
+}
+
+
+/** Tiled stores flip flags in high gid bits, they are not supported */
+constexpr uint32_t LcTiledGidMask = 0x0FFFFFFF;
+
+
+/** Interned strings of cooked map */
+class LcCookedStrings
+{
+public:
+	uint32_t Add(const std::string& value)
+	{
+		auto it = ids.find(value);
+		if (it != ids.end()) return it->second;
+
+		auto id = static_cast<uint32_t>(strings.size());
+		strings.push_back(LcCookedString{ static_cast<uint32_t>(chars.size()), static_cast<uint32_t>(value.size()) });
+		chars.insert(chars.end(), value.begin(), value.end());
+		ids.emplace(value, id);
+
+		return id;
+	}
+
+
+public:
+	std::vector<char> chars;
+	//
+	std::vector<LcCookedString> strings;
+	//
+	std::unordered_map<std::string, uint32_t> ids;
+
+};
+
+
+// size and write time of the file, zero if file is missing
+static void GetFileStamp(const std::filesystem::path& path, uint64_t& outSize, int64_t& outTime)
+{
+	std::error_code error;
+	outSize = std::filesystem::file_size(path, error);
+	if (error) outSize = 0;
+
+	auto time = std::filesystem::last_write_time(path, error);
+	outTime = error ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+// check source file is not changed, hash it only when its stamp is changed
+static bool IsSourceUpToDate(const std::filesystem::path& path, uint64_t size, int64_t time, uint64_t hash)
+{
+	std::error_code error;
+	if (!std::filesystem::exists(path, error)) return true;
+
+	uint64_t curSize = 0;
+	int64_t curTime = 0;
+	GetFileStamp(path, curSize, curTime);
+	if (curSize == size && curTime == time) return true;
+	if (curSize != size) return false;
+
+	// touched but maybe not changed, like after checkout
+	auto data = ReadBinaryFile(path.u8string().c_str());
+	return HashBytes(data.data(), data.size()) == hash;
+}
+
+void CookTiledMap(const std::string& tiledJsonPath, LcBytes& outData)
+{
+	LC_TRY
+
+	// stamp before read, so file changed while cooking is cooked again
+	uint64_t mapSize = 0;
+	int64_t mapTime = 0;
+	GetFileStamp(std::filesystem::path(tiledJsonPath), mapSize, mapTime);
+
+	auto mapText = ReadTextFile(tiledJsonPath.c_str());
+	if (mapText.empty()) throw std::exception("Cannot read tiled file");
+
+	LcTiledMapData map;
+	ParseTiledMap(mapText, true, map);
+	if (map.tilesetSource.empty()) throw std::exception("No external tileset");
+
+	// tileset file is small, parse it at once
+	std::filesystem::path tilesetPath(tiledJsonPath);
+	tilesetPath.replace_filename(map.tilesetSource);
+
+	uint64_t tilesetSize = 0;
+	int64_t tilesetTime = 0;
+	GetFileStamp(tilesetPath, tilesetSize, tilesetTime);
+
+	auto tilesetText = ReadTextFile(tilesetPath.u8string().c_str());
+	auto tileset = json::parse(tilesetText);
+
+	LcCookedStrings strings;
+	LcCookedMapHeader header{};
+	header.version = LcCookedMapVersion;
+	header.width = map.width;
+	header.height = map.height;
+	header.tileWidth = map.tileWidth;
+	header.tileHeight = map.tileHeight;
+	header.imageWidth = tileset["imagewidth"].get<float>();
+	header.imageHeight = tileset["imageheight"].get<float>();
+	header.texturePath = strings.Add(tileset["image"].get<std::string>());
+	header.tilesetSource = strings.Add(map.tilesetSource);
+	header.mapHash = HashBytes(mapText.data(), mapText.size());
+	header.tilesetHash = HashBytes(tilesetText.data(), tilesetText.size());
+	header.mapSize = mapSize;
+	header.mapTime = mapTime;
+	header.tilesetSize = tilesetSize;
+	header.tilesetTime = tilesetTime;
+
+	if (header.width <= 0 ||
+		header.height <= 0 ||
+		header.tileWidth <= 0.0f ||
+		header.tileHeight <= 0.0f ||
+		header.imageWidth < header.tileWidth ||
+		header.imageHeight < header.tileHeight)
+	{
+		throw std::exception("Invalid tileset");
+	}
+
+	std::vector<LcCookedLayer> layers;
+	std::vector<uint32_t> tiles;
+	std::vector<LcCookedObject> objects;
+	std::vector<LcCookedProp> props;
+	uint32_t maxTileId = 0;
+
+	layers.reserve(map.layers.size());
+	for (auto& layer : map.layers)
+	{
+		LcCookedLayer cookedLayer{ strings.Add(layer.name), strings.Add(layer.type),
+			static_cast<uint32_t>(tiles.size()), static_cast<uint32_t>(layer.tiles.size()),
+			static_cast<uint32_t>(objects.size()), static_cast<uint32_t>(layer.objects.size()) };
+
+		for (auto gid : layer.tiles)
+		{
+			gid &= LcTiledGidMask;
+			maxTileId = (std::max)(maxTileId, gid);
+			tiles.push_back(gid);
+		}
+
+		for (auto& object : layer.objects)
+		{
+			objects.push_back(LcCookedObject{ strings.Add(object.name), strings.Add(object.type),
+				object.x, object.y, object.width, object.height,
+				static_cast<uint32_t>(props.size()), static_cast<uint32_t>(object.props.size()) });
+
+			for (auto& prop : object.props)
+			{
+				auto& value = prop.second;
+				uint32_t sValue = (value.type == LcAny::LcAnyType::StringAny) ? strings.Add(value.sValue) : 0;
+				props.push_back(LcCookedProp{ strings.Add(prop.first), static_cast<uint32_t>(value.type), value.iValue, value.fValue, sValue });
+			}
+		}
+
+		layers.push_back(cookedLayer);
+	}
+
+	// UV table covers tileset and all used tiles
+	int uvColumns = int(header.imageWidth / header.tileWidth);
+	int uvRows = int(header.imageHeight / header.tileHeight);
+	float uvx = header.tileWidth / header.imageWidth;
+	float uvy = header.tileHeight / header.imageHeight;
+	std::vector<LcVector2> uvs((std::max)(static_cast<size_t>(uvColumns * uvRows), static_cast<size_t>(maxTileId)));
+	for (size_t uvTileId = 0; uvTileId < uvs.size(); uvTileId++)
+	{
+		uvs[uvTileId] = LcVector2{ uvx * (uvTileId % uvColumns), uvy * (uvTileId / uvColumns) };
+	}
+
+	LcArchiveWriter writer;
+	writer.AddSection(LcCookedMapSections::Header, LcCookedMapVersion, &header, sizeof(header), 1);
+	writer.AddSection(LcCookedMapSections::StringChars, LcCookedMapVersion, strings.chars);
+	writer.AddSection(LcCookedMapSections::Strings, LcCookedMapVersion, strings.strings);
+	writer.AddSection(LcCookedMapSections::UVs, LcCookedMapVersion, uvs);
+	writer.AddSection(LcCookedMapSections::Layers, LcCookedMapVersion, layers);
+	writer.AddSection(LcCookedMapSections::Tiles, LcCookedMapVersion, tiles);
+	writer.AddSection(LcCookedMapSections::Objects, LcCookedMapVersion, objects);
+	writer.AddSection(LcCookedMapSections::Props, LcCookedMapVersion, props);
+	writer.Finish(outData);
+
+	LC_CATCH{ LC_THROW_EX("CookTiledMap('", tiledJsonPath.c_str(), "')"); }
+}
+
+std::string GetCookedMapPath(const std::string& tiledJsonPath)
+{
+	std::filesystem::path cookedPath(tiledJsonPath);
+	cookedPath.replace_extension(LcCookedMapExt);
+	return cookedPath.u8string();
+}
+
+void LoadCookedTiledMap(const std::string& tiledPath, LcCookedTiledMap& outMap)
+{
+	LC_TRY
+
+	if (std::filesystem::path(tiledPath).extension() == LcCookedMapExt)
+	{
+		outMap.Open(tiledPath);
+		return;
+	}
+
+	auto cookedPath = GetCookedMapPath(tiledPath);
+	std::error_code error;
+	if (std::filesystem::exists(cookedPath, error))
+	{
+		try
+		{
+			outMap.Open(cookedPath);
+			if (outMap.IsUpToDate(tiledPath)) return;
+		}
+		catch (const std::exception& ex)
+		{
+			DebugMsg("LoadCookedTiledMap(): %s\n", ex.what());
+		}
+
+		// cooked file is mapped
+		outMap.Close();
+	}
+
+	LcBytes cookedData;
+	CookTiledMap(tiledPath, cookedData);
+
+	try
+	{
+		WriteBinaryFile(cookedPath.c_str(), cookedData);
+	}
+	catch (const std::exception& ex)
+	{
+		// map folder could be read only, use cooked data anyway
+		DebugMsg("LoadCookedTiledMap(): %s\n", ex.what());
+	}
+
+	outMap.Open(std::move(cookedData));
+
+	LC_CATCH{ LC_THROW_EX("LoadCookedTiledMap('", tiledPath.c_str(), "')"); }
+}
+
+
+void LcCookedTiledMap::Open(const std::string& cookedPath)
+{
+	Close();
+	file.Open(cookedPath.c_str());
+	Init(file.GetData(), file.GetSize());
+}
+
+void LcCookedTiledMap::Open(LcBytes&& cookedData)
+{
+	Close();
+	bytes = std::move(cookedData);
+	Init(bytes.data(), bytes.size());
+}
+
+void LcCookedTiledMap::Close()
+{
+	header = nullptr;
+	stringChars = LcCookedArray<char>();
+	strings = LcCookedArray<LcCookedString>();
+	uvs = LcCookedArray<LcVector2>();
+	layers = LcCookedArray<LcCookedLayer>();
+	tiles = LcCookedArray<uint32_t>();
+	objects = LcCookedArray<LcCookedObject>();
+	props = LcCookedArray<LcCookedProp>();
+	bytes.clear();
+	file.Close();
+}
+
+void LcCookedTiledMap::Init(const void* data, size_t size)
+{
+	LcArchiveReader reader(data, size);
+
+	size_t numHeaders = 0;
+	header = reader.GetItems<LcCookedMapHeader>(LcCookedMapSections::Header, LcCookedMapVersion, numHeaders);
+	if (!header || numHeaders != 1 || header->version != LcCookedMapVersion)
+	{
+		header = nullptr;
+		throw std::exception("LcCookedTiledMap::Init(): Invalid header");
+	}
+
+	GetArray(reader, LcCookedMapSections::StringChars, stringChars);
+	GetArray(reader, LcCookedMapSections::Strings, strings);
+	GetArray(reader, LcCookedMapSections::UVs, uvs);
+	GetArray(reader, LcCookedMapSections::Layers, layers);
+	GetArray(reader, LcCookedMapSections::Tiles, tiles);
+	GetArray(reader, LcCookedMapSections::Objects, objects);
+	GetArray(reader, LcCookedMapSections::Props, props);
+
+	// validate references once, so map is used without checks
+	auto isValidRange = [](uint32_t first, uint32_t count, size_t size) { return static_cast<uint64_t>(first) + count <= size; };
+	auto isValidString = [this](uint32_t id) { return id < strings.size(); };
+
+	bool valid = isValidString(header->texturePath) && isValidString(header->tilesetSource);
+	for (auto& string : strings) valid = valid && isValidRange(string.offset, string.length, stringChars.size());
+	for (auto& layer : layers)
+	{
+		valid = valid && isValidString(layer.name) && isValidString(layer.type) &&
+			isValidRange(layer.firstTile, layer.numTiles, tiles.size()) && isValidRange(layer.firstObject, layer.numObjects, objects.size());
+	}
+	for (auto& object : objects)
+	{
+		valid = valid && isValidString(object.name) && isValidString(object.type) && isValidRange(object.firstProp, object.numProps, props.size());
+	}
+	for (auto& prop : props) valid = valid && isValidString(prop.name) && isValidString(prop.sValue);
+	for (auto gid : tiles) valid = valid && gid <= uvs.size();
+
+	if (!valid)
+	{
+		header = nullptr;
+		throw std::exception("LcCookedTiledMap::Init(): Invalid cooked map");
+	}
+}
+
+bool LcCookedTiledMap::IsUpToDate(const std::string& tiledJsonPath) const
+{
+	if (!header) return false;
+
+	std::filesystem::path mapPath(tiledJsonPath);
+	if (!IsSourceUpToDate(mapPath, header->mapSize, header->mapTime, header->mapHash)) return false;
+
+	std::filesystem::path tilesetPath(tiledJsonPath);
+	tilesetPath.replace_filename(GetString(header->tilesetSource));
+	return IsSourceUpToDate(tilesetPath, header->tilesetSize, header->tilesetTime, header->tilesetHash);
+}
+
+std::string LcCookedTiledMap::GetString(uint32_t id) const
+{
+	if (id >= strings.size()) throw std::exception("LcCookedTiledMap::GetString(): Invalid string id");
+
+	auto& string = strings[id];
+	return std::string(stringChars.items + string.offset, string.length);
+}
+
+void LcCookedTiledMap::GetObjectProps(const LcCookedObject& object, LcTiledProps& outProps) const
+{
+	outProps.clear();
+
+	for (uint32_t i = 0; i < object.numProps; i++)
+	{
+		auto& prop = props[object.firstProp + i];
+
+		std::pair<std::string, LcAny> newProp;
+		newProp.first = GetString(prop.name);
+
+		switch (static_cast<LcAny::LcAnyType>(prop.type))
+		{
+		case LcAny::LcAnyType::IntAny: newProp.second = LcAny(static_cast<int>(prop.iValue)); break;
+		case LcAny::LcAnyType::FloatAny: newProp.second = LcAny(prop.fValue); break;
+		case LcAny::LcAnyType::BoolAny: newProp.second = LcAny(prop.iValue != 0); break;
+		case LcAny::LcAnyType::StringAny: newProp.second = LcAny(GetString(prop.sValue)); break;
+		default: break;
+		}
+
+		outProps.push_back(newProp);
+	}
+}
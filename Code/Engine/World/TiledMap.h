@@ -0,0 +1,283 @@
+/**
+* TiledMap.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Module.h"
+#include "World/SpriteInterface.h"
+#include "Core/LCSerializer.h"
+#include "Core/LCUtils.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#pragma warning(disable : 4251)
+
+
+/** Tiled map object */
+struct LcTiledObjectData
+{
+	std::string name;
+	//
+	std::string type;
+	// left top corner in map pixels
+	float x, y;
+	//
+	float width, height;
+	//
+	LcTiledProps props;
+};
+
+
+/** Tiled map layer */
+struct LcTiledLayerData
+{
+	std::string name;
+	//
+	std::string type;
+	// global tile ids, row by row. 0 - no tile
+	std::vector<uint32_t> tiles;
+	//
+	std::vector<LcTiledObjectData> objects;
+};
+
+
+/** Tiled map data needed to build tiles */
+struct LcTiledMapData
+{
+	LcTiledMapData() : width(0), height(0), tileWidth(0.0f), tileHeight(0.0f) {}
+	// map size in tiles
+	int width, height;
+	//
+	float tileWidth, tileHeight;
+	// first external tileset file, relative to map file
+	std::string tilesetSource;
+	// in file order
+	std::vector<LcTiledLayerData> layers;
+};
+
+
+/**
+* Parse Tiled JSON map with SAX parser, no JSON document is built.
+* Tile layers are stored as plain id arrays, objects are skipped if loadObjects is false.
+* Layer data could be CSV array or base64 with no, zlib, gzip or zstd compression,
+* zstd layers are rejected if built without LC_ZSTD.
+* Throws on parse or decoding error */
+WORLD_API void ParseTiledMap(const std::string& jsonText, bool loadObjects, LcTiledMapData& outMap);
+
+
+/** Cooked Tiled map file extension */
+inline constexpr const char* LcCookedMapExt = ".lctm";
+
+/** Cooked map data version, files of other versions are cooked again */
+constexpr uint32_t LcCookedMapVersion = 2;
+
+/** Cooked map archive sections */
+namespace LcCookedMapSections
+{
+	constexpr uint32_t Header = 1;
+	// chars of all strings
+	constexpr uint32_t StringChars = 2;
+	constexpr uint32_t Strings = 3;
+	constexpr uint32_t UVs = 4;
+	constexpr uint32_t Layers = 5;
+	constexpr uint32_t Tiles = 6;
+	constexpr uint32_t Objects = 7;
+	constexpr uint32_t Props = 8;
+}
+
+/** Cooked map header */
+struct LcCookedMapHeader
+{
+	uint32_t version;
+	// map size in tiles
+	int32_t width, height;
+	//
+	float tileWidth, tileHeight;
+	// tileset image size
+	float imageWidth, imageHeight;
+	// tileset texture path, string id
+	uint32_t texturePath;
+	// tileset file, relative to map file, string id
+	uint32_t tilesetSource;
+	//
+	uint32_t reserved;
+	// source files content hashes
+	uint64_t mapHash;
+	//
+	uint64_t tilesetHash;
+	// source files size and write time, content is hashed only when they are changed
+	uint64_t mapSize;
+	//
+	int64_t mapTime;
+	//
+	uint64_t tilesetSize;
+	//
+	int64_t tilesetTime;
+};
+
+/** Interned string, chars are not zero terminated */
+struct LcCookedString
+{
+	uint32_t offset;
+	//
+	uint32_t length;
+};
+
+/** Cooked layer. Tiles and objects are ranges of map arrays */
+struct LcCookedLayer
+{
+	uint32_t name;
+	//
+	uint32_t type;
+	//
+	uint32_t firstTile;
+	//
+	uint32_t numTiles;
+	//
+	uint32_t firstObject;
+	//
+	uint32_t numObjects;
+};
+
+/** Cooked object */
+struct LcCookedObject
+{
+	uint32_t name;
+	//
+	uint32_t type;
+	//
+	float x, y;
+	//
+	float width, height;
+	//
+	uint32_t firstProp;
+	//
+	uint32_t numProps;
+};
+
+/** Cooked object property */
+struct LcCookedProp
+{
+	uint32_t name;
+	// LcAny::LcAnyType
+	uint32_t type;
+	// int and bool value
+	int32_t iValue;
+	//
+	float fValue;
+	// string id
+	uint32_t sValue;
+};
+
+/** Cooked map array view */
+template<class T>
+struct LcCookedArray
+{
+	LcCookedArray() : items(nullptr), count(0) {}
+	//
+	inline const T& operator[](size_t index) const { return items[index]; }
+	//
+	inline const T* begin() const { return items; }
+	//
+	inline const T* end() const { return items + count; }
+	//
+	inline size_t size() const { return count; }
+	//
+	const T* items;
+	//
+	size_t count;
+};
+
+
+/**
+* Cooked Tiled map. Tile layers keep gids, UV table holds left top UV of each gid - 1,
+* objects and properties refer to interned strings. Arrays are used in place from mapped file.
+*/
+class WORLD_API LcCookedTiledMap
+{
+public:
+	LcCookedTiledMap() : header(nullptr) {}
+	//
+	LcCookedTiledMap(const LcCookedTiledMap&) = delete;
+	//
+	LcCookedTiledMap& operator=(const LcCookedTiledMap&) = delete;
+	/**
+	* Map cooked file, throws on invalid file */
+	void Open(const std::string& cookedPath);
+	/**
+	* Use cooked data in memory, throws on invalid data */
+	void Open(LcBytes&& cookedData);
+	//
+	void Close();
+	/**
+	* Check source files are not changed after cooking. Missing source files are not checked,
+	* so cooked maps could be shipped without them. Files are hashed only when size or write time differ */
+	bool IsUpToDate(const std::string& tiledJsonPath) const;
+	//
+	std::string GetString(uint32_t id) const;
+	//
+	void GetObjectProps(const LcCookedObject& object, LcTiledProps& outProps) const;
+	//
+	inline const LcCookedMapHeader& GetHeader() const { return *header; }
+	//
+	inline const LcCookedArray<LcVector2>& GetUVs() const { return uvs; }
+	//
+	inline const LcCookedArray<LcCookedLayer>& GetLayers() const { return layers; }
+	//
+	inline const LcCookedArray<uint32_t>& GetTiles() const { return tiles; }
+	//
+	inline const LcCookedArray<LcCookedObject>& GetObjects() const { return objects; }
+	//
+	inline const LcCookedArray<LcCookedProp>& GetProps() const { return props; }
+
+
+protected:
+	void Init(const void* data, size_t size);
+	//
+	template<class T> void GetArray(const LcArchiveReader& reader, uint32_t id, LcCookedArray<T>& outArray)
+	{
+		outArray.items = reader.GetItems<T>(id, LcCookedMapVersion, outArray.count);
+	}
+
+
+protected:
+	LcMappedFile file;
+	//
+	LcBytes bytes;
+	//
+	const LcCookedMapHeader* header;
+	//
+	LcCookedArray<char> stringChars;
+	//
+	LcCookedArray<LcCookedString> strings;
+	//
+	LcCookedArray<LcVector2> uvs;
+	//
+	LcCookedArray<LcCookedLayer> layers;
+	//
+	LcCookedArray<uint32_t> tiles;
+	//
+	LcCookedArray<LcCookedObject> objects;
+	//
+	LcCookedArray<LcCookedProp> props;
+
+};
+
+
+/**
+* Cook Tiled JSON map and its external tileset to binary data. Throws on error */
+WORLD_API void CookTiledMap(const std::string& tiledJsonPath, LcBytes& outData);
+
+/**
+* Get cooked map path: map path with cooked extension */
+WORLD_API std::string GetCookedMapPath(const std::string& tiledJsonPath);
+
+/**
+* Open cooked map for Tiled map path. Missing, invalid or stale cooked file is cooked again and saved.
+* Cooked file path could be passed as well, then it is opened without checks */
+WORLD_API void LoadCookedTiledMap(const std::string& tiledPath, LcCookedTiledMap& outMap);
@@ -0,0 +1,381 @@
+/**
+* VisualLayers.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Core/Visual.h"
+#include "Core/LCSlotMap.h"
+#include "World/SpatialGrid.h"
+#include "World/WorldCommands.h"
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <mutex>
+
+
+/**
+* Layered visuals storage. One contiguous array per LcLayers Z bucket and visual type.
+* Iterated from back (Z9) to front (Z0), sprites before widgets in the same layer.
+* Add and remove are O(1) and keep order inside the bucket: removed element leaves a hole,
+* which iterators skip, holes are compacted when they take half of the bucket.
+* Each stored visual gets a generational handle and is tracked by spatial grid for culling.
+*/
+class LcVisualLayers : public IVisualStorage
+{
+public:
+	typedef std::shared_ptr<IVisual> value_type;
+	//
+	typedef std::vector<value_type> TBucket;
+	//
+	static constexpr int NumLayers = 10;
+	//
+	static constexpr int NumTypes = 2;
+	//
+	static constexpr int NumBuckets = NumLayers * NumTypes;
+	//
+	static constexpr size_t MinHolesToCompact = 16;
+
+
+public:
+	/** Forward iterator over all buckets */
+	class const_iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef LcVisualLayers::value_type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const value_type* pointer;
+		typedef const value_type& reference;
+
+
+	public:
+		const_iterator() : buckets(nullptr), bucket(NumBuckets), index(0) {}
+		//
+		const_iterator(const TBucket* inBuckets, int inBucket, size_t inIndex) : buckets(inBuckets), bucket(inBucket), index(inIndex)
+		{
+			SkipEmpty();
+		}
+		//
+		inline reference operator*() const { return buckets[bucket][index]; }
+		//
+		inline pointer operator->() const { return &buckets[bucket][index]; }
+		//
+		inline const_iterator& operator++() { ++index; SkipEmpty(); return *this; }
+		//
+		inline const_iterator operator++(int) { const_iterator it = *this; ++(*this); return it; }
+		//
+		inline bool operator==(const const_iterator& it) const { return bucket == it.bucket && index == it.index; }
+		//
+		inline bool operator!=(const const_iterator& it) const { return !(*this == it); }
+		//
+		inline int GetBucket() const { return bucket; }
+		//
+		inline size_t GetIndex() const { return index; }
+
+
+	protected:
+		inline void SkipEmpty()
+		{
+			while (bucket < NumBuckets)
+			{
+				if (index >= buckets[bucket].size())
+				{
+					++bucket;
+					index = 0;
+				}
+				else if (!buckets[bucket][index])
+				{
+					++index;
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+		//
+		const TBucket* buckets;
+		//
+		int bucket;
+		//
+		size_t index;
+	};
+	//
+	typedef const_iterator iterator;
+
+
+public:
+	LcVisualLayers() : commands(nullptr), numItems(0) { numHoles.fill(0); }
+	//
+	LcVisualLayers(const LcVisualLayers&) = delete;
+	//
+	LcVisualLayers& operator=(const LcVisualLayers&) = delete;
+	//
+	~LcVisualLayers() { clear(); }
+	//
+	inline const_iterator begin() const { return const_iterator(buckets.data(), 0, 0); }
+	//
+	inline const_iterator end() const { return const_iterator(buckets.data(), NumBuckets, 0); }
+	//
+	inline size_t size() const { return numItems; }
+	//
+	inline bool empty() const { return numItems == 0; }
+	/**
+	* Get bucket array, removed elements are null until bucket is compacted */
+	inline const TBucket& GetBucket(int bucket) const { return buckets[bucket]; }
+	/**
+	* Insert visual to the bucket matching its Z. Hint is unused, it keeps LcCreator container interface */
+	iterator insert(const_iterator /*hint*/, const value_type& visual)
+	{
+		if (!visual) return end();
+
+		int bucket = ToBucket(*visual);
+
+		// visual created in deferred mode keeps its handle
+		auto stored = handles.Get(visual->GetHandle());
+		if (!stored || *stored != visual.get()) visual->SetHandle(handles.Add(visual.get()));
+
+		PushBack(bucket, visual);
+		grid.MarkDirty(visual.get());
+		return const_iterator(buckets.data(), bucket, buckets[bucket].size() - 1);
+	}
+	/**
+	* Find stored visual in O(1) */
+	iterator find(const IVisual* visual) const
+	{
+		if (!visual) return end();
+
+		auto& slot = visual->GetSlot();
+		if (slot.storage != this || slot.bucket < 0) return end();
+
+		return const_iterator(buckets.data(), slot.bucket, slot.index);
+	}
+	/**
+	* Give handle to visual waiting for deferred insert, so it could be found before insert */
+	void AddHandle(IVisual* visual)
+	{
+		visual->SetHandle(handles.Add(visual));
+	}
+	/**
+	* Get visual by handle. Returns nullptr for stale handles */
+	IVisual* Get(LcObjectHandle handle) const
+	{
+		auto visual = handles.Get(handle);
+		return visual ? *visual : nullptr;
+	}
+	/**
+	* Get visuals intersecting rect in world coordinates, sorted in iteration order.
+	* Widgets, tiled and particles sprites are always returned */
+	void Query(const LcRectf& rect, std::vector<IVisual*>& outVisuals)
+	{
+		grid.Query(rect, outVisuals);
+	}
+	/**
+	* Reserve space for visuals of type, numPerLayer[NumLayers] more visuals in each layer */
+	void Reserve(int typeId, const size_t* numPerLayer)
+	{
+		size_t numAdded = 0;
+		for (int layer = 0; layer < NumLayers; layer++)
+		{
+			if (numPerLayer[layer] == 0) continue;
+
+			auto& bucket = buckets[ToBucket(typeId, layer)];
+			bucket.reserve(bucket.size() + numPerLayer[layer]);
+			numAdded += numPerLayer[layer];
+		}
+
+		handles.Reserve(numItems + numAdded);
+	}
+	//
+	inline LcSpatialGrid& GetGrid() { return grid; }
+	/**
+	* Set command buffer to queue layer changes while it is deferred */
+	inline void SetCommandBuffer(LcWorldCommandBuffer* inCommands) { commands = inCommands; }
+	/**
+	* Remove visual in O(1), order of other visuals is kept. Returns iterator to the next element */
+	iterator erase(const_iterator it)
+	{
+		if (it == end()) return end();
+
+		int bucket = it.GetBucket();
+		size_t index = it.GetIndex();
+		auto& visual = buckets[bucket][index];
+		handles.Remove(visual->GetHandle());
+		visual->SetHandle(LcInvalidHandle);
+		grid.Remove(visual.get());
+		visual->GetSlot() = LcVisualSlot();
+
+		index = Detach(bucket, index);
+		return const_iterator(buckets.data(), bucket, index);
+	}
+	//
+	void clear()
+	{
+		grid.Clear();
+
+		for (auto& bucket : buckets)
+		{
+			for (auto& visual : bucket)
+			{
+				if (!visual) continue;
+
+				visual->GetSlot() = LcVisualSlot();
+				visual->SetHandle(LcInvalidHandle);
+			}
+
+			bucket.clear();
+		}
+
+		handles.Clear();
+		numHoles.fill(0);
+		numItems = 0;
+	}
+
+
+public: // IVisualStorage interface implementation
+	//
+	virtual void UpdateLayer(IVisual* visual) override
+	{
+		if (!visual) return;
+
+		auto& slot = visual->GetSlot();
+		if (slot.storage != this || slot.bucket < 0) return;
+
+		// buckets could be iterated now, move visual at sync point
+		if (commands && commands->IsDeferred())
+		{
+			commands->UpdateLayer(visual);
+			return;
+		}
+
+		int newBucket = ToBucket(*visual);
+		if (newBucket != slot.bucket)
+		{
+			value_type item = buckets[slot.bucket][slot.index];
+			Detach(slot.bucket, slot.index);
+			PushBack(newBucket, item);
+		}
+	}
+	//
+	virtual void UpdateBounds(IVisual* visual) override
+	{
+		if (!visual || visual->GetSlot().storage != this) return;
+
+		// visuals could be updated on worker threads
+		std::lock_guard<std::mutex> lock(boundsMutex);
+		grid.MarkDirty(visual);
+	}
+
+
+public:
+	/** Get layer index from Z: 0.0 -> 0, -0.9 -> 9 */
+	static inline int ToLayer(float z)
+	{
+		int layer = static_cast<int>(-z * NumLayers + 0.5f);
+		return (layer < 0) ? 0 : ((layer >= NumLayers) ? NumLayers - 1 : layer);
+	}
+	/** Get bucket index. Back layers go first */
+	static inline int ToBucket(const IVisual& visual)
+	{
+		return ToBucket(visual.GetTypeId(), ToLayer(visual.GetPos().z));
+	}
+	/** Get bucket index of visual type in layer */
+	static inline int ToBucket(int typeId, int layer)
+	{
+		int type = (typeId < 0) ? 0 : ((typeId >= NumTypes) ? NumTypes - 1 : typeId);
+		return (NumLayers - 1 - layer) * NumTypes + type;
+	}
+
+
+protected:
+	inline void PushBack(int bucket, const value_type& visual)
+	{
+		auto& slot = visual->GetSlot();
+		slot.storage = this;
+		slot.bucket = bucket;
+		slot.index = buckets[bucket].size();
+
+		buckets[bucket].push_back(visual);
+		++numItems;
+	}
+	/**
+	* Remove element leaving a hole. Returns index of the next element, it changes when bucket is compacted */
+	inline size_t Detach(int bucket, size_t index)
+	{
+		auto& items = buckets[bucket];
+		items[index].reset();
+		++numHoles[bucket];
+		--numItems;
+
+		// holes at the end are dropped at once
+		while (!items.empty() && !items.back())
+		{
+			items.pop_back();
+			--numHoles[bucket];
+		}
+
+		if (numHoles[bucket] >= MinHolesToCompact && numHoles[bucket] * 2 > items.size())
+		{
+			index = Compact(bucket, index);
+		}
+
+		return index;
+	}
+	/**
+	* Remove holes keeping order. Returns new index of the first element at or after index */
+	inline size_t Compact(int bucket, size_t index)
+	{
+		auto& items = buckets[bucket];
+		size_t newIndex = 0;
+		size_t numLive = 0;
+
+		for (size_t i = 0; i < items.size(); i++)
+		{
+			if (i == index) newIndex = numLive;
+			if (!items[i]) continue;
+
+			if (i != numLive)
+			{
+				items[numLive] = std::move(items[i]);
+				items[numLive]->GetSlot().index = numLive;
+			}
+
+			++numLive;
+		}
+
+		if (index >= items.size()) newIndex = numLive;
+
+		items.resize(numLive);
+		numHoles[bucket] = 0;
+		return newIndex;
+	}
+
+
+protected:
+	std::array<TBucket, NumBuckets> buckets;
+	// removed elements in bucket, not compacted yet
+	std::array<size_t, NumBuckets> numHoles;
+	//
+	LcHandleTable<IVisual*> handles;
+	//
+	LcSpatialGrid grid;
+	//
+	std::mutex boundsMutex;
+	//
+	LcWorldCommandBuffer* commands;
+	//
+	size_t numItems;
+
+};
+
+
+/** Find visual in layered storage. Used by LcCreator::Remove() */
+inline LcVisualLayers::iterator LcFindItem(LcVisualLayers& items, const IVisual* item)
+{
+	return items.find(item);
+}
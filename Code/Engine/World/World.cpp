@@ -10,65 +10,246 @@
 #include "World/World.h"
 #include "World/Sprites.h"
 #include "GUI/Widgets.h"
+#include "Core/LCSerializer.h"
 
 #include <iterator>
+#include <cfloat>
+#include <unordered_map>
 
 
-class LcVisualLifetimeStrategy : public LcLifetimeStrategy<IVisual, IWorld::TVisualSet>
+class LcVisualLifetimeStrategy : public LcVisualPoolStrategy
 {
 public:
-	LcVisualLifetimeStrategy() {}
+	LcVisualLifetimeStrategy(const LcAppContext& inContext) : LcVisualPoolStrategy(inContext) {}
 	//
 	virtual ~LcVisualLifetimeStrategy() {}
 	//
-	virtual std::shared_ptr<IVisual> Create(const void* userData) override
+	virtual void Destroy(IVisual& item, IWorld::TVisualSet& items) override
 	{
-		auto layerPtr = static_cast<const float*>(userData);
-		std::shared_ptr<IVisual> newVisual;
+		if (item.GetTypeId() != LcCreatables::Widget) return;
 
-		switch (curTypeId)
+		auto inWidget = static_cast<IWidget*>(&item);
+		if (auto parent = inWidget->GetParent())
 		{
-		case LcCreatables::Sprite: newVisual = std::make_shared<LcSprite>(); break;
-		case LcCreatables::Widget: newVisual = std::make_shared<LcWidget>(); break;
+			parent->RemoveChild(inWidget);
 		}
 
-		// add layer Z for initial valid sorting in multiset
-		newVisual->SetPos(LcVector3{ 0.0f, 0.0f, *layerPtr });
-
-		return newVisual;
+		// detach childs, list is changed by RemoveChild()
+		auto childs = inWidget->GetChilds();
+		for (auto child : childs)
+		{
+			inWidget->RemoveChild(child);
+		}
 	}
+
+
+protected: // LcVisualPoolStrategy interface implementation
 	//
-	virtual void Destroy(IVisual& item, IWorld::TVisualSet& items) override
+	virtual std::shared_ptr<IVisual> NewVisual(int typeId) override
 	{
-		auto inWidget = static_cast<IWidget*>(&item);
-
-		for (auto& visual : items)
+		switch (typeId)
 		{
-			if (visual.get() != inWidget &&
-				visual->GetTypeId() == LcCreatables::Widget)
-			{
-				auto curWidget = static_cast<IWidget*>(visual.get());
-				curWidget->RemoveChild(inWidget);
-			}
+		case LcCreatables::Sprite: return std::make_shared<LcSprite>();
+		case LcCreatables::Widget: return std::make_shared<LcWidget>();
 		}
+
+		return std::shared_ptr<IVisual>();
 	}
 };
 
 
+/** Reserve layer buckets once for batch of visual descriptors */
+template<class TDesc>
+static void ReserveLayers(IWorld::TVisualSet& layers, int typeId, const TDesc* descs, size_t count)
+{
+	size_t numPerLayer[LcVisualLayers::NumLayers] = {};
+	for (size_t i = 0; i < count; i++)
+	{
+		numPerLayer[LcVisualLayers::ToLayer(LcLayersRange(descs[i].z))]++;
+	}
+
+	layers.Reserve(typeId, numPerLayer);
+}
+
+
+/** Snapshot section versions */
+constexpr unsigned int LcWorldStateVersion = 1;
+constexpr unsigned int LcVisualsVersion = 1;
+constexpr unsigned int LcComponentsVersion = 1;
+constexpr unsigned int LcComponentDataVersion = 2;
+constexpr unsigned int LcWidgetLinksVersion = 1;
+
+/** Visual record flags */
+constexpr uint32_t LcVisualVisible = 1;
+constexpr uint32_t LcVisualRooted = 2;
+constexpr uint32_t LcVisualDisabled = 4;
+
+struct LcWorldStateRecord
+{
+	LcVector3 cameraPos;
+	//
+	LcVector3 cameraTarget;
+	//
+	LcColor3 globalTint;
+};
+
+struct LcVisualRecord
+{
+	int32_t typeId;
+	//
+	int32_t tag;
+	//
+	LcVector3 pos;
+	//
+	LcSizef size;
+	//
+	float rotZ;
+	//
+	uint32_t flags;
+	// range in components section
+	uint32_t firstComponent;
+	//
+	uint32_t numComponents;
+};
+
+struct LcComponentRecord
+{
+	int32_t type;
+	//
+	uint32_t reserved;
+	// range in component data section
+	uint64_t dataOffset;
+	//
+	uint64_t dataSize;
+};
+
+/** Child widget link, saved in parent childs order */
+struct LcWidgetLinkRecord
+{
+	uint32_t parent;
+	//
+	uint32_t child;
+};
+
+/** Create component of any module by type */
+static TVComponentPtr CreateComponent(EVCType type)
+{
+	if (auto comp = CreateVisualComponent(type)) return comp;
+	if (auto comp = CreateSpriteComponent(type)) return comp;
+
+	return CreateWidgetComponent(type);
+}
+
+
+LcVisualPoolStrategy::LcVisualPoolStrategy(const LcAppContext& inContext)
+	: context(inContext)
+	, poolLimits{ DefaultPoolLimit, DefaultPoolLimit }
+{
+}
+
+void LcVisualPoolStrategy::Reserve(int typeId, size_t count)
+{
+	if (typeId < 0 || typeId >= NumPools) throw std::exception("LcVisualPoolStrategy::Reserve(): Invalid type");
+
+	auto& pool = pools[typeId];
+	if (poolLimits[typeId] < count) poolLimits[typeId] = count;
+	pool.reserve(poolLimits[typeId]);
+
+	while (pool.size() < count)
+	{
+		auto newVisual = NewVisual(typeId);
+		if (!newVisual) throw std::exception("LcVisualPoolStrategy::Reserve(): Cannot create visual");
+
+		pool.push_back(newVisual);
+	}
+}
+
+size_t LcVisualPoolStrategy::GetNumPooled(int typeId) const
+{
+	return (typeId >= 0 && typeId < NumPools) ? pools[typeId].size() : 0;
+}
+
+std::shared_ptr<IVisual> LcVisualPoolStrategy::Create(const void* userData)
+{
+	auto layerPtr = static_cast<const float*>(userData);
+	std::shared_ptr<IVisual> newVisual;
+
+	if (curTypeId >= 0 && curTypeId < NumPools && !pools[curTypeId].empty())
+	{
+		// reuse parked visual, it is already reset
+		newVisual = pools[curTypeId].back();
+		pools[curTypeId].pop_back();
+	}
+	else
+	{
+		newVisual = NewVisual(curTypeId);
+	}
+
+	if (!newVisual) return newVisual;
+
+	// add layer Z to select initial layer bucket
+	newVisual->SetPos(LcVector3{ 0.0f, 0.0f, *layerPtr });
+
+	return newVisual;
+}
+
+void LcVisualPoolStrategy::Recycle(std::shared_ptr<IVisual> item)
+{
+	int typeId = item ? item->GetTypeId() : -1;
+	if (typeId < 0 || typeId >= NumPools) return;
+
+	// skip visuals still referenced outside the world and keep pool size limited
+	if (item.use_count() > 1 || pools[typeId].size() >= poolLimits[typeId]) return;
+
+	item->Reset(context);
+	pools[typeId].push_back(item);
+}
+
+
 LcWorld::LcWorld(const LcAppContext& inContext)
 	: context(inContext)
 	, visualHelper(std::make_unique<LcVisualHelper>(inContext))
 	, spriteHelper(std::make_unique<LcSpriteHelper>(inContext))
 	, widgetHelper(std::make_unique<LcWidgetHelper>(inContext))
+	, screenSize(LcSize{ 0, 0 })
 	, globalTint(LcDefaults::White3)
-	, lastVisual(nullptr)
+	, lastVisual(LcInvalidHandle)
+{
+	SetLifetimeStrategy(std::make_shared<LcVisualLifetimeStrategy>(inContext));
+	items.GetItems().SetCommandBuffer(&commands);
+}
+
+template<class T>
+T* LcWorld::AddVisual(float z)
+{
+	if (!commands.IsDeferred()) return items.Add<T>(&z);
+
+	auto newVisual = items.Create<T>(&z);
+	if (newVisual)
+	{
+		items.GetItems().AddHandle(newVisual.get());
+		commands.Insert(newVisual);
+	}
+
+	return static_cast<T*>(newVisual.get());
+}
+
+void LcWorld::RemoveVisual(IVisual* visual)
 {
-	items.SetLifetimeStrategy(std::make_shared<LcVisualLifetimeStrategy>());
+	if (visual && visual->GetHandle() == lastVisual) lastVisual = LcInvalidHandle;
+
+	if (commands.IsDeferred())
+	{
+		commands.Remove(visual);
+		return;
+	}
+
+	items.Remove(visual);
 }
 
 ISprite* LcWorld::AddSprite(float x, float y, LcLayersRange z, float width, float height, float rotZ, bool visible)
 {
-	auto newSprite = items.Add<LcSprite>(z.get());
+	auto newSprite = AddVisual<LcSprite>(z);
 	if (newSprite)
 	{
 		newSprite->SetPos(LcVector3{ x, y, z });
@@ -82,7 +263,7 @@ ISprite* LcWorld::AddSprite(float x, float y, LcLayersRange z, float width, floa
 		throw std::exception("LcWorld::AddSprite(): Cannot create sprite");
 	}
 
-	lastVisual = newSprite;
+	lastVisual = newSprite->GetHandle();
 	return newSprite;
 }
 
@@ -93,14 +274,12 @@ ISprite* LcWorld::AddSprite(float x, float y, float width, float height, float i
 
 void LcWorld::RemoveSprite(ISprite* sprite)
 {
-	if (lastVisual == sprite) lastVisual = nullptr;
-
-	items.Remove(sprite);
+	RemoveVisual(sprite);
 }
 
 IWidget* LcWorld::AddWidget(float x, float y, LcLayersRange z, float width, float height, bool visible)
 {
-	auto newWidget = items.Add<LcWidget>(z.get());
+	auto newWidget = AddVisual<LcWidget>(z);
 	if (newWidget)
 	{
 		newWidget->SetPos(LcVector3{ x, y, z });
@@ -113,7 +292,7 @@ IWidget* LcWorld::AddWidget(float x, float y, LcLayersRange z, float width, floa
 		throw std::exception("LcWorld::AddWidget(): Cannot create widget");
 	}
 
-	lastVisual = newWidget;
+	lastVisual = newWidget->GetHandle();
 	return newWidget;
 }
 
@@ -124,36 +303,329 @@ IWidget* LcWorld::AddWidget(float x, float y, float width, float height, bool in
 
 void LcWorld::RemoveWidget(IWidget* widget)
 {
-	if (lastVisual == widget) lastVisual = nullptr;
+	RemoveVisual(widget);
+}
+
+void LcWorld::AddSprites(const LcSpriteDesc* descs, size_t count, std::vector<ISprite*>* outSprites)
+{
+	if (count == 0) return;
+	if (!descs) throw std::exception("LcWorld::AddSprites(): Invalid descriptors");
+
+	ReserveLayers(items.GetItems(), LcCreatables::Sprite, descs, count);
+	if (outSprites) outSprites->reserve(outSprites->size() + count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto& desc = descs[i];
+		float z = LcLayersRange(desc.z);
+
+		auto newSprite = AddVisual<LcSprite>(z);
+		if (!newSprite) throw std::exception("LcWorld::AddSprites(): Cannot create sprite");
+
+		newSprite->SetPos(LcVector3{ desc.x, desc.y, z });
+		newSprite->SetSize(LcSizef{ desc.width, desc.height });
+		newSprite->SetRotZ(desc.rotZ);
+		newSprite->SetVisible(desc.visible);
+		newSprite->Init(context);
+
+		if (desc.tag != LcNoTag) newSprite->SetTag(desc.tag);
+		if (desc.hasTint) newSprite->AddTintComponent(context, desc.tint);
+		if (desc.hasCustomUV) newSprite->AddCustomUVComponent(context, desc.uvs[0], desc.uvs[1], desc.uvs[2], desc.uvs[3]);
+		if (desc.numFrames > 0) newSprite->AddAnimationComponent(context, desc.frameSize, desc.numFrames, desc.framesPerSecond);
+		// texture goes last, render system resolves it on every added component
+		if (!desc.texture.empty()) newSprite->AddTextureComponent(context, desc.texture);
+
+		if (outSprites) outSprites->push_back(newSprite);
+		lastVisual = newSprite->GetHandle();
+	}
+}
+
+void LcWorld::AddWidgets(const LcWidgetDesc* descs, size_t count, std::vector<IWidget*>* outWidgets)
+{
+	if (count == 0) return;
+	if (!descs) throw std::exception("LcWorld::AddWidgets(): Invalid descriptors");
+
+	ReserveLayers(items.GetItems(), LcCreatables::Widget, descs, count);
+	if (outWidgets) outWidgets->reserve(outWidgets->size() + count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto& desc = descs[i];
+		float z = LcLayersRange(desc.z);
+
+		auto newWidget = AddVisual<LcWidget>(z);
+		if (!newWidget) throw std::exception("LcWorld::AddWidgets(): Cannot create widget");
+
+		newWidget->SetPos(LcVector3{ desc.x, desc.y, z });
+		newWidget->SetSize(LcSizef{ desc.width, desc.height });
+		newWidget->SetVisible(desc.visible);
+		newWidget->Init(context);
 
-	items.Remove(widget);
+		if (desc.tag != LcNoTag) newWidget->SetTag(desc.tag);
+		if (desc.hasTint) newWidget->AddTintComponent(context, desc.tint);
+		if (!desc.texture.empty()) newWidget->AddTextureComponent(context, desc.texture);
+
+		if (outWidgets) outWidgets->push_back(newWidget);
+		lastVisual = newWidget->GetHandle();
+	}
 }
 
 void LcWorld::Clear(bool removeRooted)
 {
-	if (removeRooted)
+	if (removeRooted && !commands.IsDeferred())
 	{
+		lastVisual = LcInvalidHandle;
 		items.Clear();
 	}
 	else
 	{
-		TVisualCreator::TItemsList removedVisuals;
-		auto& visuals = items.GetItems();
+		std::vector<IVisual*> removedVisuals;
+		for (auto& visual : items.GetItems())
+		{
+			if (removeRooted || !visual->IsRooted()) removedVisuals.push_back(visual.get());
+		}
 
-		std::copy_if(visuals.begin(), visuals.end(), std::inserter(removedVisuals, removedVisuals.begin()), [](auto& visual) {
-			return !visual->IsRooted();
-		});
+		// visuals waiting to be stored
+		for (auto& command : commands.GetCommands())
+		{
+			if (command.type != LcWorldCommandType::Insert) continue;
+			if (removeRooted || !command.visual->IsRooted()) removedVisuals.push_back(command.visual);
+		}
 
-		visuals.erase(removedVisuals.begin(), removedVisuals.end());
+		for (auto visual : removedVisuals)
+		{
+			RemoveVisual(visual);
+		}
 	}
 }
 
-IVisual* LcWorld::GetVisualByTag(ObjectTag tag) const
+void LcWorld::Save(LcArchiveWriter& writer, bool saveRooted) const
 {
-	auto it = std::find_if(items.GetItems().begin(), items.GetItems().end(), [tag](auto& visual) {
-		return visual->GetTag() == tag;
-	});
-	return (it != items.GetItems().end()) ? it->get() : nullptr;
+	std::vector<LcVisualRecord> visualRecords;
+	std::vector<LcComponentRecord> compRecords;
+	std::vector<LcWidgetLinkRecord> links;
+	std::unordered_map<const IVisual*, uint32_t> indices;
+	LcBlobWriter compData;
+
+	visualRecords.reserve(items.GetItems().size());
+
+	for (auto& visual : items.GetItems())
+	{
+		if (!saveRooted && visual->IsRooted()) continue;
+
+		uint32_t flags = 0;
+		if (visual->IsVisible()) flags |= LcVisualVisible;
+		if (visual->IsRooted()) flags |= LcVisualRooted;
+		if (visual->GetTypeId() == LcCreatables::Widget && static_cast<IWidget*>(visual.get())->IsDisabled()) flags |= LcVisualDisabled;
+
+		LcVisualRecord record{ visual->GetTypeId(), visual->GetTag(), visual->GetPos(), visual->GetSize(), visual->GetRotZ(),
+			flags, (uint32_t)compRecords.size(), 0 };
+
+		// all components by type order, so texture is loaded before components using it
+		TVFeatureMask compMask = visual->GetComponentMask();
+		for (EVCType type = 0; type < 64; type++)
+		{
+			if (!(compMask & ToFeatureBit(type))) continue;
+
+			auto& comp = visual->GetComponent(type);
+			if (!comp) continue;
+
+			size_t offset = compData.GetData().size();
+			if (!comp->Save(compData))
+			{
+				compData.GetData().resize(offset);
+				continue;
+			}
+
+			compRecords.push_back(LcComponentRecord{ type, 0, offset, compData.GetData().size() - offset });
+			record.numComponents++;
+		}
+
+		indices[visual.get()] = (uint32_t)visualRecords.size();
+		visualRecords.push_back(record);
+	}
+
+	for (auto& visual : items.GetItems())
+	{
+		if (visual->GetTypeId() != LcCreatables::Widget) continue;
+
+		auto parentIt = indices.find(visual.get());
+		if (parentIt == indices.end()) continue;
+
+		for (auto child : static_cast<IWidget*>(visual.get())->GetChilds())
+		{
+			auto childIt = indices.find(child);
+			if (childIt != indices.end()) links.push_back(LcWidgetLinkRecord{ parentIt->second, childIt->second });
+		}
+	}
+
+	LcWorldStateRecord state{ camera.GetPosition(), camera.GetTarget(), globalTint };
+
+	writer.AddSection(LcWorldSections::State, LcWorldStateVersion, &state, sizeof(state), 1);
+	writer.AddSection(LcWorldSections::Visuals, LcVisualsVersion, visualRecords);
+	writer.AddSection(LcWorldSections::Components, LcComponentsVersion, compRecords);
+	writer.AddSection(LcWorldSections::ComponentData, LcComponentDataVersion, compData.GetData().data(), compData.GetData().size(), 1);
+	writer.AddSection(LcWorldSections::WidgetLinks, LcWidgetLinksVersion, links);
+}
+
+void LcWorld::Load(const LcArchiveReader& reader)
+{
+	size_t numStates = 0;
+	if (auto state = reader.GetItems<LcWorldStateRecord>(LcWorldSections::State, LcWorldStateVersion, numStates))
+	{
+		camera.Set(state->cameraPos, state->cameraTarget);
+		SetGlobalTint(state->globalTint);
+	}
+
+	size_t numVisuals = 0, numComps = 0, numLinks = 0;
+	auto visualRecords = reader.GetItems<LcVisualRecord>(LcWorldSections::Visuals, LcVisualsVersion, numVisuals);
+	auto compRecords = reader.GetItems<LcComponentRecord>(LcWorldSections::Components, LcComponentsVersion, numComps);
+	auto links = reader.GetItems<LcWidgetLinkRecord>(LcWorldSections::WidgetLinks, LcWidgetLinksVersion, numLinks);
+	auto compData = reader.GetBlob(LcWorldSections::ComponentData, LcComponentDataVersion);
+
+	std::vector<IVisual*> visuals;
+	visuals.reserve(numVisuals);
+
+	for (size_t i = 0; i < numVisuals; i++)
+	{
+		const auto& record = visualRecords[i];
+		bool visible = (record.flags & LcVisualVisible) != 0;
+		IVisual* visual = nullptr;
+
+		switch (record.typeId)
+		{
+		case LcCreatables::Sprite:
+			visual = AddSprite(record.pos.x, record.pos.y, LcLayersRange(record.pos.z), record.size.x, record.size.y, record.rotZ, visible);
+			break;
+		case LcCreatables::Widget:
+			{
+				auto widget = AddWidget(record.pos.x, record.pos.y, LcLayersRange(record.pos.z), record.size.x, record.size.y, visible);
+				widget->SetDisabled((record.flags & LcVisualDisabled) != 0);
+				visual = widget;
+			}
+			break;
+		default:
+			throw std::exception("LcWorld::Load(): Invalid visual type");
+		}
+
+		if (record.tag != LcNoTag) visual->SetTag(record.tag);
+		if (record.flags & LcVisualRooted) visual->AddToRoot();
+
+		if ((uint64_t)record.firstComponent + record.numComponents > numComps) throw std::exception("LcWorld::Load(): Invalid component range");
+
+		for (uint32_t c = 0; c < record.numComponents; c++)
+		{
+			const auto& compRecord = compRecords[record.firstComponent + c];
+			auto comp = CreateComponent(compRecord.type);
+			if (!comp) throw std::exception("LcWorld::Load(): Unknown component type");
+
+			auto compReader = compData.GetRange(compRecord.dataOffset, compRecord.dataSize);
+			comp->Load(compReader);
+			AddComponent(visual, comp);
+		}
+
+		visuals.push_back(visual);
+	}
+
+	for (size_t i = 0; i < numLinks; i++)
+	{
+		const auto& link = links[i];
+		if (link.parent >= visuals.size() || link.child >= visuals.size() ||
+			visuals[link.parent]->GetTypeId() != LcCreatables::Widget || visuals[link.child]->GetTypeId() != LcCreatables::Widget)
+		{
+			throw std::exception("LcWorld::Load(): Invalid widget link");
+		}
+
+		static_cast<IWidget*>(visuals[link.parent])->AddChild(static_cast<IWidget*>(visuals[link.child]));
+	}
+}
+
+void LcWorld::AddComponent(IVisual* visual, TVComponentPtr comp)
+{
+	if (!visual || !comp) throw std::exception("LcWorld::AddComponent(): Invalid visual or component");
+
+	if (commands.IsDeferred())
+	{
+		commands.AddComponent(visual, comp);
+		return;
+	}
+
+	visual->AddComponent(comp, context);
+}
+
+void LcWorld::RemoveComponent(IVisual* visual, IVisualComponent* comp)
+{
+	if (!visual || !comp) return;
+
+	if (commands.IsDeferred())
+	{
+		// keep component alive until applied
+		auto& visualComp = visual->GetComponent(comp->GetType());
+		if (visualComp.get() == comp) commands.RemoveComponent(visual, visualComp);
+		return;
+	}
+
+	visual->RemoveComponent(comp, context);
+}
+
+void LcWorld::ApplyDeferred()
+{
+	commands.SetDeferred(false);
+	onTintChanged.Flush();
+
+	if (commands.IsEmpty()) return;
+
+	commands.Sort();
+	appliedCommands.clear();
+	commands.Swap(appliedCommands);
+
+	for (auto& command : appliedCommands)
+	{
+		switch (command.type)
+		{
+		case LcWorldCommandType::RemoveComponent:
+			command.visual->RemoveComponent(command.component.get(), context);
+			break;
+		case LcWorldCommandType::AddComponent:
+			command.visual->AddComponent(command.component, context);
+			break;
+		case LcWorldCommandType::Insert:
+			items.Insert(command.newVisual);
+			// storage owns it now, so removal could recycle it
+			command.newVisual.reset();
+			break;
+		case LcWorldCommandType::UpdateLayer:
+			items.GetItems().UpdateLayer(command.visual);
+			break;
+		case LcWorldCommandType::Remove:
+			items.Remove(command.visual);
+			break;
+		}
+	}
+
+	appliedCommands.clear();
+}
+
+LcRectf LcWorld::GetCameraRect() const
+{
+	if (screenSize.x <= 0 || screenSize.y <= 0)
+	{
+		// viewport is unknown, disable culling
+		return LcRectf{ -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX };
+	}
+
+	auto scale = worldScale.GetScale();
+	auto cameraPos = camera.GetPosition();
+	float halfWidth = screenSize.x / 2.0f;
+	float halfHeight = screenSize.y / 2.0f;
+
+	// camera looks at viewport center in scaled coordinates
+	return LcRectf{
+		(cameraPos.x - halfWidth) / scale.x,
+		(cameraPos.y - halfHeight) / scale.y,
+		(cameraPos.x + halfWidth) / scale.x,
+		(cameraPos.y + halfHeight) / scale.y
+	};
 }
 
 void LcWorld::SetGlobalTint(LcColor3 tint)
@@ -161,7 +633,7 @@ void LcWorld::SetGlobalTint(LcColor3 tint)
 	if (globalTint != tint)
 	{
 		globalTint = tint;
-		onTintChanged.Broadcast(tint);
+		onTintChanged.BroadcastDeferred(tint);
 	}
 }
 
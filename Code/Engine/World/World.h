@@ -14,11 +14,54 @@
 #pragma warning(disable : 4251)
 
 
-inline bool operator < (const std::shared_ptr<IVisual>& a, const std::shared_ptr<IVisual>& b)
+/**
+* Visual lifetime strategy with recycling. Removed visuals are reset and parked
+* in per type pools, new visuals are taken from pools before allocating.
+* Concrete visual types are created by NewVisual().
+*/
+class WORLD_API LcVisualPoolStrategy : public LcLifetimeStrategy<IVisual, IWorld::TVisualSet>
 {
-	if (a->GetPos().z == b->GetPos().z) return a->GetTypeId() < b->GetTypeId();
-	return (a->GetPos().z < b->GetPos().z);
-}
+public:
+	typedef std::vector<std::shared_ptr<IVisual>> TVisualPool;
+	//
+	static constexpr int NumPools = 2;
+	//
+	static constexpr size_t DefaultPoolLimit = 256;
+
+
+public:
+	LcVisualPoolStrategy(const LcAppContext& inContext);
+	//
+	virtual ~LcVisualPoolStrategy() {}
+	/**
+	* Create parked visuals of type (LcCreatables) up to count, pool limit is raised to count */
+	void Reserve(int typeId, size_t count);
+	/**
+	* Get number of parked visuals of type (LcCreatables) */
+	size_t GetNumPooled(int typeId) const;
+
+
+public: // LcLifetimeStrategy interface implementation
+	//
+	virtual std::shared_ptr<IVisual> Create(const void* userData) override;
+	//
+	virtual void Recycle(std::shared_ptr<IVisual> item) override;
+
+
+protected:
+	/**
+	* Create new visual of type (LcCreatables) */
+	virtual std::shared_ptr<IVisual> NewVisual(int typeId) = 0;
+
+
+protected:
+	const LcAppContext& context;
+	//
+	TVisualPool pools[NumPools];
+	//
+	size_t poolLimits[NumPools];
+
+};
 
 
 /**
@@ -27,7 +70,7 @@ class LcWorld : public IWorld
 {
 public:
 	typedef LcCreator<class IVisual, LcLifetimeStrategy<class IVisual, TVisualSet>, TVisualSet> TVisualCreator;
-	typedef std::shared_ptr<LcLifetimeStrategy<class IVisual, TVisualSet>> TVisualLifetime;
+	typedef std::shared_ptr<LcVisualPoolStrategy> TVisualLifetime;
 	typedef std::unique_ptr<class LcVisualHelper> TVisualHelperPtr;
 	typedef std::unique_ptr<class LcSpriteHelper> TSpriteHelperPtr;
 	typedef std::unique_ptr<class LcWidgetHelper> TWidgetHelperPtr;
@@ -40,7 +83,7 @@ public:
 	//
 	LcWorld& operator=(const LcWorld&) = delete;
 	//
-	void SetLifetimeStrategy(TVisualLifetime inVisualLifetime) { items.SetLifetimeStrategy(inVisualLifetime); }
+	void SetLifetimeStrategy(TVisualLifetime inVisualLifetime) { if (inVisualLifetime) { visualLifetime = inVisualLifetime; items.SetLifetimeStrategy(inVisualLifetime); } }
 
 
 public: // IWorld interface implementation
@@ -59,14 +102,46 @@ public: // IWorld interface implementation
 	//
 	virtual void RemoveWidget(class IWidget* widget) override;
 	//
+	virtual void AddSprites(const LcSpriteDesc* descs, size_t count, std::vector<class ISprite*>* outSprites = nullptr) override;
+	//
+	virtual void AddWidgets(const LcWidgetDesc* descs, size_t count, std::vector<class IWidget*>* outWidgets = nullptr) override;
+	//
+	virtual void ReserveSprites(size_t count) override { visualLifetime->Reserve(LcCreatables::Sprite, count); }
+	//
+	virtual void ReserveWidgets(size_t count) override { visualLifetime->Reserve(LcCreatables::Widget, count); }
+	//
 	virtual void Clear(bool removeRooted = false) override;
 	//
-	virtual class IVisual* GetVisualByTag(ObjectTag tag) const override;
+	virtual void Save(class LcArchiveWriter& writer, bool saveRooted = false) const override;
+	//
+	virtual void Load(const class LcArchiveReader& reader) override;
+	//
+	virtual void AddComponent(class IVisual* visual, TVComponentPtr comp) override;
+	//
+	virtual void RemoveComponent(class IVisual* visual, class IVisualComponent* comp) override;
+	//
+	virtual void BeginDeferred() override { commands.SetDeferred(true); }
+	//
+	virtual void ApplyDeferred() override;
+	//
+	virtual bool IsDeferred() const override { return commands.IsDeferred(); }
+	//
+	virtual class IVisual* GetVisualByTag(ObjectTag tag) const override { return items.GetTagIndex().Find(tag); }
+	//
+	virtual size_t GetVisualsByTag(ObjectTag tag, std::vector<class IVisual*>& outVisuals) const override { return items.GetTagIndex().FindAll(tag, outVisuals); }
+	//
+	virtual class IVisual* GetVisualByHandle(LcObjectHandle handle) const override { return items.GetByHandle(handle); }
 	//
 	virtual const TVisualSet& GetVisuals() const override { return items.GetItems(); }
 	//
 	virtual TVisualSet& GetVisuals() override { return items.GetItems(); }
 	//
+	virtual void GetVisibleVisuals(const LcRectf& rect, std::vector<class IVisual*>& outVisuals) override { items.GetItems().Query(rect, outVisuals); }
+	//
+	virtual LcRectf GetCameraRect() const override;
+	//
+	virtual void SetCullingCellSize(float cellSize) override { items.GetItems().GetGrid().SetCellSize(cellSize); }
+	//
 	virtual const LcCamera& GetCamera() const override { return camera; }
 	//
 	virtual LcCamera& GetCamera() override { return camera; }
@@ -75,13 +150,13 @@ public: // IWorld interface implementation
 	//
 	virtual LcWorldScale& GetWorldScale() override { return worldScale; }
 	//
-	virtual void UpdateWorldScale(LcSize newScreenSize) { worldScale.UpdateWorldScale(newScreenSize); }
+	virtual void UpdateWorldScale(LcSize newScreenSize) { screenSize = newScreenSize; worldScale.UpdateWorldScale(newScreenSize); }
 	//
 	virtual void SetGlobalTint(LcColor3 tint) override;
 	//
 	virtual LcColor3 GetGlobalTint() const override { return globalTint; }
 	//
-	virtual class IVisual* GetLastAddedVisual() const override { return lastVisual; }
+	virtual class IVisual* GetLastAddedVisual() const override { return items.GetByHandle(lastVisual); }
 	//
 	virtual const class LcVisualHelper& GetVisualHelper() const override { return *visualHelper.get(); }
 	//
@@ -90,11 +165,26 @@ public: // IWorld interface implementation
 	virtual const class LcWidgetHelper& GetWidgetHelper() const override { return *widgetHelper.get(); }
 
 
+protected:
+	/**
+	* Create visual, it is stored at once or at sync point if world is deferred */
+	template<class T>
+	T* AddVisual(float z);
+	//
+	void RemoveVisual(class IVisual* visual);
+
+
 protected:
 	const LcAppContext& context;
 	//
 	TVisualCreator items;
 	//
+	LcWorldCommandBuffer commands;
+	//
+	LcWorldCommandBuffer::TCommandsList appliedCommands;
+	//
+	TVisualLifetime visualLifetime;
+	//
 	TVisualHelperPtr visualHelper;
 	//
 	TSpriteHelperPtr spriteHelper;
@@ -105,8 +195,11 @@ protected:
 	//
 	LcCamera camera;
 	//
+	LcSize screenSize;
+	//
 	LcColor3 globalTint;
 	//
-	class IVisual* lastVisual;
+	// handle, so removed and recycled visual is never returned
+	LcObjectHandle lastVisual;
 
 };
@@ -0,0 +1,114 @@
+/**
+* WorldCommands.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "Core/Visual.h"
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <mutex>
+
+
+/** World command type. Commands are applied in this order */
+enum class LcWorldCommandType : unsigned char
+{
+	RemoveComponent,
+	AddComponent,
+	Insert,
+	UpdateLayer,
+	Remove
+};
+
+
+/** Deferred structural change of the world */
+struct LcWorldCommand
+{
+	LcWorldCommandType type;
+	// target visual
+	IVisual* visual;
+	// created visual for Insert, keeps it alive until inserted
+	std::shared_ptr<IVisual> newVisual;
+	// added or removed component, keeps it alive until applied
+	TVComponentPtr component;
+};
+
+
+/**
+* World command buffer. Queues spawns, removals, component and layer changes made
+* while the world is iterated, they are applied in one pass at the frame sync point.
+* Commands are stable sorted by type, so visuals are never removed before
+* their component changes and spawned visuals could be removed in the same frame.
+* Commands could be added from worker threads during parallel update.
+*/
+class LcWorldCommandBuffer
+{
+public:
+	typedef std::vector<LcWorldCommand> TCommandsList;
+
+
+public:
+	LcWorldCommandBuffer() : deferred(false) {}
+	//
+	inline void SetDeferred(bool inDeferred) { deferred = inDeferred; }
+	//
+	inline bool IsDeferred() const { return deferred; }
+	//
+	inline void Insert(std::shared_ptr<IVisual> visual)
+	{
+		IVisual* visualPtr = visual.get();
+		Push(LcWorldCommand{ LcWorldCommandType::Insert, visualPtr, std::move(visual), TVComponentPtr() });
+	}
+	//
+	inline void Remove(IVisual* visual) { Push(LcWorldCommand{ LcWorldCommandType::Remove, visual, std::shared_ptr<IVisual>(), TVComponentPtr() }); }
+	//
+	inline void UpdateLayer(IVisual* visual) { Push(LcWorldCommand{ LcWorldCommandType::UpdateLayer, visual, std::shared_ptr<IVisual>(), TVComponentPtr() }); }
+	//
+	inline void AddComponent(IVisual* visual, TVComponentPtr comp)
+	{
+		Push(LcWorldCommand{ LcWorldCommandType::AddComponent, visual, std::shared_ptr<IVisual>(), std::move(comp) });
+	}
+	//
+	inline void RemoveComponent(IVisual* visual, TVComponentPtr comp)
+	{
+		Push(LcWorldCommand{ LcWorldCommandType::RemoveComponent, visual, std::shared_ptr<IVisual>(), std::move(comp) });
+	}
+	/**
+	* Sort commands to the apply order */
+	void Sort()
+	{
+		std::stable_sort(commands.begin(), commands.end(), [](const LcWorldCommand& a, const LcWorldCommand& b) {
+			return a.type < b.type;
+		});
+	}
+	/**
+	* Take queued commands, buffer keeps capacity of the given list */
+	inline void Swap(TCommandsList& outCommands) { commands.swap(outCommands); }
+	//
+	inline bool IsEmpty() const { return commands.empty(); }
+	//
+	inline const TCommandsList& GetCommands() const { return commands; }
+	//
+	inline void Clear() { commands.clear(); }
+
+
+protected:
+	inline void Push(LcWorldCommand&& command)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		commands.push_back(std::move(command));
+	}
+
+
+protected:
+	TCommandsList commands;
+	//
+	std::mutex mutex;
+	//
+	bool deferred;
+
+};
@@ -9,10 +9,13 @@
 #include "Module.h"
 #include "Core/LCTypesEx.h"
 #include "Core/LCDelegate.h"
+#include "World/VisualLayers.h"
 
 #include <deque>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 #pragma warning(disable : 4251)
 
@@ -39,6 +42,78 @@ namespace LcLayers
 };
 
 
+/** World snapshot sections, see IWorld::Save() */
+namespace LcWorldSections
+{
+	constexpr unsigned int State = 1;
+	constexpr unsigned int Visuals = 2;
+	constexpr unsigned int Components = 3;
+	constexpr unsigned int ComponentData = 4;
+	constexpr unsigned int WidgetLinks = 5;
+}
+
+
+/** Sprite descriptor for batch creation, see IWorld::AddSprites() */
+struct LcSpriteDesc
+{
+	LcSpriteDesc() : x(0.0f), y(0.0f), z(LcLayers::Z0), width(0.0f), height(0.0f), rotZ(0.0f), visible(true), tag(LcNoTag),
+		tint(LcDefaults::White4), hasTint(false), uvs{ { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } }, hasCustomUV(false),
+		frameSize(LcDefaults::ZeroSize), numFrames(0), framesPerSecond(0.0f) {}
+	//
+	float x, y;
+	// layer, clamped to (LcMinLayer, LcMaxLayer) on creation
+	float z;
+	//
+	float width, height;
+	//
+	float rotZ;
+	//
+	bool visible;
+	//
+	ObjectTag tag;
+	// tint component, added if hasTint is set
+	LcColor4 tint;
+	//
+	bool hasTint;
+	// texture component, added if path is not empty
+	std::string texture;
+	// custom UV component: left top, right top, right bottom, left bottom. Added if hasCustomUV is set
+	LcVector2 uvs[4];
+	//
+	bool hasCustomUV;
+	// animation component, added if numFrames > 0
+	LcSizef frameSize;
+	//
+	unsigned short numFrames;
+	//
+	float framesPerSecond;
+};
+
+
+/** Widget descriptor for batch creation, see IWorld::AddWidgets() */
+struct LcWidgetDesc
+{
+	LcWidgetDesc() : x(0.0f), y(0.0f), z(LcLayers::Z0), width(0.0f), height(0.0f), visible(true), tag(LcNoTag),
+		tint(LcDefaults::White4), hasTint(false) {}
+	//
+	float x, y;
+	// layer, clamped to (LcMinLayer, LcMaxLayer) on creation
+	float z;
+	//
+	float width, height;
+	//
+	bool visible;
+	//
+	ObjectTag tag;
+	// tint component, added if hasTint is set
+	LcColor4 tint;
+	//
+	bool hasTint;
+	// texture component, added if path is not empty
+	std::string texture;
+};
+
+
 /**
 * Game world scaling parameters for different resolutions.
 * For resolutions not added to scaleList scale selected by resolution.y >= newScreenSize.y
@@ -89,9 +164,10 @@ protected:
 class IWorld
 {
 public:
-	typedef std::multiset<std::shared_ptr<class IVisual>> TVisualSet;
+	typedef LcVisualLayers TVisualSet;
 	/**
-	* Subscribe to get changes of sprites global tint. */
+	* Subscribe to get changes of sprites global tint.
+	* Changes are coalesced and broadcast once per frame on ApplyDeferred() */
 	LcDelegate<LcColor3> onTintChanged;
 
 
@@ -118,12 +194,58 @@ public:
 	* Remove widget */
 	virtual void RemoveWidget(class IWidget* widget) = 0;
 	/**
+	* Add sprites from descriptors with their components. Storage is reserved once for all of them.
+	* Added sprites are appended to outSprites if it is set */
+	virtual void AddSprites(const LcSpriteDesc* descs, size_t count, std::vector<class ISprite*>* outSprites = nullptr) = 0;
+	/**
+	* Add widgets from descriptors, see AddSprites() */
+	virtual void AddWidgets(const LcWidgetDesc* descs, size_t count, std::vector<class IWidget*>* outWidgets = nullptr) = 0;
+	/**
+	* Park count reset sprites for reuse, so adding them later does not allocate.
+	* Call after render system is created, it sets sprite type */
+	virtual void ReserveSprites(size_t count) = 0;
+	/**
+	* Park count reset widgets for reuse, see ReserveSprites() */
+	virtual void ReserveWidgets(size_t count) = 0;
+	/**
 	* Remove all sprites and widgets */
 	virtual void Clear(bool removeRooted = false) = 0;
 	/**
+	* Save camera, global tint, visuals with their components and widget hierarchy to archive sections.
+	* Rooted visuals are skipped if saveRooted is not set. Event handlers are not saved */
+	virtual void Save(class LcArchiveWriter& writer, bool saveRooted = false) const = 0;
+	/**
+	* Add visuals saved by Save(). Existing visuals are kept, so clear world before level restore.
+	* Visuals get new handles */
+	virtual void Load(const class LcArchiveReader& reader) = 0;
+	/**
+	* Add component to visual. Deferred while world is deferred.
+	* Existing component of the same type is replaced and destroyed */
+	virtual void AddComponent(class IVisual* visual, TVComponentPtr comp) = 0;
+	/**
+	* Remove component from visual. Deferred while world is deferred */
+	virtual void RemoveComponent(class IVisual* visual, class IVisualComponent* comp) = 0;
+	/**
+	* Start deferring structural changes: added and removed visuals, components changed
+	* through the world and layer changes. Used while visuals are iterated.
+	* Added visuals get handles and could be set up at once, but they are stored on apply */
+	virtual void BeginDeferred() = 0;
+	/**
+	* Apply deferred changes in one pass and stop deferring. Frame sync point */
+	virtual void ApplyDeferred() = 0;
+	/**
+	* Check structural changes are deferred */
+	virtual bool IsDeferred() const = 0;
+	/**
 	* Get visual by tag */
 	virtual class IVisual* GetVisualByTag(ObjectTag tag) const = 0;
 	/**
+	* Append all visuals with tag to the list. Returns number of found visuals */
+	virtual size_t GetVisualsByTag(ObjectTag tag, std::vector<class IVisual*>& outVisuals) const = 0;
+	/**
+	* Get visual by handle. Returns nullptr for removed visuals */
+	virtual class IVisual* GetVisualByHandle(LcObjectHandle handle) const = 0;
+	/**
 	* Get object by tag */
 	template<class T>
 	T* GetObjectByTag(ObjectTag tag) const { return static_cast<T*>(GetVisualByTag(tag)); }
@@ -134,6 +256,16 @@ public:
 	* Get sprites and widgets */
 	virtual TVisualSet& GetVisuals() = 0;
 	/**
+	* Get visuals intersecting rect in world coordinates, ordered back to front.
+	* Widgets, tiled and particles sprites are always returned */
+	virtual void GetVisibleVisuals(const LcRectf& rect, std::vector<class IVisual*>& outVisuals) = 0;
+	/**
+	* Get camera view rect in world coordinates, world scale applied */
+	virtual LcRectf GetCameraRect() const = 0;
+	/**
+	* Set culling grid cell size in pixels. Default: 256 */
+	virtual void SetCullingCellSize(float cellSize) = 0;
+	/**
 	* Get camera */
 	virtual const class LcCamera& GetCamera() const = 0;
 	/**
@@ -155,7 +287,7 @@ public:
 	* Get global sprites and widgets tint color */
 	virtual LcColor3 GetGlobalTint() const = 0;
 	/**
-	* Get last added visual */
+	* Get last added visual, nullptr when it is removed */
 	virtual class IVisual* GetLastAddedVisual() const = 0;
 	/**
 	* Get visual helper */
@@ -168,3 +300,33 @@ public:
 	virtual const class LcWidgetHelper& GetWidgetHelper() const = 0;
 
 };
+
+
+/**
+* Defers world structural changes in scope. Apply() at the end of the scope,
+* if scope is left by exception, changes are applied and world stops deferring anyway.
+*/
+class LcWorldDeferredScope
+{
+public:
+	LcWorldDeferredScope(IWorld& inWorld) : world(inWorld) { world.BeginDeferred(); }
+	//
+	~LcWorldDeferredScope()
+	{
+		if (!world.IsDeferred()) return;
+
+		try { world.ApplyDeferred(); }
+		catch (...) {}
+	}
+	//
+	void Apply() { world.ApplyDeferred(); }
+	//
+	LcWorldDeferredScope(const LcWorldDeferredScope&) = delete;
+	//
+	LcWorldDeferredScope& operator=(const LcWorldDeferredScope&) = delete;
+
+
+protected:
+	IWorld& world;
+
+};
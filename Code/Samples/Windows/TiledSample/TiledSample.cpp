@@ -55,7 +55,7 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance
             auto body = context.physics->GetDynamicBodies()[0];
             if (auto hero = body->GetUserObject<ISprite>())
             {
-                hero->SetPos(body->GetPos());
+                hero->SetPos(body->GetInterpolatedPos());
             }
 
             auto vel = body->GetVelocity();
@@ -0,0 +1,57 @@
+
+cbuffer VS_PROJ_BUFFER : register(b0)
+{
+	float4x4 mProj;
+};
+
+cbuffer VS_VIEW_BUFFER : register(b1)
+{
+	float4x4 mView;
+};
+
+cbuffer VS_SETTINGS_BUFFER : register(b6)
+{
+	float4 vGlobalTint;
+};
+
+struct VOut
+{
+	float4 vPosition : SV_POSITION;
+	float4 vColor : COLOR0;
+	float4 vTint : COLOR1;
+	float2 vCoord : TEXCOORD;
+};
+
+VOut VShader(float4 vPosition : POSITION, float4 vColor : COLOR, float2 vCoord : TEXCOORD)
+{
+	VOut output;
+	float4x4 mVP = mul(mView, mProj);
+
+	output.vPosition = mul(vPosition, mVP);
+	output.vColor = vColor;
+	output.vTint = vGlobalTint;
+	output.vCoord = vCoord;
+
+	return output;
+}
+
+Texture2D tex2D;
+
+SamplerState linearSampler
+{
+	Filter = MIN_MAG_MIP_LINEAR;
+	AddressU = Wrap;
+	AddressV = Wrap;
+};
+
+float4 PShader(float4 vPosition : SV_POSITION,
+	float4 vColor : COLOR0, float4 vTint : COLOR1,
+	float2 vCoord : TEXCOORD) : SV_TARGET
+{
+	float4 texColor = tex2D.Sample(linearSampler, vCoord);
+
+	if (vColor.a == 0.0f)
+		return texColor * vTint;
+	else
+		return texColor * vColor * vTint;
+}
@@ -0,0 +1,50 @@
+/**
+* LcTest.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+/** Test function */
+typedef void (*LcTestFunc)();
+
+/** Registered test */
+struct LcTestCase
+{
+	const char* name;
+	//
+	LcTestFunc func;
+};
+
+/** Failed check, not std::exception so engine catch blocks do not wrap it */
+struct LcTestFailure
+{
+	std::string message;
+};
+
+
+/** All registered tests */
+std::vector<LcTestCase>& GetTestCases();
+
+/** Registers test before main() */
+struct LcTestRegistrar
+{
+	LcTestRegistrar(const char* name, LcTestFunc func) { GetTestCases().push_back(LcTestCase{ name, func }); }
+};
+
+/** Throws LcTestFailure with location */
+void FailTest(const char* file, int line, const char* expression);
+
+
+// Define test
+#define LC_TEST(name) static void name(); static LcTestRegistrar name##Registrar(#name, name); static void name()
+// Check expression, fails current test
+#define LC_CHECK(expression) do { if (!(expression)) FailTest(__FILE__, __LINE__, #expression); } while (0)
+// Check expression throws
+#define LC_CHECK_THROWS(expression) do { bool thrown = false; try { expression; } catch (...) { thrown = true; } \
+	if (!thrown) FailTest(__FILE__, __LINE__, "throws: " #expression); } while (0)
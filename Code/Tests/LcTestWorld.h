@@ -0,0 +1,46 @@
+/**
+* LcTestWorld.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#pragma once
+
+#include "World/Module.h"
+#include "World/WorldInterface.h"
+#include "RenderSystem/RenderSystemNull/RenderSystemNull.h"
+
+#include <vector>
+
+
+/** World with null render, no window and GPU */
+struct LcTestWorld
+{
+	LcTestWorld()
+	{
+		render = GetNullRenderSystem();
+		world = GetWorld(context);
+		context.render = render.get();
+		context.world = world.get();
+		render->Create(nullptr, LcWinMode::Windowed, false, false, context);
+	}
+	//
+	~LcTestWorld()
+	{
+		world->Clear(true);
+		render->Shutdown();
+	}
+	//
+	std::vector<IVisual*> GetVisuals() const
+	{
+		std::vector<IVisual*> visuals;
+		for (auto& visual : world->GetVisuals()) visuals.push_back(visual.get());
+		return visuals;
+	}
+	//
+	LcAppContext context;
+	//
+	TRenderSystemPtr render;
+	//
+	TWorldPtr world;
+};
@@ -0,0 +1,128 @@
+/**
+* TestCompression.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "Core/LCCompression.h"
+#include "Core/LCUtils.h"
+
+#include <string>
+
+
+static std::string Decode(const std::string& text)
+{
+	std::string out(text.size(), '\0');
+	out.resize(DecodeBase64(text.data(), text.size(), out.data(), out.size()));
+	return out;
+}
+
+static LcBytes ReadData(const char* fileName)
+{
+	return ReadBinaryFile((std::string(LC_TESTS_DATA_DIR) + "/" + fileName).c_str());
+}
+
+typedef size_t (*LcInflateFunc)(const void* data, size_t size, void* outData, size_t outCapacity);
+
+/** Inflate fixture and compare with Payload.bin */
+static bool InflateMatches(LcInflateFunc inflate, const char* fileName)
+{
+	auto payload = ReadData("Payload.bin");
+	auto data = ReadData(fileName);
+
+	LcBytes out(payload.size());
+	size_t outSize = inflate(data.data(), data.size(), out.data(), out.size());
+	return outSize == payload.size() && out == payload;
+}
+
+/** Check corrupted, truncated and too large streams are rejected */
+static void CheckInflateErrors(LcInflateFunc inflate, const char* fileName)
+{
+	auto payload = ReadData("Payload.bin");
+	auto data = ReadData(fileName);
+	LcBytes out(payload.size());
+
+	// checksum is the last trailer field for zlib, first one for gzip
+	auto badChecksum = data;
+	badChecksum[(inflate == InflateZlib) ? badChecksum.size() - 1 : badChecksum.size() - 8] ^= 0x01;
+	LC_CHECK_THROWS(inflate(badChecksum.data(), badChecksum.size(), out.data(), out.size()));
+
+	LC_CHECK_THROWS(inflate(data.data(), data.size() - 1, out.data(), out.size()));
+	LC_CHECK_THROWS(inflate(data.data(), data.size() / 2, out.data(), out.size()));
+	LC_CHECK_THROWS(inflate(data.data(), 1, out.data(), out.size()));
+
+	LC_CHECK_THROWS(inflate(data.data(), data.size(), out.data(), out.size() - 1));
+}
+
+
+LC_TEST(Base64Decode)
+{
+	LC_CHECK(Decode("") == "");
+	LC_CHECK(Decode("TWFu") == "Man");
+	LC_CHECK(Decode("TWE=") == "Ma");
+	LC_CHECK(Decode("TQ==") == "M");
+	LC_CHECK(Decode("TWE") == "Ma");
+	LC_CHECK(Decode("SGVsbG8gd29ybGQh") == "Hello world!");
+
+	LC_CHECK_THROWS(Decode("T"));
+	LC_CHECK_THROWS(Decode("TWF=="));
+	LC_CHECK_THROWS(Decode("TWFu="));
+	LC_CHECK_THROWS(Decode("TW*u"));
+
+	std::string out(2, '\0');
+	LC_CHECK_THROWS(DecodeBase64("TWFu", 4, out.data(), out.size()));
+}
+
+LC_TEST(Base64DecodeSkipsWhitespace)
+{
+	LC_CHECK(Decode("SGVsbG8gd29ybGQh\n") == "Hello world!");
+	LC_CHECK(Decode("SGVs\r\nbG8g\r\nd29y\r\nbGQh\r\n") == "Hello world!");
+	LC_CHECK(Decode("  SG Vsb\tG8gd29y bGQh  ") == "Hello world!");
+	LC_CHECK(Decode("SGVsbG8=\n") == "Hello");
+	LC_CHECK(Decode("TQ=\n=") == "M");
+	LC_CHECK(Decode(" \n ") == "");
+
+	LC_CHECK_THROWS(Decode("T\nW\nF\nu\nT"));
+
+	// in place decoding, as tiled map layers are decoded
+	std::string text = "SGVs\nbG8g\nd29y\nbGQh\n";
+	size_t size = DecodeBase64(text.data(), text.size(), text.data(), text.size());
+	LC_CHECK(text.substr(0, size) == "Hello world!");
+}
+
+LC_TEST(InflateZlibBlocks)
+{
+	LC_CHECK(InflateMatches(InflateZlib, "PayloadStored.zlib"));
+	LC_CHECK(InflateMatches(InflateZlib, "PayloadFixed.zlib"));
+	LC_CHECK(InflateMatches(InflateZlib, "PayloadDynamic.zlib"));
+
+	// gzip stream is not zlib
+	LC_CHECK_THROWS(InflateMatches(InflateZlib, "PayloadDynamic.gz"));
+}
+
+LC_TEST(InflateZlibErrors)
+{
+	CheckInflateErrors(InflateZlib, "PayloadStored.zlib");
+	CheckInflateErrors(InflateZlib, "PayloadFixed.zlib");
+	CheckInflateErrors(InflateZlib, "PayloadDynamic.zlib");
+}
+
+LC_TEST(InflateGzipBlocks)
+{
+	LC_CHECK(InflateMatches(InflateGzip, "PayloadStored.gz"));
+	LC_CHECK(InflateMatches(InflateGzip, "PayloadFixed.gz"));
+	LC_CHECK(InflateMatches(InflateGzip, "PayloadDynamic.gz"));
+	// header with file name
+	LC_CHECK(InflateMatches(InflateGzip, "PayloadName.gz"));
+
+	LC_CHECK_THROWS(InflateMatches(InflateGzip, "PayloadDynamic.zlib"));
+}
+
+LC_TEST(InflateGzipErrors)
+{
+	CheckInflateErrors(InflateGzip, "PayloadStored.gz");
+	CheckInflateErrors(InflateGzip, "PayloadFixed.gz");
+	CheckInflateErrors(InflateGzip, "PayloadDynamic.gz");
+}
@@ -0,0 +1,40 @@
+/**
+* TestFramePacer.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "Core/LCFramePacer.h"
+
+
+LC_TEST(FramePacerIdleSleep)
+{
+	const unsigned int NumFrames = 20;
+
+	// no frame limit still sleeps, so loop does not spin the core
+	LcFramePacer pacer;
+	LC_CHECK(pacer.GetTargetFPS() == 0 && pacer.GetIdleSleep());
+	for (unsigned int i = 0; i < NumFrames; i++) pacer.Wait();
+
+	auto stats = pacer.GetStats();
+	LC_CHECK(stats.numFrames == NumFrames);
+	LC_CHECK(stats.minFrameTime >= 1.0f);
+
+	// No Delay mode
+	pacer.SetIdleSleep(false);
+	pacer.Reset();
+	for (unsigned int i = 0; i < NumFrames; i++) pacer.Wait();
+	LC_CHECK(pacer.GetStats().avgFrameTime < 1.0f);
+}
+
+LC_TEST(FramePacerTargetFPS)
+{
+	LcFramePacer pacer(100);
+	for (int i = 0; i < 10; i++) pacer.Wait();
+
+	auto stats = pacer.GetStats();
+	LC_CHECK(stats.numFrames == 10);
+	LC_CHECK(stats.avgFrameTime >= 9.0f);
+}
@@ -0,0 +1,78 @@
+/**
+* TestHandleTable.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "Core/LCSlotMap.h"
+#include "Core/LCDelegate.h"
+
+
+LC_TEST(HandleTableStaleHandles)
+{
+	LcHandleTable<int> table;
+	auto first = table.Add(1);
+	auto second = table.Add(2);
+	LC_CHECK(first != LcInvalidHandle && second != LcInvalidHandle && first != second);
+	LC_CHECK(*table.Get(second) == 2);
+
+	table.Remove(first);
+	LC_CHECK(!table.IsValid(first));
+	LC_CHECK(table.Get(first) == nullptr);
+
+	// slot is reused with new generation
+	auto third = table.Add(3);
+	LC_CHECK(LcHandleTable<int>::ToIndex(third) == LcHandleTable<int>::ToIndex(first));
+	LC_CHECK(third != first);
+	LC_CHECK(!table.IsValid(first));
+	LC_CHECK(table.Size() == 2);
+
+	table.Remove(first);
+	LC_CHECK(table.Size() == 2);
+}
+
+LC_TEST(HandleTableClearAfterRemove)
+{
+	// removed slot at the tail of free list must not be removed again by Clear()
+	LcHandleTable<int> table;
+	auto first = table.Add(1);
+	auto second = table.Add(2);
+	table.Remove(first);
+	table.Clear();
+
+	LC_CHECK(table.Size() == 0);
+	LC_CHECK(!table.IsValid(first));
+	LC_CHECK(!table.IsValid(second));
+
+	auto third = table.Add(3);
+	auto fourth = table.Add(4);
+	LC_CHECK(third != fourth);
+	LC_CHECK(LcHandleTable<int>::ToIndex(third) != LcHandleTable<int>::ToIndex(fourth));
+	LC_CHECK(table.Size() == 2);
+	LC_CHECK(*table.Get(third) == 3 && *table.Get(fourth) == 4);
+
+	// all slots are reused, table does not grow
+	auto fifth = table.Add(5);
+	LC_CHECK(LcHandleTable<int>::ToIndex(fifth) == 2);
+}
+
+LC_TEST(DelegateRemoveAllListeners)
+{
+	LcDelegate<int> delegate;
+	int sum = 0;
+	auto first = delegate.AddListener([&sum](int value) { sum += value; });
+	delegate.AddListener([&sum](int value) { sum += value * 10; });
+	delegate.RemoveListener(first);
+	delegate.RemoveAllListeners();
+
+	auto third = delegate.AddListener([&sum](int value) { sum += value * 100; });
+	auto fourth = delegate.AddListener([&sum](int value) { sum += value * 1000; });
+	LC_CHECK(third != fourth);
+	LC_CHECK(delegate.GetNumListeners() == 2);
+
+	delegate.RemoveListener(third);
+	delegate.Broadcast(1);
+	LC_CHECK(sum == 1000);
+}
@@ -0,0 +1,98 @@
+/**
+* TestJobSystem.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "Core/LCJobSystem.h"
+
+#include <atomic>
+#include <vector>
+
+
+LC_TEST(JobSystemParallelForCoversRange)
+{
+	const size_t sizes[] = { 0, 1, 7, 64, 1000, 10007 };
+	const size_t grainSizes[] = { 0, 1, 13, 4096 };
+
+	for (unsigned int numWorkers : { 1u, 2u, 4u })
+	{
+		LcJobSystem jobs(numWorkers);
+		LC_CHECK(jobs.GetNumWorkers() == numWorkers);
+
+		for (size_t size : sizes)
+		{
+			for (size_t grainSize : grainSizes)
+			{
+				// every index is visited exactly once, range is offset from zero
+				std::vector<std::atomic<int>> visits(size);
+				for (auto& visit : visits) visit = 0;
+
+				jobs.ParallelFor(5, 5 + size, grainSize, [&visits](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; i++) visits[i - 5]++;
+				});
+
+				for (auto& visit : visits) LC_CHECK(visit == 1);
+			}
+		}
+	}
+}
+
+LC_TEST(JobSystemWaitForCounter)
+{
+	LcJobSystem jobs(3);
+	LcJobCounter counter;
+	std::atomic<int> numDone(0);
+
+	const int numJobs = 200;
+	for (int i = 0; i < numJobs; i++)
+	{
+		jobs.Run([&numDone]() {
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+			numDone++;
+		}, &counter);
+	}
+
+	jobs.Wait(counter);
+	LC_CHECK(counter.IsDone());
+	LC_CHECK(numDone == numJobs);
+
+	// job exception is rethrown by Wait()
+	LcJobCounter errorCounter;
+	jobs.Run([]() { throw std::exception("Job error"); }, &errorCounter);
+	LC_CHECK_THROWS(jobs.Wait(errorCounter));
+	LC_CHECK(errorCounter.IsDone());
+}
+
+LC_TEST(JobSystemNestedJobs)
+{
+	LcJobSystem jobs(2);
+	LcJobCounter counter;
+	std::atomic<int> numInner(0);
+	std::atomic<int> numRanges(0);
+
+	// jobs spawned from workers wait for their own jobs, which could be stolen
+	const int numOuter = 16;
+	for (int i = 0; i < numOuter; i++)
+	{
+		jobs.Run([&jobs, &numInner, &numRanges]() {
+			LcJobCounter innerCounter;
+			for (int j = 0; j < 8; j++)
+			{
+				jobs.Run([&numInner]() { numInner++; }, &innerCounter);
+			}
+
+			jobs.Wait(innerCounter);
+
+			jobs.ParallelFor(0, 100, 10, [&numRanges](size_t begin, size_t end) {
+				numRanges += (int)(end - begin);
+			});
+		}, &counter);
+	}
+
+	jobs.Wait(counter);
+	LC_CHECK(numInner == numOuter * 8);
+	LC_CHECK(numRanges == numOuter * 100);
+}
@@ -0,0 +1,74 @@
+/**
+* TestLua.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "LcTestWorld.h"
+#include "Lua/LuaScriptSystem.h"
+
+#include "Lua/src/lua.hpp"
+
+
+/** Test world with Lua script system and World module */
+struct LcTestLua : public LcTestWorld
+{
+	LcTestLua() : scripts(GetScriptSystem())
+	{
+		context.scripts = scripts.get();
+		scripts->Init(context);
+		AddLuaModuleWorld(context);
+	}
+	//
+	lua_State* GetState() const { return static_cast<LcLuaScriptSystem*>(scripts.get())->GetState(); }
+	//
+	TScriptSystemPtr scripts;
+};
+
+
+LC_TEST(LuaVisualTags)
+{
+	LcTestLua test;
+
+	// generic object functions resolve visual handles
+	test.scripts->RunScript("sprite = AddSprite(0.0, 0.0, 10.0, 10.0, 0.0, true) SetTag(sprite, 5)");
+	LC_CHECK(test.scripts->RunScriptEx("return GetTag(sprite)").iValue == 5);
+
+	auto sprite = test.world->GetVisualByTag(5);
+	LC_CHECK(sprite && sprite->GetTypeId() == LcCreatables::Sprite);
+
+	test.scripts->RunScript("widget = AddWidget(0.0, 0.0, 10.0, 10.0, true) SetTag(widget, 6) AddToRoot(widget)");
+	LC_CHECK(test.scripts->RunScriptEx("return GetTag(widget)").iValue == 6);
+	LC_CHECK(test.scripts->RunScriptEx("return IsRooted(widget) and 1 or 0").iValue == 1);
+	test.scripts->RunScript("RemoveFromRoot(widget)");
+	LC_CHECK(test.scripts->RunScriptEx("return IsRooted(widget) and 1 or 0").iValue == 0);
+
+	// handles of the same visual are equal
+	LC_CHECK(test.scripts->RunScriptEx("return (GetVisualByTag(5) == sprite) and 1 or 0").iValue == 1);
+	LC_CHECK(test.scripts->RunScriptEx("return (GetVisualByTag(6) == sprite) and 1 or 0").iValue == 0);
+}
+
+LC_TEST(LuaRemovedVisual)
+{
+	LcTestLua test;
+	auto luaState = test.GetState();
+
+	auto sprite = test.world->AddSprite(0.0f, 0.0f, 10.0f, 10.0f);
+	PushVisual(luaState, sprite);
+	LC_CHECK(IsVisual(luaState, -1) && GetVisual(luaState, -1) == sprite);
+	LC_CHECK(GetObjectBase(luaState, -1) == sprite);
+
+	// stale handle is not resolved, even if the sprite is recycled
+	test.world->RemoveSprite(sprite);
+	test.world->AddSprite(0.0f, 0.0f, 10.0f, 10.0f);
+	LC_CHECK_THROWS(GetVisual(luaState, -1));
+	lua_pop(luaState, 1);
+
+	// light userdata is not a visual
+	lua_pushlightuserdata(luaState, sprite);
+	LC_CHECK(!IsVisual(luaState, -1));
+	LC_CHECK_THROWS(GetVisual(luaState, -1));
+	lua_pop(luaState, 1);
+}
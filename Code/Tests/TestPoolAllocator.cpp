@@ -0,0 +1,54 @@
+/**
+* TestPoolAllocator.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "Core/LCPoolAllocator.h"
+
+#include <thread>
+#include <vector>
+
+
+LC_TEST(PoolAllocatorSharedBetweenThreads)
+{
+	struct LcPooledItem { int owner; int value[5]; };
+
+	const int NumRounds = 1000;
+	const int NumItems = 1000;
+
+	// threads allocate and release concurrently, block given twice would be overwritten by other owner
+	auto run = [](int owner, bool* outValid)
+	{
+		std::vector<std::shared_ptr<LcPooledItem>> items(NumItems);
+		for (int round = 0; round < NumRounds; round++)
+		{
+			for (auto& item : items)
+			{
+				item = LcMakePooled<LcPooledItem>();
+				item->owner = owner;
+			}
+
+			for (auto& item : items)
+			{
+				if (item->owner != owner) *outValid = false;
+				item.reset();
+			}
+		}
+	};
+
+	bool valid[2] = { true, true };
+	std::thread worker(run, 1, &valid[1]);
+	run(0, &valid[0]);
+	worker.join();
+
+	LC_CHECK(valid[0] && valid[1]);
+
+	// blocks released on other thread are reused
+	auto item = LcMakePooled<LcPooledItem>();
+	std::thread releaser([&item]() { item.reset(); });
+	releaser.join();
+	LC_CHECK(!item);
+}
@@ -0,0 +1,100 @@
+/**
+* TestRenderSnapshot.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "LcTestWorld.h"
+#include "World/SpriteInterface.h"
+#include "RenderSystem/RenderSnapshot.h"
+#include "RenderSystem/RenderSystemNull/RenderSystemNull.h"
+
+
+/** Null render without snapshot support, like DX10 */
+class LcTestRenderSystemSerial : public LcRenderSystemNull
+{
+protected:
+	virtual bool SupportsThreadedRender() const override { return false; }
+};
+
+
+LC_TEST(RenderSnapshotDrops)
+{
+	LcRenderSnapshotBuffer buffer;
+
+	// reader did not acquire the first snapshot, it is replaced by the second one
+	buffer.BeginWrite();
+	buffer.Publish();
+	buffer.BeginWrite();
+	buffer.Publish();
+	LC_CHECK(buffer.GetNumDropped() == 1);
+
+	auto snapshot = buffer.Acquire();
+	LC_CHECK(snapshot && snapshot->frame == 1);
+
+	// writer fills the other snapshot while reader draws
+	buffer.BeginWrite();
+	buffer.Release();
+	buffer.Publish();
+	LC_CHECK(buffer.GetNumDropped() == 1);
+
+	snapshot = buffer.Acquire();
+	LC_CHECK(snapshot && snapshot->frame == 2);
+	buffer.Release();
+	buffer.Stop();
+}
+
+LC_TEST(RenderSnapshotThreadedSupport)
+{
+	LcRenderSystemNull render;
+	render.SetThreadedRender(true);
+	render.SetThreadedRender(false);
+
+	LcTestRenderSystemSerial serialRender;
+	LC_CHECK_THROWS(serialRender.SetThreadedRender(true));
+	serialRender.SetThreadedRender(false);
+}
+
+LC_TEST(RenderSnapshotThreadedMatchesInline)
+{
+	LcTestWorld test;
+	auto render = static_cast<LcRenderSystemNull*>(test.render.get());
+
+	// batched textured sprites, colored and rotated sprites on several layers
+	for (int i = 0; i < 20; i++)
+	{
+		auto sprite = test.world->AddSprite(50.0f + i * 30.0f, 100.0f, LcLayers::Z2, 20.0f, 20.0f);
+		sprite->AddTextureComponent(test.context, (i % 3 == 0) ? "a.png" : "b.png");
+	}
+
+	auto colored = test.world->AddSprite(300.0f, 300.0f, LcLayers::Z1, 50.0f, 40.0f, 0.5f);
+	colored->AddTintComponent(test.context, LcColor4{ 1.0f, 0.0f, 0.0f, 1.0f });
+
+	auto gradient = test.world->AddSprite(500.0f, 300.0f, LcLayers::Z3, 32.0f, 32.0f);
+	gradient->AddColorsComponent(test.context, LcColor4{ 1.0f, 0.0f, 0.0f, 1.0f }, LcColor4{ 0.0f, 1.0f, 0.0f, 1.0f },
+		LcColor4{ 0.0f, 0.0f, 1.0f, 1.0f }, LcColor4{ 1.0f, 1.0f, 1.0f, 1.0f });
+
+	render->Update(0.0f, test.context);
+	render->Render(test.context);
+	auto inlineCommands = render->GetCommands();
+	LC_CHECK(!inlineCommands.empty());
+
+	render->SetThreadedRender(true);
+	render->Update(0.0f, test.context);
+	render->Render(test.context);
+	render->WaitRenderThread();
+	auto threadedCommands = render->GetCommands();
+	render->SetThreadedRender(false);
+
+	LC_CHECK(threadedCommands.size() == inlineCommands.size());
+	for (size_t i = 0; i < inlineCommands.size(); i++)
+	{
+		auto& a = inlineCommands[i];
+		auto& b = threadedCommands[i];
+		LC_CHECK(a.pipeline == b.pipeline && a.texture == b.texture && a.numVertices == b.numVertices);
+		LC_CHECK(a.pos.x == b.pos.x && a.pos.y == b.pos.y && a.pos.z == b.pos.z);
+		LC_CHECK(a.size.x == b.size.x && a.size.y == b.size.y && a.rotZ == b.rotZ);
+	}
+}
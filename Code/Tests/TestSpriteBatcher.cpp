@@ -0,0 +1,65 @@
+/**
+* TestSpriteBatcher.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "RenderSystem/SpriteBatcher.h"
+
+
+LC_TEST(SpriteBatcherMakeIndices)
+{
+	std::vector<unsigned short> indices;
+	LcSpriteBatcher::MakeIndices(3, indices);
+	LC_CHECK(indices.size() == 3 * LcSpriteBatcher::IndicesPerQuad);
+
+	const unsigned short expected[] = { 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7, 8, 9, 10, 8, 10, 11 };
+	for (size_t i = 0; i < indices.size(); i++) LC_CHECK(indices[i] == expected[i]);
+
+	// full 16-bit range
+	const unsigned int maxQuads = 0x10000 / LcSpriteBatcher::VerticesPerQuad;
+	LcSpriteBatcher::MakeIndices(maxQuads, indices);
+	LC_CHECK(indices.size() == maxQuads * LcSpriteBatcher::IndicesPerQuad);
+	LC_CHECK(indices.back() == 0xFFFF);
+}
+
+LC_TEST(SpriteBatcherQuads)
+{
+	const LcColor4 colors[] = { LcColor4{ 1, 0, 0, 1 }, LcColor4{ 0, 1, 0, 1 }, LcColor4{ 0, 0, 1, 1 }, LcColor4{ 1, 1, 1, 1 } };
+	const LcVector4 uvs[] = { LcVector4{ 0, 0, 0, 0 }, LcVector4{ 1, 0, 0, 0 }, LcVector4{ 1, 1, 0, 0 }, LcVector4{ 0, 1, 0, 0 } };
+
+	LcSpriteBatcher batcher(16);
+	batcher.Begin(LcVector2{ 2.0f, 2.0f });
+	batcher.Add(LcVector3{ 10.0f, 20.0f, 0.5f }, LcVector2{ 4.0f, 6.0f }, 0.0f, colors, uvs);
+	batcher.Add(LcVector3{ 0.0f, 0.0f, 0.0f }, LcVector2{ 1.0f, 1.0f }, 0.0f, colors, uvs);
+	LC_CHECK(batcher.GetNumQuads() == 2);
+
+	// world scale applies to position and size, left top corner has flipped Y
+	auto vertices = batcher.GetVertices();
+	LC_CHECK(vertices[0].pos.x == 16.0f && vertices[0].pos.y == 34.0f && vertices[0].pos.z == 0.5f);
+	LC_CHECK(vertices[2].pos.x == 24.0f && vertices[2].pos.y == 46.0f);
+	LC_CHECK(vertices[1].color.g == 1.0f && vertices[3].uv.y == 1.0f);
+
+	batcher.Begin(LcVector2{ 1.0f, 1.0f });
+	LC_CHECK(batcher.GetNumQuads() == 0);
+}
+
+LC_TEST(SpriteBatcherRingAllocate)
+{
+	LcSpriteBatcher batcher(16);
+	bool discard = false;
+
+	// first allocation discards, next ones append
+	LC_CHECK(batcher.Allocate(10, discard) == 0);
+	LC_CHECK(discard);
+	LC_CHECK(batcher.Allocate(6, discard) == 10);
+	LC_CHECK(!discard);
+
+	// wrap around
+	LC_CHECK(batcher.Allocate(1, discard) == 0);
+	LC_CHECK(discard);
+
+	LC_CHECK_THROWS(batcher.Allocate(17, discard));
+}
@@ -0,0 +1,139 @@
+/**
+* TestTileChunks.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "RenderSystem/TileChunks.h"
+#include "World/SpriteInterface.h"
+
+#include <cfloat>
+
+
+// layers of width x height tiles of size 1, last layer is sparse
+static std::vector<LC_TILES_DATA> MakeTiles(int width, int height, int numLayers)
+{
+	std::vector<LC_TILES_DATA> tiles;
+	for (int layer = 0; layer < numLayers; layer++)
+	{
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				if (layer == numLayers - 1 && (x + y) % 3 != 0) continue;
+
+				float left = (float)x, top = (float)y;
+				LC_TILES_DATA tile{};
+				tile.pos[0] = LcVector3{ left, top, 0.0f };
+				tile.pos[1] = LcVector3{ left + 1.0f, top + 1.0f, 0.0f };
+				tile.pos[2] = LcVector3{ left + 1.0f, top, 0.0f };
+				tile.pos[3] = LcVector3{ left, top + 1.0f, 0.0f };
+				tile.uv[0].x = (float)layer;
+				tiles.push_back(tile);
+			}
+		}
+	}
+
+	return tiles;
+}
+
+static unsigned int CountTiles(const std::vector<LcTileRange>& ranges)
+{
+	unsigned int numTiles = 0;
+	for (auto& range : ranges) numTiles += range.numTiles;
+	return numTiles;
+}
+
+LC_TEST(TileChunksBuildOrder)
+{
+	auto tiles = MakeTiles(100, 70, 3);
+	LcTileChunks chunks;
+	chunks.Build(tiles.data(), tiles.size());
+
+	// 100x70 tiles in 32x32 chunks
+	LC_CHECK(chunks.GetChunks().size() == 12);
+	LC_CHECK(chunks.GetNumTiles() == tiles.size());
+
+	// every tile once
+	auto& order = chunks.GetOrder();
+	LC_CHECK(order.size() == tiles.size());
+	std::vector<int> seen(tiles.size(), 0);
+	for (auto index : order) seen[index]++;
+	for (auto count : seen) LC_CHECK(count == 1);
+
+	// source order inside chunk, so layers keep draw order
+	for (auto& chunk : chunks.GetChunks())
+	{
+		for (unsigned int i = chunk.firstTile + 1; i < chunk.firstTile + chunk.numTiles; i++)
+		{
+			LC_CHECK(order[i - 1] < order[i]);
+		}
+	}
+}
+
+LC_TEST(TileChunksVisibleRanges)
+{
+	auto tiles = MakeTiles(100, 70, 3);
+	LcTileChunks chunks;
+	chunks.Build(tiles.data(), tiles.size());
+	std::vector<LcTileRange> ranges;
+
+	// infinite rect gives all chunks merged to one range
+	chunks.GetVisibleRanges(LcRectf{ -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX }, ranges);
+	LC_CHECK(ranges.size() == 1);
+	LC_CHECK(CountTiles(ranges) == tiles.size());
+
+	// inside one chunk
+	chunks.GetVisibleRanges(LcRectf{ 10.0f, 10.0f, 20.0f, 20.0f }, ranges);
+	LC_CHECK(ranges.size() == 1);
+	LC_CHECK(ranges[0].numTiles == chunks.GetChunks()[0].numTiles);
+
+	// corner of four chunks
+	chunks.GetVisibleRanges(LcRectf{ 31.5f, 31.5f, 32.5f, 32.5f }, ranges);
+	auto& allChunks = chunks.GetChunks();
+	LC_CHECK(CountTiles(ranges) == allChunks[0].numTiles + allChunks[1].numTiles + allChunks[4].numTiles + allChunks[5].numTiles);
+
+	// out of map
+	chunks.GetVisibleRanges(LcRectf{ 200.0f, 200.0f, 300.0f, 300.0f }, ranges);
+	LC_CHECK(ranges.empty());
+
+	// no visible tile is culled
+	LcRectf rect{ 40.0f, 5.0f, 70.0f, 50.0f };
+	chunks.GetVisibleRanges(rect, ranges);
+	std::vector<bool> visible(tiles.size(), false);
+	for (auto& range : ranges)
+	{
+		for (unsigned int i = range.firstTile; i < range.firstTile + range.numTiles; i++) visible[chunks.GetOrder()[i]] = true;
+	}
+
+	for (size_t i = 0; i < tiles.size(); i++)
+	{
+		auto& tile = tiles[i];
+		bool inRect = tile.pos[0].x <= rect.right && tile.pos[1].x >= rect.left && tile.pos[0].y <= rect.bottom && tile.pos[1].y >= rect.top;
+		if (inRect) LC_CHECK(visible[i]);
+	}
+}
+
+LC_TEST(TileChunksSmallAndEmpty)
+{
+	auto tiles = MakeTiles(2, 2, 1);
+	LcTileChunks chunks;
+	chunks.Build(tiles.data(), 1);
+	LC_CHECK(chunks.GetChunks().size() == 1);
+
+	chunks.Build(nullptr, 0);
+	std::vector<LcTileRange> ranges;
+	chunks.GetVisibleRanges(LcRectf{ -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX }, ranges);
+	LC_CHECK(ranges.empty());
+
+	LC_CHECK_THROWS(chunks.Build(tiles.data(), tiles.size(), 0));
+}
+
+LC_TEST(TileChunksToTilesRect)
+{
+	auto rect = LcTileChunks::ToTilesRect(LcRectf{ 100.0f, 100.0f, 200.0f, 200.0f }, LcVector3{ 50.0f, 50.0f, 0.0f }, LcVector2{ 2.0f, -2.0f });
+	LC_CHECK(rect.left == 25.0f && rect.right == 75.0f);
+	LC_CHECK(rect.top == -75.0f && rect.bottom == -25.0f);
+}
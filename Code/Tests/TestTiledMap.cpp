@@ -0,0 +1,92 @@
+/**
+* TestTiledMap.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "World/TiledMap.h"
+#include "Core/LCUtils.h"
+#include "Core/LCCompression.h"
+
+#include <filesystem>
+
+
+LC_TEST(TiledMapCookedUpToDate)
+{
+	namespace fs = std::filesystem;
+
+	auto folder = fs::temp_directory_path() / "LcTiledMapTest";
+	fs::remove_all(folder);
+	fs::create_directories(folder);
+	fs::copy_file(fs::path(LC_TESTS_ASSETS_DIR) / "Map1.tmj", folder / "Map1.tmj");
+	fs::copy_file(fs::path(LC_TESTS_ASSETS_DIR) / "Layer1.tsj", folder / "Layer1.tsj");
+
+	auto mapPath = (folder / "Map1.tmj").u8string();
+	auto tilesetPath = (folder / "Layer1.tsj").u8string();
+
+	// cooked file is written next to the map
+	LcCookedTiledMap map;
+	LoadCookedTiledMap(mapPath, map);
+	LC_CHECK(fs::exists(GetCookedMapPath(mapPath)));
+	LC_CHECK(map.GetHeader().mapSize == fs::file_size(mapPath));
+	map.Close();
+
+	LcCookedTiledMap cooked;
+	cooked.Open(GetCookedMapPath(mapPath));
+	LC_CHECK(cooked.IsUpToDate(mapPath));
+
+	// touched file with the same content is up to date
+	fs::last_write_time(mapPath, fs::last_write_time(mapPath) + std::chrono::seconds(10));
+	LC_CHECK(cooked.IsUpToDate(mapPath));
+
+	// changed tileset
+	auto tilesetText = ReadTextFile(tilesetPath.c_str());
+	WriteTextFile(tilesetPath.c_str(), tilesetText + " ");
+	LC_CHECK(!cooked.IsUpToDate(mapPath));
+
+	// missing sources are not checked
+	fs::remove(mapPath);
+	fs::remove(tilesetPath);
+	LC_CHECK(cooked.IsUpToDate(mapPath));
+
+	cooked.Close();
+	fs::remove_all(folder);
+}
+
+LC_TEST(TiledMapBase64Layer)
+{
+	// Tiled wraps long base64 lines
+	std::string mapText = R"({ "layers": [ { "name": "Tiles", "type": "tilelayer", "width": 2, "height": 1,
+		"encoding": "base64", "data": "AQAA\nAAIAAAA=\n" } ] })";
+
+	LcTiledMapData map;
+	ParseTiledMap(mapText, false, map);
+	LC_CHECK(map.layers.size() == 1);
+	LC_CHECK(map.layers[0].tiles.size() == 2);
+	LC_CHECK(map.layers[0].tiles[0] == 1 && map.layers[0].tiles[1] == 2);
+
+	// compressed layers are inflated straight to tiles
+	for (auto layer : { R"("compression": "zlib", "data": "eJxjZGBgYAJiAAAYAAQ=")",
+		R"("compression": "gzip", "data": "H4sIAAAAAAACA2NkYGBgAmIAfBeBAwgAAAA=")" })
+	{
+		std::string compressedText = std::string(R"({ "layers": [ { "name": "Tiles", "type": "tilelayer", "width": 2, "height": 1,
+			"encoding": "base64", )") + layer + " } ] }";
+
+		LcTiledMapData compressedMap;
+		ParseTiledMap(compressedText, false, compressedMap);
+		LC_CHECK(compressedMap.layers.size() == 1 && compressedMap.layers[0].tiles.size() == 2);
+		LC_CHECK(compressedMap.layers[0].tiles[0] == 1 && compressedMap.layers[0].tiles[1] == 2);
+	}
+
+	// zstd layers are rejected with clear error if built without zstd
+	if (!IsZstdSupported())
+	{
+		std::string zstdText = R"({ "layers": [ { "name": "Tiles", "type": "tilelayer", "width": 2, "height": 1,
+			"encoding": "base64", "compression": "zstd", "data": "AQAAAAIAAAA=" } ] })";
+
+		LcTiledMapData zstdMap;
+		LC_CHECK_THROWS(ParseTiledMap(zstdText, false, zstdMap));
+	}
+}
@@ -0,0 +1,39 @@
+/**
+* TestTime.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "Core/LCTime.h"
+
+#include <thread>
+
+
+LC_TEST(TimeMaxTicksPerFrame)
+{
+	LcTimeSystem time(100, 1.0f);
+	LC_CHECK(time.GetMaxTicksPerFrame() == LcDefaultMaxTicksPerFrame);
+
+	// slow frame has more ticks than the limit
+	std::this_thread::sleep_for(std::chrono::milliseconds(150));
+	time.BeginFrame();
+
+	unsigned int numTicks = 0;
+	while (time.StepFixed()) numTicks++;
+
+	LC_CHECK(numTicks == LcDefaultMaxTicksPerFrame);
+	LC_CHECK(time.GetFrameTicks() == LcDefaultMaxTicksPerFrame);
+
+	// dropped time is not carried to the next frame
+	LC_CHECK(time.GetAlpha() < 1.0f);
+
+	time.SetMaxTicksPerFrame(0);
+	std::this_thread::sleep_for(std::chrono::milliseconds(150));
+	time.BeginFrame();
+
+	numTicks = 0;
+	while (time.StepFixed()) numTicks++;
+	LC_CHECK(numTicks >= 14);
+}
@@ -0,0 +1,264 @@
+/**
+* TestWorld.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+#include "LcTestWorld.h"
+#include "World/SpriteInterface.h"
+#include "GUI/WidgetInterface.h"
+#include "GUI/GUIManager.h"
+#include "Core/LCSerializer.h"
+
+#include <vector>
+#include <filesystem>
+
+
+LC_TEST(WorldRemoveKeepsLayerOrder)
+{
+	LcTestWorld test;
+	std::vector<ISprite*> sprites;
+	for (int i = 0; i < 100; i++)
+	{
+		sprites.push_back(test.world->AddSprite((float)i, 0.0f, 10.0f, 10.0f));
+	}
+
+	// remove every second sprite and the first one, enough to compact the bucket
+	for (size_t i = 0; i < sprites.size(); i += 2)
+	{
+		test.world->RemoveSprite(sprites[i]);
+	}
+
+	auto visuals = test.GetVisuals();
+	LC_CHECK(visuals.size() == 50);
+	for (size_t i = 0; i < visuals.size(); i++)
+	{
+		LC_CHECK(visuals[i] == sprites[i * 2 + 1]);
+	}
+
+	// removal from the middle keeps order without compaction
+	test.world->RemoveSprite(sprites[51]);
+	visuals = test.GetVisuals();
+	LC_CHECK(visuals.size() == 49);
+	LC_CHECK(visuals[24] == sprites[49] && visuals[25] == sprites[53]);
+
+	// new sprite goes to the end of the layer
+	auto last = test.world->AddSprite(0.0f, 0.0f, 10.0f, 10.0f);
+	visuals = test.GetVisuals();
+	LC_CHECK(visuals.size() == 50 && visuals.back() == last);
+}
+
+LC_TEST(WorldRecycledVisualHandles)
+{
+	LcTestWorld test;
+	auto sprite = test.world->AddSprite(0.0f, 0.0f, 10.0f, 10.0f);
+	auto handle = sprite->GetHandle();
+	LC_CHECK(test.world->GetLastAddedVisual() == sprite);
+
+	test.world->RemoveSprite(sprite);
+	LC_CHECK(test.world->GetLastAddedVisual() == nullptr);
+
+	// pooled sprite reuses address, old handle stays stale
+	auto other = test.world->AddSprite(1.0f, 1.0f, 10.0f, 10.0f);
+	LC_CHECK(other == sprite);
+	LC_CHECK(test.world->GetVisualByHandle(handle) == nullptr);
+	LC_CHECK(test.world->GetVisualByHandle(other->GetHandle()) == other);
+}
+
+LC_TEST(WorldDeferredVisualHandles)
+{
+	LcTestWorld test;
+	test.world->BeginDeferred();
+
+	// spawned visual has handle before it is inserted
+	auto sprite = test.world->AddSprite(0.0f, 0.0f, 10.0f, 10.0f);
+	auto handle = sprite->GetHandle();
+	LC_CHECK(handle != LcInvalidHandle);
+	LC_CHECK(test.world->GetVisualByHandle(handle) == sprite);
+	LC_CHECK(test.world->GetLastAddedVisual() == sprite);
+
+	test.world->ApplyDeferred();
+	LC_CHECK(sprite->GetHandle() == handle);
+	LC_CHECK(test.world->GetVisuals().size() == 1);
+
+	// spawned and removed in one frame
+	test.world->BeginDeferred();
+	auto removed = test.world->AddSprite(0.0f, 0.0f, 10.0f, 10.0f);
+	auto removedHandle = removed->GetHandle();
+	test.world->RemoveSprite(removed);
+	LC_CHECK(test.world->GetLastAddedVisual() == nullptr);
+	test.world->ApplyDeferred();
+	LC_CHECK(test.world->GetVisualByHandle(removedHandle) == nullptr);
+	LC_CHECK(test.world->GetVisuals().size() == 1);
+}
+
+LC_TEST(WorldDeferredScopeOnException)
+{
+	LcTestWorld test;
+	ISprite* sprite = nullptr;
+
+	try
+	{
+		LcWorldDeferredScope deferredScope(*test.world);
+		sprite = test.world->AddSprite(0.0f, 0.0f, 10.0f, 10.0f);
+		LC_CHECK(test.world->IsDeferred() && test.world->GetVisuals().empty());
+
+		throw std::exception("update failed");
+	}
+	catch (const std::exception&) {}
+
+	// world is not stuck in deferred mode, spawned sprite is stored
+	LC_CHECK(!test.world->IsDeferred());
+	LC_CHECK(test.world->GetVisuals().size() == 1 && test.world->GetVisuals().begin()->get() == sprite);
+}
+
+LC_TEST(WorldSaveLoadRoundTrip)
+{
+	LcBytes data;
+	{
+		LcTestWorld test;
+		auto sprite = test.world->AddSprite(10.0f, 20.0f, LcLayers::Z2, 30.0f, 40.0f, 0.5f);
+		sprite->SetTag(7);
+		sprite->AddTintComponent(test.context, LcColor4{ 1.0f, 0.0f, 0.0f, 1.0f });
+		sprite->AddAnimationComponent(test.context, LcVector2{ 16.0f, 16.0f }, 4, 10.0f);
+
+		LcTextBlockSettings settings;
+		settings.fontSize = 20;
+
+		auto parent = test.world->AddWidget(0.0f, 0.0f, 200.0f, 100.0f);
+		auto button = test.world->AddWidget(5.0f, 5.0f, 50.0f, 20.0f);
+		button->AddTextComponent(test.context, "button_text", settings);
+		button->AddButtonComponent(test.context, "button.png", LcVector2{ 0.0f, 0.0f }, LcVector2{ 0.0f, 20.0f }, LcVector2{ 0.0f, 40.0f });
+		parent->AddChild(button);
+
+		auto checkbox = test.world->AddWidget(5.0f, 30.0f, 20.0f, 20.0f);
+		checkbox->AddCheckboxComponent(test.context, "checkbox.png", LcVector2{ 0.0f, 0.0f }, LcVector2{ 20.0f, 0.0f },
+			LcVector2{ 40.0f, 0.0f }, LcVector2{ 60.0f, 0.0f });
+
+		LcArchiveWriter writer;
+		test.world->Save(writer);
+		writer.Finish(data);
+	}
+
+	LcTestWorld test;
+	LcArchiveReader reader(data.data(), data.size());
+	test.world->Load(reader);
+	LC_CHECK(test.world->GetVisuals().size() == 4);
+
+	auto sprite = static_cast<ISprite*>(test.world->GetVisualByTag(7));
+	LC_CHECK(sprite && sprite->GetTypeId() == LcCreatables::Sprite);
+	LC_CHECK(sprite->GetPos().x == 10.0f && sprite->GetPos().y == 20.0f && sprite->GetSize().y == 40.0f && sprite->GetRotZ() == 0.5f);
+	LC_CHECK(sprite->HasComponent(LcComponents::Tint));
+	LC_CHECK(sprite->HasComponent(LcComponents::FrameAnimation));
+
+	// widget components are saved too, not only features of the visual
+	IWidget* button = nullptr;
+	IWidget* checkbox = nullptr;
+	for (auto& visual : test.world->GetVisuals())
+	{
+		if (visual->HasComponent(LcComponents::Button)) button = static_cast<IWidget*>(visual.get());
+		if (visual->HasComponent(LcComponents::Checkbox)) checkbox = static_cast<IWidget*>(visual.get());
+	}
+
+	LC_CHECK(button && checkbox);
+	LC_CHECK(button->GetTextComponent() && button->GetTextComponent()->GetTextKey() == "button_text");
+	LC_CHECK(button->GetTextComponent()->GetSettings().fontSize == 20);
+	LC_CHECK(button->GetParent() && button->GetParent()->GetChilds().size() == 1);
+	LC_CHECK(checkbox->GetPos().y == 30.0f);
+}
+
+LC_TEST(WorldSaveReleasedTiles)
+{
+	namespace fs = std::filesystem;
+
+	auto folder = fs::temp_directory_path() / "LcWorldTilesTest";
+	fs::remove_all(folder);
+	fs::create_directories(folder);
+	fs::copy_file(fs::path(LC_TESTS_ASSETS_DIR) / "Map1.tmj", folder / "Map1.tmj");
+	fs::copy_file(fs::path(LC_TESTS_ASSETS_DIR) / "Layer1.tsj", folder / "Layer1.tsj");
+
+	LcBytes data;
+	unsigned int numTiles = 0;
+	{
+		LcTestWorld test;
+		auto sprite = test.world->AddSprite(0.0f, 0.0f, 320.0f, 320.0f);
+		sprite->SetTag(1);
+		sprite->AddTiledComponent(test.context, (folder / "Map1.tmj").u8string());
+
+		// render uploaded tiles and released them
+		auto tiled = sprite->GetTiledComponent();
+		numTiles = tiled->GetNumTiles();
+		tiled->SetKeepTilesData(false);
+		tiled->OnTilesUploaded();
+		LC_CHECK(numTiles > 0 && tiled->GetTilesData().empty());
+
+		LcArchiveWriter writer;
+		test.world->Save(writer);
+		writer.Finish(data);
+	}
+
+	LcTestWorld test;
+	LcArchiveReader reader(data.data(), data.size());
+	test.world->Load(reader);
+
+	// loaded component restores tiles when render sets it up
+	auto sprite = static_cast<ISprite*>(test.world->GetVisualByTag(1));
+	auto tiled = sprite ? sprite->GetTiledComponent() : nullptr;
+	LC_CHECK(tiled && tiled->GetNumTiles() == numTiles && tiled->GetTilesData().empty());
+
+	tiled->RestoreTilesData();
+	LC_CHECK(tiled->GetTilesData().size() == numTiles);
+
+	// released again after upload, as keep flag is loaded
+	tiled->OnTilesUploaded();
+	LC_CHECK(tiled->GetTilesData().empty());
+
+	test.world->Clear(true);
+	fs::remove_all(folder);
+}
+
+LC_TEST(WorldWidgetParentVisibility)
+{
+	LcTestWorld test;
+	auto parent = test.world->AddWidget(0.0f, 0.0f, 200.0f, 100.0f);
+	auto other = test.world->AddWidget(0.0f, 0.0f, 200.0f, 100.0f);
+	auto child = test.world->AddWidget(5.0f, 5.0f, 50.0f, 20.0f);
+	auto grandchild = test.world->AddWidget(5.0f, 5.0f, 10.0f, 10.0f);
+	child->AddChild(grandchild);
+
+	// child added to hidden parent is hidden with its subtree, but keeps own flag
+	parent->SetVisible(false);
+	parent->AddChild(child);
+	LC_CHECK(child->IsVisible() && !child->IsVisibleInHierarchy());
+	LC_CHECK(!grandchild->IsParentVisible() && HasInvisibleParent(grandchild));
+
+	// removed child is visible again
+	parent->RemoveChild(child);
+	LC_CHECK(child->GetParent() == nullptr && child->IsVisibleInHierarchy());
+	LC_CHECK(grandchild->IsVisibleInHierarchy() && !HasInvisibleParent(grandchild));
+
+	// reparent to visible parent, then back to hidden one
+	other->AddChild(child);
+	LC_CHECK(child->GetParent() == other && grandchild->IsVisibleInHierarchy());
+	other->RemoveChild(child);
+	parent->AddChild(child);
+	LC_CHECK(!child->IsVisibleInHierarchy() && !grandchild->IsVisibleInHierarchy());
+
+	// hidden child keeps its subtree hidden when parent is shown
+	child->SetVisible(false);
+	parent->SetVisible(true);
+	LC_CHECK(child->IsParentVisible() && !child->IsVisibleInHierarchy());
+	LC_CHECK(!grandchild->IsParentVisible());
+
+	child->SetVisible(true);
+	LC_CHECK(child->IsVisibleInHierarchy() && grandchild->IsVisibleInHierarchy());
+	LC_CHECK(!HasInvisibleParent(grandchild));
+
+	// hiding top parent hides whole subtree
+	parent->SetVisible(false);
+	LC_CHECK(!child->IsParentVisible() && !grandchild->IsParentVisible() && grandchild->IsVisible());
+	parent->SetVisible(true);
+	LC_CHECK(grandchild->IsVisibleInHierarchy());
+}
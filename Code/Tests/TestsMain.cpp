@@ -0,0 +1,59 @@
+/**
+* TestsMain.cpp
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#include "pch.h"
+#include "LcTest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+
+std::vector<LcTestCase>& GetTestCases()
+{
+	static std::vector<LcTestCase> testCases;
+	return testCases;
+}
+
+void FailTest(const char* file, int line, const char* expression)
+{
+	throw LcTestFailure{ std::string(file) + "(" + std::to_string(line) + "): " + expression };
+}
+
+/**
+* Runs all tests, or tests which names contain argument */
+int main(int argc, char** argv)
+{
+	const char* filter = (argc > 1) ? argv[1] : nullptr;
+	int numRun = 0;
+	int numFailed = 0;
+
+	for (const auto& test : GetTestCases())
+	{
+		if (filter && !strstr(test.name, filter)) continue;
+
+		numRun++;
+
+		try
+		{
+			test.func();
+			printf("[ PASS ] %s\n", test.name);
+		}
+		catch (const LcTestFailure& failure)
+		{
+			numFailed++;
+			printf("[ FAIL ] %s\n  %s\n", test.name, failure.message.c_str());
+		}
+		catch (const std::exception& ex)
+		{
+			numFailed++;
+			printf("[ FAIL ] %s\n  exception: %s\n", test.name, ex.what());
+		}
+	}
+
+	printf("%d tests, %d failed\n", numRun, numFailed);
+	return (numFailed == 0 && numRun > 0) ? 0 : 1;
+}
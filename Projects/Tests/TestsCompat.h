@@ -0,0 +1,33 @@
+/**
+* TestsCompat.h
+* 17.10.2026
+* (c) Denis Romakhov
+*
+* Forced include for non-MSVC compilers. Engine throws std::exception with a message,
+* which is MSVC extension, so std::exception is replaced with a class that keeps the message.
+* All standard headers are included first, so the replacement does not affect them.
+*/
+
+#pragma once
+
+#include <bits/stdc++.h>
+
+namespace std
+{
+	class msvc_exception : public std::exception
+	{
+	public:
+		msvc_exception() = default;
+		//
+		msvc_exception(const char* inMessage) : message(inMessage ? inMessage : "") {}
+		//
+		virtual const char* what() const noexcept override { return message.c_str(); }
+
+
+	protected:
+		std::string message;
+
+	};
+}
+
+#define exception msvc_exception
@@ -0,0 +1,18 @@
+/**
+* pch.h
+* 17.10.2026
+* (c) Denis Romakhov
+*/
+
+#ifndef PCH_H
+#define PCH_H
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include <filesystem>
+#include <fstream>
+
+#endif //PCH_H